@@ -25,6 +25,8 @@ CommandManager* CommandManager::s_cmdManager = 0;
 CommandManager::CommandManager() 
   : QObject()
   , m_canMergeIDCounter(0)
+  , m_interactionCanMergeID(NoCanMergeID)
+  , m_interactionCommandDone(false)
   , m_debugMode( NoDebug )
 {
 }
@@ -163,7 +165,12 @@ void CommandManager::doCommand(
     m_undoStack[m_undoStack.size()-1].topLevelCmd = prt;
   }
 
-  if(!subCmd)
+  // The steps of an interaction are reported by endInteraction.
+  if(!subCmd && cmd->canUndo() && 
+    canMergeID != NoCanMergeID && canMergeID == m_interactionCanMergeID)
+    m_interactionCommandDone = true;
+
+  else if(!subCmd)
     emit commandDone(
       cmd, 
       cmd->canUndo()
@@ -345,6 +352,7 @@ void CommandManager::redoCommand()
 
 void CommandManager::clear() 
 {
+  m_interactionCommandDone = false;
   clearRedoStack();
   clearCommandStack(m_undoStack);
   emit cleared();
@@ -377,6 +385,31 @@ int CommandManager::getNewCanMergeID()
   return m_canMergeIDCounter;
 }
 
+void CommandManager::beginInteraction(
+  int canMergeID)
+{
+  m_interactionCanMergeID = canMergeID;
+  m_interactionCommandDone = false;
+}
+
+void CommandManager::endInteraction(
+  int canMergeID)
+{
+  if(canMergeID != m_interactionCanMergeID)
+    return;
+
+  bool interactionCommandDone = m_interactionCommandDone;
+  m_interactionCanMergeID = NoCanMergeID;
+  m_interactionCommandDone = false;
+
+  if(interactionCommandDone && m_undoStack.size() > 0)
+  {
+    BaseCommand *top = m_undoStack[m_undoStack.size()-1].topLevelCmd.data();
+    if(top->getCanMergeID() == canMergeID)
+      emit commandDone(top, true);
+  }
+}
+
 void CommandManager::setDebugMode(
   int debugMode)
 {
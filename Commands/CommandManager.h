@@ -108,6 +108,19 @@ class CommandManager : public QObject
     /// Gets a new interaction ID.
     virtual int getNewCanMergeID();
 
+    /// Opens an interaction (a drag...): until endInteraction, the
+    /// undoable commands done with this canMergeID don't emit
+    /// `commandDone`, so the intermediate steps are not logged.
+    void beginInteraction(
+      int canMergeID
+      );
+
+    /// Closes the interaction and emits `commandDone` once
+    /// for the resulting (merged) command, if any was done.
+    void endInteraction(
+      int canMergeID
+      );
+
     /// Sets the debug mode (NoDebug, Debug or VerboseDebug)
     void setDebugMode(
       int debugMode
@@ -177,6 +190,9 @@ class CommandManager : public QObject
     QList<StackedCommand> m_undoStack, m_redoStack;
     /// Command merging counter.
     int m_canMergeIDCounter;
+    /// Opened interaction, see beginInteraction.
+    int m_interactionCanMergeID;
+    bool m_interactionCommandDone;
 
   private:
     /// Clears a specific stack.
@@ -3,7 +3,9 @@
 //
 
 #include "PathValueResolverRegistry.h"
+#include <FabricUI/Util/RTValUtil.h>
 #include <vector>
+#include <string.h>
 
 using namespace FabricUI;
 using namespace Util;
@@ -28,6 +30,7 @@ void PathValueResolverRegistry::clear() {
 
   // clearing first, else the resolvers will delete themselve twice
   m_registeredResolvers.clear();
+  m_resolversByPath.clear();
 
   foreach( BasePathValueResolver* resolver, resolvers )
     delete resolver;
@@ -77,11 +80,28 @@ BasePathValueResolver* PathValueResolverRegistry::getResolver(
 BasePathValueResolver* PathValueResolverRegistry::getResolver(
   RTVal pathValue)
 {
-  foreach(BasePathValueResolver* resolver, m_registeredResolvers)
+  // Keep the string alive while we use its data
+  RTVal pathVal = RTValUtil::toRTVal(pathValue).maybeGetMember("path");
+  char const *pathCStr = pathVal.getStringCString();
+  int pathSize = int(strlen(pathCStr));
+
+  // Doesn't copy the path
+  QByteArray path = QByteArray::fromRawData(pathCStr, pathSize);
+
+  BasePathValueResolver* resolver = m_resolversByPath.value(path, 0);
+  if(resolver != 0 && resolver->knownPath(pathValue))
+    return resolver;
+
+  foreach(resolver, m_registeredResolvers)
   {
     if(resolver->knownPath(pathValue))
+    {
+      m_resolversByPath.insert(QByteArray(pathCStr, pathSize), resolver);
       return resolver;
+    }
   }
+
+  m_resolversByPath.remove(path);
   return 0;
 }
  
@@ -94,32 +114,24 @@ bool PathValueResolverRegistry::knownPath(
 QString PathValueResolverRegistry::getType(
   RTVal pathValue)
 {
-  foreach(BasePathValueResolver* resolver, m_registeredResolvers)
-  {
-    if(resolver->knownPath(pathValue))
-      return resolver->getType(pathValue);
-  }
-  return "";
+  BasePathValueResolver* resolver = getResolver(pathValue);
+  return resolver != 0 ? resolver->getType(pathValue) : "";
 }
 
 void PathValueResolverRegistry::getValue(
   RTVal pathValue)
 {
-  foreach(BasePathValueResolver* resolver, m_registeredResolvers)
-  {
-    if(resolver->knownPath(pathValue))
-      resolver->getValue(pathValue);
-  }
+  BasePathValueResolver* resolver = getResolver(pathValue);
+  if(resolver != 0)
+    resolver->getValue(pathValue);
 }
 
 void PathValueResolverRegistry::setValue(
   RTVal pathValue)
 {
-  foreach(BasePathValueResolver* resolver, m_registeredResolvers)
-  {
-    if(resolver->knownPath(pathValue))
-      resolver->setValue(pathValue);
-  }
+  BasePathValueResolver* resolver = getResolver(pathValue);
+  if(resolver != 0)
+    resolver->setValue(pathValue);
 }
 
 void PathValueResolverRegistry::unregisterFactory(
@@ -131,6 +143,8 @@ void PathValueResolverRegistry::unregisterFactory(
   // unregister the resolver
   if(hasResolver(name))
   {
+    m_resolversByPath.clear();
+
     BasePathValueResolver* resolver = m_registeredResolvers[name];
     // Remove first, else it will unregister again in its destructor
     m_registeredResolvers.remove( name );
@@ -147,4 +161,5 @@ void PathValueResolverRegistry::registerResolver(
   QString const&name)
 {
   m_registeredResolvers[name] = resolver;
+  m_resolversByPath.clear();
 }
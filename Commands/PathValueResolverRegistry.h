@@ -6,6 +6,8 @@
 #define __UI_PATH_RESOLVER_REGISTRY__
 
 #include <QMap>
+#include <QHash>
+#include <QByteArray>
 #include "BasePathValueResolver.h"
 #include <FabricUI/Util/Factory.h>
 
@@ -51,8 +53,9 @@ class PathValueResolverRegistry : public Util::BaseFactoryRegistry
       QString const&name
       );
 
-    /// Gets the resolver that can 
-    /// resolves `pathValue`.  
+    /// Gets the resolver that can resolves `pathValue`.
+    /// The resolver found for a path is remembered, so
+    /// next time only this one is asked if it knows it.
     virtual BasePathValueResolver* getResolver(
       FabricCore::RTVal pathValue
       );
@@ -104,6 +107,8 @@ class PathValueResolverRegistry : public Util::BaseFactoryRegistry
     static PathValueResolverRegistry *s_registry;
     /// PathResolver singleton.
     QMap<QString, BasePathValueResolver*> m_registeredResolvers;
+    /// Resolver of the paths already resolved.
+    QHash<QByteArray, BasePathValueResolver*> m_resolversByPath;
 };
 
 template<typename T> 
@@ -74,7 +74,7 @@ void RTValCommandManager::checkRTValCommandArgs(
       "but is not implementing the BaseRTValScriptableCommand interface"
       );
 
-  // Sets the rtval args
+  // Sets the rtval args, they're never cast to JSON.
   QMapIterator<QString, RTVal> ite(args);
   while(ite.hasNext()) 
   {
@@ -83,8 +83,18 @@ void RTValCommandManager::checkRTValCommandArgs(
 
     if(RTValUtil::getType(arg) == "PathValue")
       scriptCmd->setRTValArg(ite.key(), arg);
+
     else
+    {
+      // If the arg type is known, the value can be given in any type  
+      // KL converts to it (e.g. a Float64 for a Float32 arg), which  
+      // is lossless compared to formatting it in a string.
+      QString type = scriptCmd->getRTValArgType(ite.key());
+      if(!type.isEmpty() && type != "RTVal" && type != "None")
+        arg = RTValUtil::convert(arg, type);
+
       scriptCmd->setRTValArgValue(ite.key(), RTValUtil::toKLRTVal(arg));
+    }
   }
 
   scriptCmd->validateSetArgs();
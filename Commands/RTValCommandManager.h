@@ -34,6 +34,10 @@ class RTValCommandManager : public CommandManager
 
     /// Creates and executes a command (if doCmd == true).
     /// If executed, the command is added to the manager stack.
+    /// The args are set as RTVals, converted to the declared 
+    /// arg types if needed: JSON is only generated if the 
+    /// command is logged. Prefer it to the QString version 
+    /// for commands created at interactive rates.
     /// Throws an exception if an error occurs.
     virtual BaseCommand* createCommand(
       QString const&cmdName, 
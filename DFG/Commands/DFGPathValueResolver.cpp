@@ -5,10 +5,13 @@
 #include "DFGPathValueResolver.h"
 #include <FabricUI/Util/RTValUtil.h>
 #include <FabricUI/DFG/DFGController.h>
+#include <FabricUI/DFG/DFGExecNotifier.h>
+#include <FabricUI/DFG/DFGBindingNotifier.h>
 #include <FabricUI/Application/FabricException.h>
 #include <FabricUI/Application/FabricApplicationStates.h>
 #include <FabricServices/Persistence/RTValToJSONEncoder.hpp>
 #include <iostream>
+#include <string.h>
 
 using namespace FabricUI;
 using namespace DFG;
@@ -25,6 +28,7 @@ DFGPathValueResolver::DFGPathValueResolver()
  
 DFGPathValueResolver::~DFGPathValueResolver()
 {
+  // The exec proxies are children of the resolver
 }
  
 void DFGPathValueResolver::registrationCallback(
@@ -50,13 +54,181 @@ void DFGPathValueResolver::onBindingChanged(
 {
   m_binding = binding;
   m_id = binding.getMetadata("resolver_id");
+
+  clearResolvedPaths();
+
+  m_bindingNotifier.clear();
+  if(!m_binding.isValid())
+    return;
+
+  m_bindingNotifier = DFGBindingNotifier::Create( m_binding );
+
+  QObject::connect(
+    m_bindingNotifier.data(),
+    SIGNAL( argRenamed( unsigned, FTL::CStrRef, FTL::CStrRef ) ),
+    this,
+    SLOT( onBindingArgRenamed( unsigned, FTL::CStrRef, FTL::CStrRef ) )
+    );
+
+  QObject::connect(
+    m_bindingNotifier.data(),
+    SIGNAL( argRemoved( unsigned, FTL::CStrRef ) ),
+    this,
+    SLOT( onBindingArgRemoved( unsigned, FTL::CStrRef ) )
+    );
+
+  // A variable can shadow or unshadow any path
+  QObject::connect(
+    m_bindingNotifier.data(),
+    SIGNAL( varInserted( FTL::CStrRef, FTL::CStrRef, FTL::CStrRef, FTL::CStrRef ) ),
+    this,
+    SLOT( onBindingVarInsertedOrRemoved() )
+    );
+
+  QObject::connect(
+    m_bindingNotifier.data(),
+    SIGNAL( varRemoved( FTL::CStrRef, FTL::CStrRef ) ),
+    this,
+    SLOT( onBindingVarInsertedOrRemoved() )
+    );
 }
 
-bool DFGPathValueResolver::knownPath(
-  RTVal pathValue)
+void DFGPathValueResolver::onBindingArgRenamed(
+  unsigned index,
+  FTL::CStrRef oldName,
+  FTL::CStrRef newName)
 {
-  QString path = RTValUtil::toRTVal(pathValue).maybeGetMember(
-    "path").getStringCString();
+  invalidateResolvedPaths(
+    QString(),
+    QString(),
+    QString(),
+    QString::fromUtf8(oldName.data(), int(oldName.size()))
+    );
+}
+
+void DFGPathValueResolver::onBindingArgRemoved(
+  unsigned index,
+  FTL::CStrRef name)
+{
+  invalidateResolvedPaths(
+    QString(),
+    QString(),
+    QString(),
+    QString::fromUtf8(name.data(), int(name.size()))
+    );
+}
+
+void DFGPathValueResolver::onBindingVarInsertedOrRemoved()
+{
+  clearResolvedPaths();
+}
+
+void DFGPathValueResolver::clearResolvedPaths()
+{
+  m_resolvedPaths.clear();
+
+  // Might be called from one of their notifications
+  QMapIterator<QString, DFGPathValueResolver_ExecNotifProxy *> it(m_execNotifProxies);
+  while(it.hasNext())
+    it.next().value()->deleteLater();
+  m_execNotifProxies.clear();
+}
+
+void DFGPathValueResolver::invalidateResolvedPaths(
+  QString const&execPath,
+  QString const&nodeName,
+  QString const&blockName,
+  QString const&portName)
+{
+  // When a node or a block goes, so do the executables inside it
+  QString itemPath;
+  if(portName.isEmpty() && !nodeName.isEmpty())
+  {
+    itemPath = execPath.isEmpty() ? nodeName : execPath + "." + nodeName;
+    if(!blockName.isEmpty())
+      itemPath += "." + blockName;
+  }
+  QString itemPathPrefix = itemPath + ".";
+
+  QMutableHashIterator<QByteArray, ResolvedPath> it(m_resolvedPaths);
+  while(it.hasNext())
+  {
+    DFGPortPaths const &paths = it.next().value().dfgPortPaths;
+
+    bool matches = 
+      paths.execPath == execPath &&
+      paths.nodeName == nodeName &&
+      ( blockName.isEmpty()
+        ? ( portName.isEmpty() || paths.blockName.isEmpty() )
+        : paths.blockName == blockName ) &&
+      ( portName.isEmpty() || paths.portName == portName );
+
+    if(!matches && !itemPath.isEmpty())
+      matches = 
+        paths.execPath == itemPath ||
+        paths.execPath.startsWith(itemPathPrefix);
+
+    if(matches)
+      it.remove();
+  }
+
+  if(!itemPath.isEmpty())
+  {
+    QMutableMapIterator<QString, DFGPathValueResolver_ExecNotifProxy *> proxyIt(m_execNotifProxies);
+    while(proxyIt.hasNext())
+    {
+      proxyIt.next();
+      if(proxyIt.key() == itemPath || proxyIt.key().startsWith(itemPathPrefix))
+      {
+        proxyIt.value()->deleteLater();
+        proxyIt.remove();
+      }
+    }
+  }
+}
+
+void DFGPathValueResolver::onExecRemovedFromOwner(
+  QString const&execPath)
+{
+  QMutableHashIterator<QByteArray, ResolvedPath> it(m_resolvedPaths);
+  while(it.hasNext())
+  {
+    if(it.next().value().dfgPortPaths.execPath == execPath)
+      it.remove();
+  }
+
+  QMap<QString, DFGPathValueResolver_ExecNotifProxy *>::iterator proxyIt = 
+    m_execNotifProxies.find(execPath);
+  if(proxyIt != m_execNotifProxies.end())
+  {
+    proxyIt.value()->deleteLater();
+    m_execNotifProxies.erase(proxyIt);
+  }
+}
+
+bool DFGPathValueResolver::resolvePath(
+  RTVal pathValue,
+  ResolvedPath &resolvedPath)
+{
+  // Keep the string alive while we use its data
+  RTVal pathVal = RTValUtil::toRTVal(pathValue).maybeGetMember("path");
+  char const *pathCStr = pathVal.getStringCString();
+  int pathSize = int(strlen(pathCStr));
+
+  // Doesn't copy the path
+  QHash<QByteArray, ResolvedPath>::const_iterator it = m_resolvedPaths.find(
+    QByteArray::fromRawData(pathCStr, pathSize)
+    );
+
+  if(it != m_resolvedPaths.end())
+  {
+    // Copied : the Core calls made with it
+    // can invalidate the cache.
+    resolvedPath = it.value();
+    return true;
+  }
+
+  QString path = QString::fromUtf8(pathCStr, pathSize);
   
   bool knownBinding = false;
 
@@ -69,21 +241,58 @@ bool DFGPathValueResolver::knownPath(
   }
   knownBinding = !knownBinding ? m_id.isEmpty() : true;
 
-  if(knownBinding)
-  {
-    DFGPortPaths dfgPortPaths;
-    DFGType dfgType = DFGUnknow;
+  if(!knownBinding)
+    return false;
 
-    getDFGPortPathsAndType(
-      pathValue,
-      dfgPortPaths,
-      dfgType
+  resolvedPath.exec = resolveDFGPortPathsAndType(
+    pathValue,
+    resolvedPath.dfgPortPaths,
+    resolvedPath.dfgType
+    );
+
+  resolvedPath.relativePortPath = 
+    resolvedPath.dfgPortPaths.getRelativePortPath().toUtf8();
+  resolvedPath.absolutePortPath = 
+    resolvedPath.dfgPortPaths.getAbsolutePortPath(false).toUtf8();
+
+  int arrayIndex;
+  QString hrPath = getPathWithoutBindingOrSolverID(
+    pathValue, 
+    arrayIndex,
+    false
+    );
+  resolvedPath.hrPath = ( !m_id.isEmpty() ? m_id + "." + hrPath : hrPath ).toUtf8();
+
+  if(resolvedPath.dfgType == DFGUnknow)
+    return false;
+
+  // Only the positive results are kept : unknown paths 
+  // can become valid at any time, and the registry
+  // already remembers which resolver knows which path.
+  m_resolvedPaths.insert(
+    QByteArray(pathCStr, pathSize), 
+    resolvedPath
+    );
+
+  QString const &execPath = resolvedPath.dfgPortPaths.execPath;
+  if(!m_execNotifProxies.contains(execPath))
+    m_execNotifProxies.insert(
+      execPath,
+      new DFGPathValueResolver_ExecNotifProxy(
+        this,
+        resolvedPath.exec,
+        execPath
+        )
       );
 
-    return dfgType != DFGUnknow;
-  }
+  return true;
+}
 
-  return false;
+bool DFGPathValueResolver::knownPath(
+  RTVal pathValue)
+{
+  ResolvedPath resolvedPath;
+  return resolvePath(pathValue, resolvedPath);
 }
 
 QString DFGPathValueResolver::getType(
@@ -93,23 +302,17 @@ QString DFGPathValueResolver::getType(
 
   FABRIC_CATCH_BEGIN();
 
-  DFGPortPaths dfgPortPaths;
-  DFGType dfgType = DFGUnknow;
+  ResolvedPath resolvedPath;
+  resolvePath(pathValue, resolvedPath);
 
-  FabricCore::DFGExec subExec = getDFGPortPathsAndType(
-    pathValue,
-    dfgPortPaths,
-    dfgType
-    );
-
-  if(dfgType == DFGVar)
+  if(resolvedPath.dfgType == DFGVar)
     type = m_binding.getExec().getVarType(
-      dfgPortPaths.getAbsolutePortPath(false).toUtf8().constData()
+      resolvedPath.absolutePortPath.constData()
       );
   
   else
-    type = subExec.getPortResolvedType(
-      dfgPortPaths.getRelativePortPath().toUtf8().constData()
+    type = resolvedPath.exec.getPortResolvedType(
+      resolvedPath.relativePortPath.constData()
       );
 
   FABRIC_CATCH_END("DFGPathValueResolver::getType");
@@ -124,18 +327,18 @@ void DFGPathValueResolver::getValue(
     
   RTVal value;
 
-  DFGPortPaths dfgPortPaths;
-  DFGType dfgType = DFGUnknow;
+  ResolvedPath resolvedPath;
+  resolvePath(pathValue, resolvedPath);
 
-  FabricCore::DFGExec subExec = getDFGPortPathsAndType(
-    pathValue,
-    dfgPortPaths,
-    dfgType
-    );
+  DFGPortPaths &dfgPortPaths = resolvedPath.dfgPortPaths;
+  DFGType dfgType = resolvedPath.dfgType;
+  FabricCore::DFGExec subExec = resolvedPath.exec;
+  char const *relativePortPath = resolvedPath.relativePortPath.constData();
+  char const *absolutePortPath = resolvedPath.absolutePortPath.constData();
 
   if(dfgType == DFGVar)
     value = m_binding.getExec().getVarValue(
-      dfgPortPaths.getAbsolutePortPath(false).toUtf8().constData()
+      absolutePortPath
       );
 
   else 
@@ -144,13 +347,13 @@ void DFGPathValueResolver::getValue(
     {
       if(dfgType == DFGPort)
         value = subExec.getPortResolvedDefaultValue( 
-          dfgPortPaths.getRelativePortPath().toUtf8().constData(), 
-          subExec.getPortResolvedType(dfgPortPaths.getRelativePortPath().toUtf8().constData())
+          relativePortPath, 
+          subExec.getPortResolvedType(relativePortPath)
           );
 
       else if(dfgType == DFGArg)
         value = m_binding.getArgValue(
-          dfgPortPaths.getRelativePortPath().toUtf8().constData()
+          relativePortPath
           );
     }
 
@@ -187,7 +390,7 @@ void DFGPathValueResolver::getValue(
       );
   }
 
-  castPathToHRFormat( pathValue);
+  castPathToHRFormat(pathValue, resolvedPath.hrPath);
 
   FABRIC_CATCH_END("DFGPathValueResolver::getValue");
 }
@@ -219,14 +422,14 @@ void DFGPathValueResolver::setValue(
   if( !value.isValid() )
     return; // no value specified
 
-  DFGPortPaths dfgPortPaths;
-  DFGType dfgType = DFGUnknow;
+  ResolvedPath resolvedPath;
+  resolvePath(pathValue, resolvedPath);
 
-  FabricCore::DFGExec subExec = getDFGPortPathsAndType(
-    pathValue,
-    dfgPortPaths,
-    dfgType
-    );
+  DFGPortPaths &dfgPortPaths = resolvedPath.dfgPortPaths;
+  DFGType dfgType = resolvedPath.dfgType;
+  FabricCore::DFGExec subExec = resolvedPath.exec;
+  char const *relativePortPath = resolvedPath.relativePortPath.constData();
+  char const *absolutePortPath = resolvedPath.absolutePortPath.constData();
 
   if( ( value.isObject() || value.isInterface() ) && !value.isNullObject() ) {
     // Get the most specialized type.
@@ -249,7 +452,7 @@ void DFGPathValueResolver::setValue(
     if(dfgPortPaths.isArrayElement())
     {
       RTVal arrayVal = m_binding.getExec().getVarValue(
-        dfgPortPaths.getAbsolutePortPath(false).toUtf8().constData()
+        absolutePortPath
         );
 
       arrayVal.setArrayElement(
@@ -258,14 +461,14 @@ void DFGPathValueResolver::setValue(
         );
 
       m_binding.getExec().setVarValue( 
-        dfgPortPaths.getAbsolutePortPath(false).toUtf8().constData(), 
+        absolutePortPath, 
         arrayVal);
     }
 
     else
     {
       QString varValueType = m_binding.getExec().getVarType(
-        dfgPortPaths.getAbsolutePortPath(false).toUtf8().constData()
+        absolutePortPath
         );
 
       arePathValueAndDFGItemTypeEqual(
@@ -276,7 +479,7 @@ void DFGPathValueResolver::setValue(
         );
 
       m_binding.getExec().setVarValue( 
-        dfgPortPaths.getAbsolutePortPath(false).toUtf8().constData(), 
+        absolutePortPath, 
         value);
     }
   }
@@ -286,7 +489,7 @@ void DFGPathValueResolver::setValue(
     if(!dfgPortPaths.isArrayElement())
     {
       QString portValueType = subExec.getPortResolvedType(
-        dfgPortPaths.getRelativePortPath().toUtf8().constData()
+        relativePortPath
         );
 
       arePathValueAndDFGItemTypeEqual(
@@ -302,8 +505,8 @@ void DFGPathValueResolver::setValue(
       if(dfgPortPaths.isArrayElement())
       {
         RTVal arrayVal = subExec.getPortResolvedDefaultValue( 
-          dfgPortPaths.getRelativePortPath().toUtf8().constData(), 
-          subExec.getPortResolvedType(dfgPortPaths.getRelativePortPath().toUtf8().constData())
+          relativePortPath, 
+          subExec.getPortResolvedType(relativePortPath)
           );
 
         arrayVal.setArrayElement(
@@ -311,14 +514,14 @@ void DFGPathValueResolver::setValue(
           value);
 
         subExec.setPortDefaultValue( 
-          dfgPortPaths.getRelativePortPath().toUtf8().constData(), 
+          relativePortPath, 
           arrayVal, 
           false);
       }
 
       else
         subExec.setPortDefaultValue( 
-          dfgPortPaths.getRelativePortPath().toUtf8().constData(), 
+          relativePortPath, 
           value, 
           false);
     }
@@ -333,7 +536,7 @@ void DFGPathValueResolver::setValue(
         //       since we mostly want to avoid "too big values" like meshes to be persisted, which
         //       shouldn't be the case here.
         m_binding.getExec().setExecPortMetadata(
-          dfgPortPaths.getRelativePortPath().toUtf8().constData(),
+          relativePortPath,
           DFG_METADATA_UIPERSISTVALUE,
           "true",
           false
@@ -343,7 +546,7 @@ void DFGPathValueResolver::setValue(
       if(dfgPortPaths.isArrayElement())
       {
         RTVal arrayVal = m_binding.getArgValue(
-          dfgPortPaths.getRelativePortPath().toUtf8().constData()
+          relativePortPath
           );
 
         arrayVal.setArrayElement(
@@ -351,14 +554,14 @@ void DFGPathValueResolver::setValue(
           value);
 
         m_binding.setArgValue(
-          dfgPortPaths.getRelativePortPath().toUtf8().constData(),
+          relativePortPath,
           arrayVal,
           false );
       }
 
       else
         m_binding.setArgValue(
-          dfgPortPaths.getRelativePortPath().toUtf8().constData(),
+          relativePortPath,
           value,
           false );
     }   
@@ -408,6 +611,24 @@ FabricCore::DFGExec DFGPathValueResolver::getDFGPortPathsAndType(
   FabricCore::RTVal pathValue,
   DFGPortPaths &dfgPortPaths,
   DFGPathValueResolver::DFGType &dfgType)
+{
+  ResolvedPath resolvedPath;
+  if(!resolvePath(pathValue, resolvedPath))
+    return resolveDFGPortPathsAndType(
+      pathValue,
+      dfgPortPaths,
+      dfgType
+      );
+
+  dfgPortPaths = resolvedPath.dfgPortPaths;
+  dfgType = resolvedPath.dfgType;
+  return resolvedPath.exec;
+}
+
+FabricCore::DFGExec DFGPathValueResolver::resolveDFGPortPathsAndType(
+  FabricCore::RTVal pathValue,
+  DFGPortPaths &dfgPortPaths,
+  DFGPathValueResolver::DFGType &dfgType)
 {
   DFGExec exec;
   dfgType = DFGUnknow;
@@ -446,7 +667,7 @@ FabricCore::DFGExec DFGPathValueResolver::getDFGPortPathsAndType(
     }
   }
 
-  FABRIC_CATCH_END("DFGPathValueResolver::getDFGPortPathsAndType");
+  FABRIC_CATCH_END("DFGPathValueResolver::resolveDFGPortPathsAndType");
 
   return exec;
 }
@@ -583,25 +804,22 @@ DFGBinding DFGPathValueResolver::getDFGBinding() const
 }
 
 void DFGPathValueResolver::castPathToHRFormat(
-  FabricCore::RTVal pathValue)
+  FabricCore::RTVal pathValue,
+  QByteArray const&hrPath)
 {
   FABRIC_CATCH_BEGIN();
 
-  int arrayIndex;
-  QString path = getPathWithoutBindingOrSolverID(
-    pathValue, 
-    arrayIndex,
-    false
-    );
+  pathValue = RTValUtil::toRTVal(pathValue);
 
-  path = !m_id.isEmpty() ? m_id + "." + path : path;
+  // Most of the paths are already in that format
+  if(hrPath == pathValue.maybeGetMember("path").getStringCString())
+    return;
 
   RTVal pathVal = RTVal::ConstructString(
     pathValue.getContext(),
-    path.toUtf8().constData()
+    hrPath.constData()
     );
   
-  pathValue = RTValUtil::toRTVal(pathValue);
   pathValue.setMember("path", pathVal);
 
   FABRIC_CATCH_END("DFGPathValueResolver::castPathToHRFormat");
@@ -665,3 +883,190 @@ QString DFGPathValueResolver::DFGPortPaths::getAbsoluteNodePath(
    
   return "";
 }
+
+DFGPathValueResolver_ExecNotifProxy::DFGPathValueResolver_ExecNotifProxy(
+  DFGPathValueResolver *resolver,
+  FabricCore::DFGExec exec,
+  QString const&execPath)
+  : QObject(resolver)
+  , m_resolver(resolver)
+  , m_execPath(execPath)
+{
+  m_notifier = DFGExecNotifier::Create( exec );
+
+  connect(
+    m_notifier.data(),
+    SIGNAL(nodeRenamed(FTL::CStrRef, FTL::CStrRef)),
+    this,
+    SLOT(onNodeRenamed(FTL::CStrRef, FTL::CStrRef))
+    );
+
+  connect(
+    m_notifier.data(),
+    SIGNAL(nodeRemoved(FTL::CStrRef)),
+    this,
+    SLOT(onNodeRemoved(FTL::CStrRef))
+    );
+
+  connect(
+    m_notifier.data(),
+    SIGNAL(nodePortRenamed(FTL::CStrRef, unsigned, FTL::CStrRef, FTL::CStrRef)),
+    this,
+    SLOT(onNodePortRenamed(FTL::CStrRef, unsigned, FTL::CStrRef, FTL::CStrRef))
+    );
+
+  connect(
+    m_notifier.data(),
+    SIGNAL(nodePortRemoved(FTL::CStrRef, unsigned, FTL::CStrRef)),
+    this,
+    SLOT(onNodePortRemoved(FTL::CStrRef, unsigned, FTL::CStrRef))
+    );
+
+  connect(
+    m_notifier.data(),
+    SIGNAL(instBlockRenamed(FTL::CStrRef, FTL::CStrRef, FTL::CStrRef)),
+    this,
+    SLOT(onInstBlockRenamed(FTL::CStrRef, FTL::CStrRef, FTL::CStrRef))
+    );
+
+  connect(
+    m_notifier.data(),
+    SIGNAL(instBlockRemoved(FTL::CStrRef, FTL::CStrRef)),
+    this,
+    SLOT(onInstBlockRemoved(FTL::CStrRef, FTL::CStrRef))
+    );
+
+  connect(
+    m_notifier.data(),
+    SIGNAL(instBlockPortRenamed(FTL::CStrRef, FTL::CStrRef, unsigned, FTL::CStrRef, FTL::CStrRef)),
+    this,
+    SLOT(onInstBlockPortRenamed(FTL::CStrRef, FTL::CStrRef, unsigned, FTL::CStrRef, FTL::CStrRef))
+    );
+
+  connect(
+    m_notifier.data(),
+    SIGNAL(instBlockPortRemoved(FTL::CStrRef, FTL::CStrRef, unsigned, FTL::CStrRef)),
+    this,
+    SLOT(onInstBlockPortRemoved(FTL::CStrRef, FTL::CStrRef, unsigned, FTL::CStrRef))
+    );
+
+  connect(
+    m_notifier.data(),
+    SIGNAL(removedFromOwner()),
+    this,
+    SLOT(onRemovedFromOwner())
+    );
+}
+
+DFGPathValueResolver_ExecNotifProxy::~DFGPathValueResolver_ExecNotifProxy()
+{
+}
+
+inline QString ToQString(
+  FTL::CStrRef str)
+{
+  return QString::fromUtf8(str.data(), int(str.size()));
+}
+
+void DFGPathValueResolver_ExecNotifProxy::onNodeRenamed(
+  FTL::CStrRef oldNodeName,
+  FTL::CStrRef newNodeName)
+{
+  m_resolver->invalidateResolvedPaths(
+    m_execPath,
+    ToQString(oldNodeName)
+    );
+}
+
+void DFGPathValueResolver_ExecNotifProxy::onNodeRemoved(
+  FTL::CStrRef nodeName)
+{
+  m_resolver->invalidateResolvedPaths(
+    m_execPath,
+    ToQString(nodeName)
+    );
+}
+
+void DFGPathValueResolver_ExecNotifProxy::onNodePortRenamed(
+  FTL::CStrRef nodeName,
+  unsigned portIndex,
+  FTL::CStrRef oldPortName,
+  FTL::CStrRef newPortName)
+{
+  m_resolver->invalidateResolvedPaths(
+    m_execPath,
+    ToQString(nodeName),
+    QString(),
+    ToQString(oldPortName)
+    );
+}
+
+void DFGPathValueResolver_ExecNotifProxy::onNodePortRemoved(
+  FTL::CStrRef nodeName,
+  unsigned portIndex,
+  FTL::CStrRef portName)
+{
+  m_resolver->invalidateResolvedPaths(
+    m_execPath,
+    ToQString(nodeName),
+    QString(),
+    ToQString(portName)
+    );
+}
+
+void DFGPathValueResolver_ExecNotifProxy::onInstBlockRenamed(
+  FTL::CStrRef nodeName,
+  FTL::CStrRef oldBlockName,
+  FTL::CStrRef newBlockName)
+{
+  m_resolver->invalidateResolvedPaths(
+    m_execPath,
+    ToQString(nodeName),
+    ToQString(oldBlockName)
+    );
+}
+
+void DFGPathValueResolver_ExecNotifProxy::onInstBlockRemoved(
+  FTL::CStrRef nodeName,
+  FTL::CStrRef blockName)
+{
+  m_resolver->invalidateResolvedPaths(
+    m_execPath,
+    ToQString(nodeName),
+    ToQString(blockName)
+    );
+}
+
+void DFGPathValueResolver_ExecNotifProxy::onInstBlockPortRenamed(
+  FTL::CStrRef nodeName,
+  FTL::CStrRef blockName,
+  unsigned portIndex,
+  FTL::CStrRef oldPortName,
+  FTL::CStrRef newPortName)
+{
+  m_resolver->invalidateResolvedPaths(
+    m_execPath,
+    ToQString(nodeName),
+    ToQString(blockName),
+    ToQString(oldPortName)
+    );
+}
+
+void DFGPathValueResolver_ExecNotifProxy::onInstBlockPortRemoved(
+  FTL::CStrRef nodeName,
+  FTL::CStrRef blockName,
+  unsigned portIndex,
+  FTL::CStrRef portName)
+{
+  m_resolver->invalidateResolvedPaths(
+    m_execPath,
+    ToQString(nodeName),
+    ToQString(blockName),
+    ToQString(portName)
+    );
+}
+
+void DFGPathValueResolver_ExecNotifProxy::onRemovedFromOwner()
+{
+  m_resolver->onExecRemovedFromOwner(m_execPath);
+}
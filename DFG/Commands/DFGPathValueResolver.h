@@ -5,11 +5,95 @@
 #ifndef __UI_DFG_PATH_VALUE_RESOLVER__
 #define __UI_DFG_PATH_VALUE_RESOLVER__
 
+#include <QHash>
+#include <QMap>
+#include <QByteArray>
+#include <QSharedPointer>
+#include <FTL/CStrRef.h>
+#include <FabricUI/DFG/DFGNotifier.h>
 #include <FabricUI/Commands/BasePathValueResolver.h>
 
 namespace FabricUI {
 namespace DFG {
 
+class DFGPathValueResolver;
+
+class DFGPathValueResolver_ExecNotifProxy : public QObject
+{
+  /**
+    DFGPathValueResolver_ExecNotifProxy invalidates the paths resolved
+    by a DFGPathValueResolver in an executable when the nodes, blocks
+    or ports they refer to are renamed or removed.
+  */
+
+  Q_OBJECT
+
+  public:
+    DFGPathValueResolver_ExecNotifProxy(
+      DFGPathValueResolver *resolver,
+      FabricCore::DFGExec exec,
+      QString const&execPath
+      );
+
+    virtual ~DFGPathValueResolver_ExecNotifProxy();
+
+  protected slots:
+    void onNodeRenamed(
+      FTL::CStrRef oldNodeName,
+      FTL::CStrRef newNodeName
+      );
+
+    void onNodeRemoved(
+      FTL::CStrRef nodeName
+      );
+
+    void onNodePortRenamed(
+      FTL::CStrRef nodeName,
+      unsigned portIndex,
+      FTL::CStrRef oldPortName,
+      FTL::CStrRef newPortName
+      );
+
+    void onNodePortRemoved(
+      FTL::CStrRef nodeName,
+      unsigned portIndex,
+      FTL::CStrRef portName
+      );
+
+    void onInstBlockRenamed(
+      FTL::CStrRef nodeName,
+      FTL::CStrRef oldBlockName,
+      FTL::CStrRef newBlockName
+      );
+
+    void onInstBlockRemoved(
+      FTL::CStrRef nodeName,
+      FTL::CStrRef blockName
+      );
+
+    void onInstBlockPortRenamed(
+      FTL::CStrRef nodeName,
+      FTL::CStrRef blockName,
+      unsigned portIndex,
+      FTL::CStrRef oldPortName,
+      FTL::CStrRef newPortName
+      );
+
+    void onInstBlockPortRemoved(
+      FTL::CStrRef nodeName,
+      FTL::CStrRef blockName,
+      unsigned portIndex,
+      FTL::CStrRef portName
+      );
+
+    void onRemovedFromOwner();
+
+  private:
+    DFGPathValueResolver *m_resolver;
+    QString m_execPath;
+    QSharedPointer<DFGNotifier> m_notifier;
+};
+
 class DFGPathValueResolver : public Commands::BasePathValueResolver
 {
   /**
@@ -99,13 +183,77 @@ class DFGPathValueResolver : public Commands::BasePathValueResolver
 
     FabricCore::DFGBinding getDFGBinding() const;
 
+    /// Forgets the resolved paths of the item `nodeName`,
+    /// `blockName`, `portName` of the executable at `execPath`,
+    /// and of everything inside it. Empty names are wildcards.
+    void invalidateResolvedPaths(
+      QString const&execPath,
+      QString const&nodeName,
+      QString const&blockName = QString(),
+      QString const&portName = QString()
+      );
+
+    /// Forgets all the resolved paths.
+    void clearResolvedPaths();
+
+    /// Forgets the resolved paths of the executable
+    /// at `execPath`, which doesn't exist anymore.
+    void onExecRemovedFromOwner(
+      QString const&execPath
+      );
+
   public slots:
     /// Update the binding.
     virtual void onBindingChanged(
       FabricCore::DFGBinding const &binding
       );
 
+  private slots:
+    void onBindingArgRenamed(
+      unsigned index,
+      FTL::CStrRef oldName,
+      FTL::CStrRef newName
+      );
+
+    void onBindingArgRemoved(
+      unsigned index,
+      FTL::CStrRef name
+      );
+
+    void onBindingVarInsertedOrRemoved();
+
   private:
+    /// What a path resolves to, with the strings
+    /// passed to the Core already encoded.
+    struct ResolvedPath {
+      DFGPortPaths dfgPortPaths;
+      DFGType dfgType;
+      FabricCore::DFGExec exec;
+      QByteArray relativePortPath;
+      QByteArray absolutePortPath; // without the binding ID
+      QByteArray hrPath; // see castPathToHRFormat
+
+      ResolvedPath() {
+        dfgType = DFGUnknow;
+      }
+    };
+
+    /// Gets what pathValue resolves to, from the cache
+    /// if it was already resolved. Returns false if
+    /// the path isn't known to this resolver.
+    bool resolvePath(
+      FabricCore::RTVal pathValue,
+      ResolvedPath &resolvedPath
+      );
+
+    /// Resolves the type and the DFGPortPaths of pathValue,
+    /// without using the cache.
+    FabricCore::DFGExec resolveDFGPortPathsAndType(
+      FabricCore::RTVal pathValue,
+      DFGPortPaths &dfgPortPaths,
+      DFGType &dfgType
+      );
+
     /// Removes the bindingID or the solverID from the path if set.
     QString getPathWithoutBindingOrSolverID(
       FabricCore::RTVal pathValue,
@@ -124,12 +272,20 @@ class DFGPathValueResolver : public Commands::BasePathValueResolver
     /// Replaces the bindingID by the solverID if it exists.
     /// If not (only one binding), removes the bindingID from the path.
     void castPathToHRFormat(
-      FabricCore::RTVal pathValue
+      FabricCore::RTVal pathValue,
+      QByteArray const&hrPath
       );
 
     /// Solver ID
     QString m_id;
     FabricCore::DFGBinding m_binding;
+    QSharedPointer<DFGNotifier> m_bindingNotifier;
+
+    /// Resolved paths, keyed by the path of the PathValue
+    /// (binding or solver ID and array index included).
+    QHash<QByteArray, ResolvedPath> m_resolvedPaths;
+    /// Watch the executables of the resolved paths, by exec path.
+    QMap<QString, DFGPathValueResolver_ExecNotifProxy *> m_execNotifProxies;
 };
 
 } // namespace DFG
@@ -198,11 +198,12 @@ void DFGCombinedWidget::onGraphSet(FabricUI::GraphView::Graph * graph)
 {
   if(graph != m_setGraph)
   {
+    // the graph may have been set before (see DFGWidget::onExecChanged)
     QObject::connect(graph, SIGNAL(nodeEditRequested(FabricUI::GraphView::Node*)),
-      this, SLOT(onNodeEditRequested(FabricUI::GraphView::Node*)));
+      this, SLOT(onNodeEditRequested(FabricUI::GraphView::Node*)), Qt::UniqueConnection);
 
     QObject::connect(graph, SIGNAL(nodeInspectRequested(FabricUI::GraphView::Node*)),
-      this, SLOT(onNodeInspectRequested(FabricUI::GraphView::Node*)));
+      this, SLOT(onNodeInspectRequested(FabricUI::GraphView::Node*)), Qt::UniqueConnection);
     
     m_setGraph = graph;
   }
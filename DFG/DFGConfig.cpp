@@ -105,6 +105,10 @@ DFGConfig::DFGConfig()
   GET_PARAMETER( searchFontColor, QColor( 0, 0, 0 ) );
   GET_PARAMETER( varNodeDefaultColor, QColor( 216, 140, 106 ) );
   GET_PARAMETER( varLabelDefaultColor, QColor( 190, 93, 90 ) );
+  GET_PARAMETER( progressiveLoadMinNodeCount, 200u );
+  GET_PARAMETER( progressiveLoadSliceMs, 15u );
+  GET_PARAMETER( uiGraphCacheSize, 4u );
+  GET_PARAMETER( valueEditorRefreshSliceMs, 4u );
 
   predefinedPorts.push_back( PredefinedPort( "Integer", "Integer", "i" ) );
   predefinedPorts.push_back( PredefinedPort( "Integer [0-100]", "Integer", "i", "", "{ \"uiRange\" : \"(0, 100)\" }" ) );
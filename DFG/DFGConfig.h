@@ -64,6 +64,18 @@ namespace FabricUI
       QColor varNodeDefaultColor;
       QColor varLabelDefaultColor;
 
+      // graphs with at least that many nodes are loaded in two phases
+      // (see DFGNotificationRouter::onGraphSet)
+      unsigned progressiveLoadMinNodeCount;
+      // time spent building node contents per event loop pass
+      unsigned progressiveLoadSliceMs;
+      // number of recently left graphs kept built (see DFGWidget::onExecChanged),
+      // 0 to always rebuild the graph when entering an exec
+      unsigned uiGraphCacheSize;
+      // time spent refreshing the outputs shown by the value editor per
+      // event loop pass, after an evaluation (see DFGVEEditorOwner::onOutputsChanged)
+      unsigned valueEditorRefreshSliceMs;
+
       KLEditor::EditorConfig klEditorConfig;
       GraphView::GraphConfig graphConfig;
 
@@ -8,8 +8,10 @@
 #include <QGraphicsView>
 #include <QMessageBox>
 #include <QTimer>
+#include <QThread>
 
 #include <iostream>
+#include <set>
 
 #include <FTL/JSONEnc.h>
 #include <FTL/JSONDec.h>
@@ -23,7 +25,9 @@
 #include <FabricUI/GraphView/FixedPort.h>
 #include <FabricUI/GraphView/Graph.h>
 #include <FabricUI/GraphView/Node.h>
-#include <FabricUI/GraphView/GraphRelaxer.h>
+#include <FabricUI/GraphView/GraphLayout.h>
+#include <FabricUI/GraphView/GraphLayoutWorker.h>
+#include <FabricUI/GraphView/InstBlock.h>
 #include <FabricUI/GraphView/InstBlockPort.h>
 #include <FabricUI/GraphView/NodeHeaderButton.h>
 #include <FabricUI/GraphView/NodeHeader.h>
@@ -33,6 +37,7 @@
 #include <FabricUI/DFG/DFGLogWidget.h>
 #include <FabricUI/DFG/DFGNotificationRouter.h>
 #include <FabricUI/DFG/DFGUICmdHandler.h>
+#include <FabricUI/DFG/DFGUICmd/DFGUICmd_MoveNodes.h>
 #include <FabricUI/DFG/DFGUIUtil.h>
 #include <FabricUI/DFG/DFGWidget.h>
 #include <FabricUI/DFG/DFGBindingUtils.h>
@@ -70,6 +75,12 @@ DFGController::DFGController(
   , m_defaultValuesChangedPending( false )
   , m_topoDirtyPending( false )
   , m_dirtyPending( false )
+  , m_allNodeErrorsDirty( true )
+  , m_nodeErrorsNotified( false )
+  , m_layoutThread( NULL )
+  , m_layoutWorker( NULL )
+  , m_layoutGeneration( 0 )
+  , m_layoutRunning( false )
 {
   resetTimelinePortIndices();
 
@@ -98,6 +109,15 @@ DFGController::DFGController(
 
 DFGController::~DFGController()
 {
+  if ( m_layoutWorker )
+  {
+    m_layoutWorker->cancel();
+    m_layoutThread->quit();
+    m_layoutThread->wait();
+    delete m_layoutWorker;
+  }
+  if ( m_layoutRunning )
+    QApplication::restoreOverrideCursor();
 }
 
 void DFGController::setHostBindingExec(
@@ -738,6 +758,9 @@ bool DFGController::panCanvas(QPointF pan)
 
 bool DFGController::relaxNodes(QStringList paths)
 {
+  // the relaxation follows the connections
+  gvcCompleteGraphLoad();
+
   if(paths.length() == 0)
   {
     const std::vector<GraphView::Node*> & nodes = graph()->selectedNodes();
@@ -759,53 +782,137 @@ bool DFGController::relaxNodes(QStringList paths)
   if(rootNodes.size() == 0)
     return false;
 
-  std::vector<GraphView::Node*> nodes = rootNodes[0]->upStreamNodes_deprecated(true, rootNodes);
+  std::vector<GraphView::Node*> nodes = GraphView::Node::GetUpStreamNodes(rootNodes);
   if(nodes.size() <= 1)
     return false;
 
-  GraphView::GraphRelaxer relaxer(graph()->config());
+  GraphView::GraphConfig const &config = graph()->config();
+  GraphView::GraphLayout layout(config.layoutColumnSpacing, config.layoutRowSpacing);
+
+  std::set<GraphView::Node*> rootNodeSet(rootNodes.begin(), rootNodes.end());
+  std::map<GraphView::Node*, unsigned> nodeIndices;
+  QStringList nodeNames;
+  nodeNames.reserve( int( nodes.size() ) );
   for(unsigned int i=0;i<nodes.size();i++)
   {
+    // the root nodes are left where they are
+    bool isRoot = rootNodeSet.find(nodes[i]) != rootNodeSet.end();
     QRectF rect = nodes[i]->boundingRect();
-    relaxer.addNode(nodes[i]->name().c_str(), nodes[i]->topLeftGraphPos(), nodes[i]->col(), nodes[i]->row(), rect.width(), rect.height());
+    nodeIndices[nodes[i]] =
+      layout.addNode(nodes[i]->topLeftGraphPos(), rect.size(), isRoot);
+    nodeNames.push_back( nodes[i]->name_QS() );
   }
 
-  std::vector<GraphView::Connection*> connections = graph()->connections();
-  for(unsigned int i=0;i<connections.size();i++)
+  for(unsigned int i=0;i<nodes.size();i++)
   {
-    GraphView::ConnectionTarget * src = connections[i]->src();
-    if(src->targetType() != GraphView::TargetType_Pin)
-      continue;
+    GraphView::Node *dstNode = nodes[i];
+    unsigned dstIndex = nodeIndices[dstNode];
 
-    GraphView::ConnectionTarget * dst = connections[i]->dst();
-    if(dst->targetType() != GraphView::TargetType_Pin)
-      continue;
+    std::vector<GraphView::ConnectionTarget*> targets;
+    for(unsigned int j=0;j<dstNode->pinCount();j++)
+      targets.push_back(dstNode->pin(j));
+    for(unsigned int k=0;k<dstNode->instBlockCount();k++)
+    {
+      GraphView::InstBlock *instBlock = dstNode->instBlockAtIndex(k);
+      for(unsigned int j=0;j<instBlock->instBlockPortCount();j++)
+        targets.push_back(instBlock->instBlockPort(j));
+    }
 
-    GraphView::Pin * srcPin = (GraphView::Pin *)src;
-    GraphView::Pin * dstPin = (GraphView::Pin *)dst;
+    for(unsigned int j=0;j<targets.size();j++)
+    {
+      std::vector<GraphView::Connection*> const &connections =
+        graph()->connectionsTo(targets[j]);
+      for(unsigned int c=0;c<connections.size();c++)
+      {
+        GraphView::ConnectionTarget * src = connections[c]->src();
+        GraphView::Node * srcNode = NULL;
+        if(src->targetType() == GraphView::TargetType_Pin)
+          srcNode = static_cast<GraphView::Pin *>(src)->node();
+        else if(src->targetType() == GraphView::TargetType_InstBlockPort)
+          srcNode = static_cast<GraphView::InstBlockPort *>(src)->node();
+
+        std::map<GraphView::Node*, unsigned>::const_iterator it =
+          nodeIndices.find(srcNode);
+        if(it != nodeIndices.end())
+          layout.addConnection(it->second, dstIndex);
+      }
+    }
+  }
 
-    GraphView::Node * srcNode = srcPin->node();
-    GraphView::Node * dstNode = dstPin->node();
+  // the layout is computed by the worker thread (see onNodesLayoutFinished)
+  if(!m_layoutWorker)
+  {
+    m_layoutThread = new QThread( this );
+    m_layoutWorker = new GraphView::GraphLayoutWorker();
+    m_layoutWorker->moveToThread( m_layoutThread );
+    connect(
+      m_layoutWorker, SIGNAL( progress( unsigned, float ) ),
+      this, SLOT( onNodesLayoutProgress( unsigned, float ) ),
+      Qt::QueuedConnection
+      );
+    connect(
+      m_layoutWorker, SIGNAL( finished( unsigned ) ),
+      this, SLOT( onNodesLayoutFinished( unsigned ) ),
+      Qt::QueuedConnection
+      );
+    m_layoutThread->start();
+  }
 
-    relaxer.addSpring(srcNode->name().c_str(), dstNode->name().c_str());
+  if(!m_layoutRunning)
+  {
+    QApplication::setOverrideCursor( Qt::BusyCursor );
+    m_layoutRunning = true;
   }
 
-  relaxer.relax(50);
+  m_layoutGraph = graph();
+  m_layoutNodeNames = nodeNames;
+  m_layoutWorker->post( layout, ++m_layoutGeneration );
+
+  return true;
+}
+
+void DFGController::onNodesLayoutProgress( unsigned generation, float progress )
+{
+  if ( generation == m_layoutGeneration )
+    emit nodesLayoutProgress( progress );
+}
+
+void DFGController::onNodesLayoutFinished( unsigned generation )
+{
+  // a more recent layout has been started since
+  if ( generation != m_layoutGeneration )
+    return;
+
+  if ( m_layoutRunning )
+  {
+    QApplication::restoreOverrideCursor();
+    m_layoutRunning = false;
+  }
+
+  GraphView::GraphLayout layout;
+  if ( !m_layoutWorker->takeResult( generation, layout ) )
+    return;
+
+  // the user may have left the graph, or removed some of the nodes
+  GraphView::Graph *uiGraph = graph();
+  if ( !uiGraph || uiGraph != m_layoutGraph )
+    return;
 
   QStringList nodeNames;
-  nodeNames.reserve( relaxer.numNodes() );
+  nodeNames.reserve( m_layoutNodeNames.size() );
   QList<QPointF> newTopLeftPoss;
-  newTopLeftPoss.reserve( relaxer.numNodes() );
-  for ( unsigned i=0; i<relaxer.numNodes(); i++ )
+  newTopLeftPoss.reserve( m_layoutNodeNames.size() );
+  for ( unsigned i = 0; i < layout.nodeCount(); ++i )
   {
-    FTL::CStrRef nodeName = relaxer.getName(i);
-    nodeNames.push_back( QString::fromUtf8( nodeName.data(), nodeName.size() ) );
-    newTopLeftPoss.push_back( relaxer.getPos(i) );
+    if ( !uiGraph->node( m_layoutNodeNames[i] ) )
+      continue;
+    nodeNames.push_back( m_layoutNodeNames[i] );
+    newTopLeftPoss.push_back( layout.topLeftPos( i ) );
   }
+  m_layoutNodeNames.clear();
 
-  cmdMoveNodes( nodeNames, newTopLeftPoss );
-
-  return true;
+  if ( !nodeNames.isEmpty() )
+    cmdMoveNodes( nodeNames, newTopLeftPoss );
 }
 
 bool DFGController::setNodeColor(
@@ -1033,14 +1140,18 @@ void DFGController::cmdPaste(bool mapPositionToMouseCursor)
       }
 
       // paste.
-      QList<QString> pastedNodes =
-        m_cmdHandler->dfgDoPaste(
-          getBinding(),
-          getExecPath_QS(),
-          getExec(),
-          textToPaste,
-          pos
-          );
+      QList<QString> pastedNodes;
+      {
+        DFGNotificationRouter::Batch batch( m_router );
+        pastedNodes =
+          m_cmdHandler->dfgDoPaste(
+            getBinding(),
+            getExecPath_QS(),
+            getExec(),
+            textToPaste,
+            pos
+            );
+      }
 
       selectNodes(pastedNodes);
     }
@@ -1084,7 +1195,7 @@ bool DFGController::reloadExtensionDependencies(char const * path)
 void DFGController::onTopoDirty()
 {
   updateErrors();
-  updateNodeErrors();
+  updateDirtyNodeErrors();
   updateTimelinePortIndices();
   setTimelineValuesToGraph();
 }
@@ -1096,6 +1207,37 @@ void DFGController::updateErrors()
 
 void DFGController::updateNodeErrors()
 {
+  m_allNodeErrorsDirty = true;
+  updateDirtyNodeErrors();
+}
+
+void DFGController::nodeErrorsMayHaveChanged( FTL::StrRef nodeName )
+{
+  m_nodeErrorsNotified = true;
+  if ( !nodeName.empty() && !m_allNodeErrorsDirty )
+    m_dirtyNodeErrors.insert( std::string( nodeName.data(), nodeName.size() ) );
+}
+
+void DFGController::allNodeErrorsMayHaveChanged()
+{
+  m_nodeErrorsNotified = true;
+  m_allNodeErrorsDirty = true;
+  m_dirtyNodeErrors.clear();
+}
+
+void DFGController::updateDirtyNodeErrors()
+{
+  // a topoDirty that none of the notifications of the exec accounts for
+  // comes from a change elsewhere in the binding, that any node can see
+  bool allNodes = m_allNodeErrorsDirty || !m_nodeErrorsNotified;
+  std::set<std::string> dirtyNodeNames;
+  dirtyNodeNames.swap( m_dirtyNodeErrors );
+  m_allNodeErrorsDirty = false;
+  m_nodeErrorsNotified = false;
+
+  if ( !allNodes && dirtyNodeNames.empty() )
+    return;
+
   // [pzion 20160209] This will force the Core to ensure errors are up-to-date
   (void)m_binding.hasRecursiveConnectedErrors();
 
@@ -1105,31 +1247,52 @@ void DFGController::updateNodeErrors()
     {
       GraphView::Graph *uiGraph = graph();
 
-      unsigned nodeCount = m_exec.getNodeCount();
-      for(size_t j=0;j<nodeCount;j++)
+      std::vector<GraphView::Node *> uiNodes;
+      if ( allNodes )
+      {
+        unsigned nodeCount = m_exec.getNodeCount();
+        uiNodes.reserve( nodeCount );
+        for(size_t j=0;j<nodeCount;j++)
+        {
+          if ( GraphView::Node *uiNode =
+            uiGraph->nodeFromPath( m_exec.getNodeName(j) ) )
+            uiNodes.push_back( uiNode );
+        }
+      }
+      else
+      {
+        // the connected errors of a node depend on what feeds it
+        for ( std::set<std::string>::const_iterator it = dirtyNodeNames.begin();
+          it != dirtyNodeNames.end(); ++it )
+        {
+          if ( GraphView::Node *uiNode = uiGraph->nodeFromPath( it->c_str() ) )
+            uiNodes.push_back( uiNode );
+        }
+        uiNodes = GraphView::Node::GetDownStreamNodes( uiNodes );
+      }
+
+      for(size_t j=0;j<uiNodes.size();j++)
       {
-        char const *nodeName = m_exec.getNodeName(j);
-        GraphView::Node *uiNode = uiGraph->nodeFromPath( nodeName );
-        if ( !uiNode )
+        GraphView::Node *uiNode = uiNodes[j];
+        if ( uiNode->isBlockNode() )
           continue;
 
         FabricCore::String errorsJSON =
           m_exec.getNodeErrors(
-            nodeName,
+            uiNode->name().c_str(),
             true, // recursive
             true  // connectedOnly
             );
         FTL::CStrRef errorsJSONStr( errorsJSON.getCStr(), errorsJSON.getSize() );
-        FTL::JSONStrWithLoc strWithLoc( errorsJSONStr );
-        FTL::OwnedPtr<FTL::JSONArray> errorsJSONArray(
-          FTL::JSONValue::Decode( strWithLoc )->cast<FTL::JSONArray>()
-          );
-        unsigned errorCount = errorsJSONArray->size();
-        if ( errorCount == 0 )
-          uiNode->clearError();
-        else
+
+        QString fullDesc;
+        if ( errorsJSONStr != FTL_STR("[]") )
         {
-          QString fullDesc;
+          FTL::JSONStrWithLoc strWithLoc( errorsJSONStr );
+          FTL::OwnedPtr<FTL::JSONArray> errorsJSONArray(
+            FTL::JSONValue::Decode( strWithLoc )->cast<FTL::JSONArray>()
+            );
+          unsigned errorCount = errorsJSONArray->size();
           for(unsigned i=0;i<errorCount;i++)
           {
             if ( i == 3 )
@@ -1183,8 +1346,11 @@ void DFGController::updateNodeErrors()
               fullDesc += '\n';
             fullDesc += localDesc;
           }
-          uiNode->setError( fullDesc );
         }
+
+        // setError updates the tooltip and the effect of the node
+        if ( fullDesc != uiNode->error() )
+          uiNode->setError( fullDesc );
       }
     }
   }
@@ -1195,7 +1361,17 @@ void DFGController::updateNodeErrors()
       << e.getDesc()
       << "\n";
   }
+  catch ( FabricCore::Exception e )
+  {
+    std::cout
+      << "Caught exception: "
+      << e.getDesc_cstr()
+      << "\n";
+  }
+}
 
+void DFGController::upgradeBackDrops()
+{
   // [pzion 20150701] Upgrade old backdrops scheme
   static bool upgradingBackDrops = false;
   if ( !upgradingBackDrops )
@@ -1682,6 +1858,7 @@ void DFGController::cmdRemoveNodes(
   if(!validPresetSplit())
     return;
 
+  DFGNotificationRouter::Batch batch( m_router );
   m_cmdHandler->dfgDoRemoveNodes(
     getBinding(),
     getExecPath_QS(),
@@ -1962,6 +2139,7 @@ void DFGController::cmdMoveNodes(
   QList<QPointF> newTopLeftPoss
   )
 {
+  DFGNotificationRouter::Batch batch( m_router );
   m_cmdHandler->dfgDoMoveNodes(
     getBinding(),
     getExecPath_QS(),
@@ -1969,6 +2147,36 @@ void DFGController::cmdMoveNodes(
     nodeNames,
     newTopLeftPoss
     );
+
+  // the notifications of the command are still queued in the batch
+  if ( GraphView::Graph *uiGraph = graph() )
+  {
+    int count = qMin( nodeNames.size(), newTopLeftPoss.size() );
+    for ( int i = 0; i < count; ++i )
+    {
+      QByteArray nodeNameBA = nodeNames[i].toUtf8();
+      GraphView::Node *uiNode = uiGraph->node(
+        FTL::StrRef( nodeNameBA.constData(), nodeNameBA.size() )
+        );
+      if ( uiNode )
+        setUINodePos(
+          uiNode,
+          newTopLeftPoss[i],
+          DFGUICmd_MoveNodes::EncodeUIGraphPos( newTopLeftPoss[i] )
+          );
+    }
+  }
+}
+
+void DFGController::setUINodePos(
+  GraphView::Node *uiNode,
+  QPointF newTopLeftPos,
+  std::string const &uiGraphPos
+  )
+{
+  uiNode->setTopLeftGraphPos( newTopLeftPos, false );
+  if ( m_router )
+    m_router->expectNodePosEcho( uiNode->name(), uiGraphPos );
 }
 
 void DFGController::cmdResizeBackDropNode(
@@ -1995,6 +2203,7 @@ QString DFGController::cmdImplodeNodes(
   if(!validPresetSplit())
     return "";
 
+  DFGNotificationRouter::Batch batch( m_router );
   return m_cmdHandler->dfgDoImplodeNodes(
     getBinding(),
     getExecPath_QS(),
@@ -2011,6 +2220,7 @@ QList<QString> DFGController::cmdExplodeNode(
   if(!validPresetSplit())
     return QList<QString>();
 
+  DFGNotificationRouter::Batch batch( m_router );
   return m_cmdHandler->dfgDoExplodeNode(
     getBinding(),
     getExecPath_QS(),
@@ -2161,19 +2371,8 @@ void DFGController::gvcDoMoveNode(
   }
   else
   {
-    std::string newPosJSON;
-    {
-      FTL::JSONEnc<> enc(newPosJSON);
-      FTL::JSONObjectEnc<> objEnc(enc);
-      {
-        FTL::JSONEnc<> xEnc(objEnc, FTL_STR("x"));
-        FTL::JSONFloat64Enc<> xS32Enc(xEnc, finalPos.x());
-      }
-      {
-        FTL::JSONEnc<> yEnc(objEnc, FTL_STR("y"));
-        FTL::JSONFloat64Enc<> yS32Enc(yEnc, finalPos.y());
-      }
-    }
+    DFGNotificationRouter::Batch batch( m_router );
+    std::string newPosJSON = DFGUICmd_MoveNodes::EncodeUIGraphPos( finalPos );
     getExec().setItemMetadata(
       nodeName.c_str(),
       "uiGraphPos",
@@ -2181,6 +2380,8 @@ void DFGController::gvcDoMoveNode(
       false,
       false
       );
+    if ( GraphView::Node *uiNode = graph()->node( nodeName ) )
+      setUINodePos( uiNode, finalPos, newPosJSON );
   }
 }
 
@@ -2224,6 +2425,8 @@ void DFGController::gvcDoMoveNodes(
   }
   else
   {
+    // a single batch for the whole selection
+    DFGNotificationRouter::Batch batch( m_router );
     int i = 0;
     for ( std::vector<GraphView::Node *>::const_iterator it = nodes.begin();
       it != nodes.end(); ++it, ++i )
@@ -2231,19 +2434,7 @@ void DFGController::gvcDoMoveNodes(
       GraphView::Node *node = *it;
       FTL::CStrRef nodeName = node->name();
       QPointF newPos = nodesOriginalPos[i] + delta;
-      std::string newPosJSON;
-      {
-        FTL::JSONEnc<> enc( newPosJSON );
-        FTL::JSONObjectEnc<> objEnc( enc );
-        {
-          FTL::JSONEnc<> xEnc( objEnc, FTL_STR("x") );
-          FTL::JSONFloat64Enc<> xS32Enc( xEnc, newPos.x() );
-        }
-        {
-          FTL::JSONEnc<> yEnc( objEnc, FTL_STR("y") );
-          FTL::JSONFloat64Enc<> yS32Enc( yEnc, newPos.y() );
-        }
-      }
+      std::string newPosJSON = DFGUICmd_MoveNodes::EncodeUIGraphPos( newPos );
 
       getExec().setItemMetadata(
         nodeName.c_str(),
@@ -2252,6 +2443,7 @@ void DFGController::gvcDoMoveNodes(
         false,
         false
         );
+      setUINodePos( node, newPos, newPosJSON );
     }
   }
 }
@@ -2899,6 +3091,9 @@ QMenu* DFGController::gvcCreateNodeHeaderMenu(
   PortType nodeRole
 )
 {
+  if ( m_router )
+    m_router->completeNodeLoad( node );
+
   QMenu *menu = new QMenu( this->getDFGWidget() );
 
   // go through all the node's pins and add
@@ -3040,6 +3235,12 @@ QMenu* DFGController::gvcCreateInstBlockHeaderMenu(
   return menu;
 }
 
+void DFGController::gvcCompleteGraphLoad()
+{
+  if ( m_router )
+    m_router->completeGraphLoad();
+}
+
 std::string DFGController::gvcEncodeMetadaToPersistValue()
 {
   std::string metaData;
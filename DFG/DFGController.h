@@ -14,16 +14,25 @@
 #include <FabricUI/GraphView/BackDropNode.h>
 #include <FabricUI/ValueEditor_Legacy/ValueItem.h>
 #include <SplitSearch/SplitSearch.hpp>
+#include <set>
 #include <vector>
 #include <ASTWrapper/KLASTManager.h>
 #include <QTimer>
 #include <QAction>
+#include <QPointer>
  
 using namespace FabricUI::ValueEditor_Legacy;
 
+class QThread;
+
 namespace FabricUI
 {
 
+  namespace GraphView
+  {
+    class GraphLayoutWorker;
+  };
+
   namespace DFG
   {
 
@@ -212,6 +221,7 @@ namespace FabricUI
       QMenu* gvcCreateNodeHeaderMenu( GraphView::Node *, GraphView::ConnectionTarget *, GraphView::PortType ) FTL_OVERRIDE;
       QMenu* gvcCreateInstBlockHeaderMenu( GraphView::InstBlock *, GraphView::ConnectionTarget *, GraphView::PortType ) FTL_OVERRIDE;
       std::string gvcEncodeMetadaToPersistValue() FTL_OVERRIDE;
+      void gvcCompleteGraphLoad() FTL_OVERRIDE;
 
       // Commands
 
@@ -472,8 +482,20 @@ namespace FabricUI
 
       void setBlockCompilations( bool blockCompilations );
 
+      // Requeries the errors of all the nodes of the current exec
       void updateNodeErrors();
 
+      // Called by the router for the notifications of the current exec:
+      // on topoDirty, only the nodes recorded since the previous one and
+      // their downstream nodes get their errors requeried. An empty
+      // nodeName only records that the exec was notified.
+      void nodeErrorsMayHaveChanged( FTL::StrRef nodeName );
+      void allNodeErrorsMayHaveChanged();
+
+      // [pzion 20150701] Upgrades the old backdrops scheme of the current
+      // exec, once its graph is built
+      void upgradeBackDrops();
+
       void processDelayedEvents();  // [FE-6568]
 
     signals:
@@ -501,6 +523,9 @@ namespace FabricUI
 
       void nodeEditRequested(FabricUI::GraphView::Node *);
 
+      // progress, in [0, 1], of the layout started by relaxNodes
+      void nodesLayoutProgress( float progress );
+
     public slots:
 
       void onTopoDirty();
@@ -531,8 +556,17 @@ namespace FabricUI
     private:
 
       void updateErrors();
+      void updateDirtyNodeErrors();
       void updatePresetPathDB();
 
+      // Moves the UI node right away to the position just written to its
+      // uiGraphPos metadata, and tells the router to drop the echo
+      void setUINodePos(
+        GraphView::Node *uiNode,
+        QPointF newTopLeftPos,
+        std::string const &uiGraphPos
+        );
+
       QTimer *m_notificationTimer;
       DFGWidget *m_dfgWidget;
       FabricCore::Client m_client;
@@ -563,6 +597,11 @@ namespace FabricUI
       bool m_topoDirtyPending;
       bool m_dirtyPending;
 
+      // see nodeErrorsMayHaveChanged
+      std::set<std::string> m_dirtyNodeErrors;
+      bool m_allNodeErrorsDirty;
+      bool m_nodeErrorsNotified;
+
       // helper to compute the index of a native timeline port (-1 if none)
       int getTimelinePortIndex( const std::string& name );
       // helper to set the value of a timeline port (checks for -1)
@@ -589,8 +628,19 @@ namespace FabricUI
 
       QTimer *m_executeTimer;
 
+      // Layouts started by relaxNodes, computed by a worker thread
+      QThread *m_layoutThread;
+      GraphView::GraphLayoutWorker *m_layoutWorker;
+      unsigned m_layoutGeneration;
+      QPointer<GraphView::Graph> m_layoutGraph;
+      QStringList m_layoutNodeNames;
+      bool m_layoutRunning;
+
     private slots:
 
+      void onNodesLayoutProgress( unsigned generation, float progress );
+      void onNodesLayoutFinished( unsigned generation );
+
       void onBindingDirty();
 
       void onBindingArgInserted(
@@ -1,19 +1,354 @@
 // Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
 
 #include "DFGLogWidget.h"
+#include <QAtomicInt>
+#include <QAtomicPointer>
 #include <QHBoxLayout>
 #include <QMenu>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QTimer>
 #include <QVBoxLayout>
 
 #include <FabricUI/Util/LoadFabricStyleSheet.h>
 
+#include <algorithm>
+#include <deque>
+#include <string.h>
+
 using namespace FabricServices;
 using namespace FabricUI;
 using namespace FabricUI::DFG;
 
 DFGController::LogFunc DFGLogWidget::s_logFunc = NULL;
+int DFGLogWidget::s_maxLineCount = 10000;
 std::vector<DFGLogWidget*> DFGLogWidget::sLogWidgets;
-std::vector<std::string> DFGLogWidget::sUnconsumedMessages;
+
+namespace {
+
+// Reports waiting to be displayed. Any thread can push (lock-free
+// stack); the entries are then collected, in order, into sLogPending,
+// which only keeps the newest maxLineCount() entries.
+struct LogEntry
+{
+  LogEntry * next;
+  std::string text;
+};
+
+QAtomicPointer<LogEntry> sLogQueueHead(NULL);
+// number of entries in the stack, used to collect them
+// when there is no widget to consume them
+QAtomicInt sLogQueueSize(0);
+
+// guards sLogPending and sLogDroppedCount
+QMutex sLogPendingMutex;
+std::deque<std::string> sLogPending;
+// number of entries evicted since the last TakeLogEntries()
+int sLogDroppedCount = 0;
+
+inline LogEntry * LoadLogQueueHead()
+{
+#if QT_VERSION >= 0x050000
+  return sLogQueueHead.loadAcquire();
+#else
+  return sLogQueueHead;
+#endif
+}
+
+// moves the pushed entries to the end of sLogPending and evicts
+// the oldest ones beyond maxLineCount(). sLogPendingMutex must be locked.
+void CollectLogEntries()
+{
+  LogEntry * entry = sLogQueueHead.fetchAndStoreAcquire(NULL);
+  LogEntry * ordered = NULL;
+  int count = 0;
+  while (entry)
+  {
+    LogEntry * next = entry->next;
+    entry->next = ordered;
+    ordered = entry;
+    entry = next;
+    count++;
+  }
+  sLogQueueSize.fetchAndAddRelaxed(-count);
+
+  while (ordered)
+  {
+    LogEntry * next = ordered->next;
+    sLogPending.push_back(std::string());
+    sLogPending.back().swap(ordered->text);
+    delete ordered;
+    ordered = next;
+  }
+
+  size_t maxCount = size_t(DFGLogWidget::maxLineCount());
+  while (sLogPending.size() > maxCount)
+  {
+    sLogPending.pop_front();
+    sLogDroppedCount++;
+  }
+}
+
+void PushLogEntry(char const * text)
+{
+  if (!text)
+    return;
+
+  LogEntry * entry = new LogEntry;
+  entry->text = text;
+  do
+  {
+    entry->next = LoadLogQueueHead();
+  }
+  while (!sLogQueueHead.testAndSetRelease(entry->next, entry));
+
+  // nothing drained the stack for a while (e.g. no widget yet):
+  // collect it, the oldest entries are evicted. A thread that
+  // is already collecting takes this entry as well.
+  if (sLogQueueSize.fetchAndAddRelaxed(1) >= 2 * DFGLogWidget::maxLineCount()
+    && sLogPendingMutex.tryLock())
+  {
+    CollectLogEntries();
+    sLogPendingMutex.unlock();
+  }
+}
+
+// takes the queued entries in the order they were pushed,
+// returns the number of older entries evicted in the meantime
+int TakeLogEntries(std::deque<std::string> &entries)
+{
+  QMutexLocker locker(&sLogPendingMutex);
+  CollectLogEntries();
+  entries.swap(sLogPending);
+  int dropped = sLogDroppedCount;
+  sLogDroppedCount = 0;
+  return dropped;
+}
+
+// Keywords highlighted in the log, with their color. When several
+// keywords start at the same position, the first one is used.
+struct LogKeyword
+{
+  char const * text;
+  QColor color;
+};
+
+LogKeyword const sLogKeywords[] =
+{
+  { "errors", QColor(255, 20, 10) },
+  { "error", QColor(255, 20, 10) },
+
+  { "warnings", QColor(230, 230, 10) },
+  { "warning", QColor(230, 230, 10) },
+
+  { "[fabric:mt]", QColor(137, 208, 231) },
+  { "[st]", QColor(137, 208, 231) },
+
+  { "fabric engine", QColor(42, 183, 229) },
+  { "fabric canvas", QColor(42, 183, 229) },
+  { "KL stack trace:", QColor(42, 183, 229) },
+
+  { "frogs", QColor(0, 255, 0) },
+  { "frog", QColor(0, 255, 0) },
+
+  { "teapots", QColor(255, 0, 255) },
+  { "teapot", QColor(255, 0, 255) },
+
+  { "viewport capture]", QColor(235, 215, 255) },
+};
+int const sLogKeywordCount = sizeof(sLogKeywords) / sizeof(sLogKeywords[0]);
+
+// Case-insensitive Aho-Corasick automaton over the (ASCII) keywords,
+// finding all their occurrences in a single pass over the message
+class LogKeywordMatcher
+{
+public:
+
+  struct Match
+  {
+    int start;
+    int keyword;
+    bool operator<(Match const &other) const
+    {
+      return start < other.start
+        || (start == other.start && keyword < other.keyword);
+    }
+  };
+
+  LogKeywordMatcher()
+  {
+    m_states.push_back(State());
+    for (int k = 0; k < sLogKeywordCount; ++k)
+    {
+      int state = 0;
+      for (char const *c = sLogKeywords[k].text; *c; ++c)
+      {
+        int symbol = Symbol(QChar(*c));
+        if (m_states[state].next[symbol] == 0)
+        {
+          m_states[state].next[symbol] = int(m_states.size());
+          m_states.push_back(State());
+        }
+        state = m_states[state].next[symbol];
+      }
+      m_states[state].outputs.push_back(k);
+    }
+
+    // breadth-first: compute the failure links and turn
+    // the trie into a complete transition table
+    std::vector<int> queue;
+    for (int symbol = 0; symbol < SymbolCount; ++symbol)
+      if (m_states[0].next[symbol])
+        queue.push_back(m_states[0].next[symbol]);
+    for (size_t i = 0; i < queue.size(); ++i)
+    {
+      int state = queue[i];
+      State &s = m_states[state];
+      std::vector<int> const &failOutputs = m_states[s.fail].outputs;
+      s.outputs.insert(s.outputs.end(), failOutputs.begin(), failOutputs.end());
+      for (int symbol = 0; symbol < SymbolCount; ++symbol)
+      {
+        int next = s.next[symbol];
+        if (next)
+        {
+          m_states[next].fail = m_states[s.fail].next[symbol];
+          queue.push_back(next);
+        }
+        else
+          s.next[symbol] = m_states[s.fail].next[symbol];
+      }
+    }
+  }
+
+  // the matches, sorted by start
+  void findAll(QString const &s, std::vector<Match> &matches) const
+  {
+    matches.clear();
+    int state = 0;
+    for (int i = 0; i < s.size(); ++i)
+    {
+      state = m_states[state].next[Symbol(s[i])];
+      std::vector<int> const &outputs = m_states[state].outputs;
+      for (size_t o = 0; o < outputs.size(); ++o)
+      {
+        Match match;
+        match.keyword = outputs[o];
+        match.start = i + 1 - int(strlen(sLogKeywords[match.keyword].text));
+        matches.push_back(match);
+      }
+    }
+    std::sort(matches.begin(), matches.end());
+  }
+
+private:
+
+  // non-ASCII characters are not part of any keyword
+  enum { SymbolCount = 129 };
+  static int Symbol(QChar c)
+  {
+    ushort u = c.unicode();
+    if (u >= 128)
+      return 128;
+    if (u >= 'A' && u <= 'Z')
+      u += 'a' - 'A';
+    return u;
+  }
+
+  struct State
+  {
+    int next[SymbolCount];
+    int fail;
+    std::vector<int> outputs;
+    State() : fail(0) { memset(next, 0, sizeof(next)); }
+  };
+
+  std::vector<State> m_states;
+};
+
+struct LogSegment
+{
+  QString text;
+  QColor color;
+  bool newLine;
+};
+
+// splits a message using the keywords, and colors the parts
+void AppendLogSegments(
+  LogKeywordMatcher const &matcher,
+  QString const &s,
+  std::vector<LogKeywordMatcher::Match> &matches,
+  std::vector<LogSegment> &segments
+  )
+{
+  // set the default text color
+  QColor defaultTextColor(233, 233, 233);
+
+  matcher.findAll(s, matches);
+
+  // flags indicating if the string contains the error
+  // and/or warning words.
+  bool messageContainsErrors = false;
+  bool messageContainsWarnings = false;
+  for (size_t i = 0; i < matches.size(); ++i)
+  {
+    char const *keyword = sLogKeywords[matches[i].keyword].text;
+    if (strcmp(keyword, "error") == 0)
+      messageContainsErrors = true;
+    else if (strcmp(keyword, "warning") == 0)
+      messageContainsWarnings = true;
+  }
+
+  int pos = 0;
+  size_t firstSegment = segments.size();
+  for (size_t i = 0; i <= matches.size(); ++i)
+  {
+    int sIndex = s.size();
+    int kIndex = -1;
+    if (i < matches.size())
+    {
+      // skip the keywords overlapping the previous one
+      if (matches[i].start < pos)
+        continue;
+      sIndex = matches[i].start;
+      kIndex = matches[i].keyword;
+    }
+
+    for (int part = 0; part < 2; ++part)
+    {
+      LogSegment segment;
+      bool messageIsKeyword = (part == 1);
+      if (messageIsKeyword)
+      {
+        if (kIndex < 0)
+          break;
+        int length = int(strlen(sLogKeywords[kIndex].text));
+        segment.text = s.mid(sIndex, length);
+        segment.color = sLogKeywords[kIndex].color;
+        pos = sIndex + length;
+      }
+      else
+      {
+        if (sIndex == pos)
+          continue;
+        segment.text = s.mid(pos, sIndex - pos);
+        segment.color = defaultTextColor;
+      }
+
+      if (messageContainsErrors)
+      {
+        if (!messageIsKeyword)
+          segment.color = QColor(255, 20, 10);
+      }
+      else if (messageContainsWarnings)
+        segment.color = QColor(230, 230, 10);
+
+      segment.newLine = (segments.size() == firstSegment);
+      segments.push_back(segment);
+    }
+  }
+}
+
+}
 
 DFGLogWidget::DFGLogWidget( const DFGConfig & config )
   : m_config( config )
@@ -31,6 +366,8 @@ DFGLogWidget::DFGLogWidget( const DFGConfig & config )
   m_text->setFont( m_config.fixedFont );
   m_text->initFontPointSizeMembers();
   m_text->setReadOnly(true);
+  m_text->setUndoRedoEnabled(false);
+  m_text->setMaximumBlockCount(s_maxLineCount);
   m_text->setContextMenuPolicy( Qt::CustomContextMenu );
   connect(
     m_text, SIGNAL(customContextMenuRequested(const QPoint&)),
@@ -44,9 +381,16 @@ DFGLogWidget::DFGLogWidget( const DFGConfig & config )
 
   sLogWidgets.push_back(this);
 
-  for(size_t i=0;i<sUnconsumedMessages.size();i++)
-    log(sUnconsumedMessages[i].c_str());
-  sUnconsumedMessages.clear();
+  m_drainTimer = new QTimer(this);
+  m_drainTimer->setInterval(50);
+  connect(
+    m_drainTimer, SIGNAL(timeout()),
+    this, SLOT(drainQueue())
+    );
+  m_drainTimer->start();
+
+  // display the messages reported before this widget existed
+  drainQueue();
 }
 
 DFGLogWidget::~DFGLogWidget()
@@ -106,132 +450,71 @@ void DFGLogWidget::callback(
   uint32_t stringLength
   )
 {
-  if(sLogWidgets.size() > 0)
-  {
-    // set the default text color and the keyword-color pairs.
-    QColor defaultTextColor(233, 233, 233);
-
-    std::vector<std::pair<QString, QColor> > keywords;
-
-    keywords.push_back(std::make_pair("errors", QColor(255, 20, 10)));
-    keywords.push_back(std::make_pair("error", QColor(255, 20, 10)));
-
-    keywords.push_back(std::make_pair("warnings", QColor(230, 230, 10)));
-    keywords.push_back(std::make_pair("warning", QColor(230, 230, 10)));
-
-    keywords.push_back(std::make_pair("[fabric:mt]", QColor(137, 208, 231)));
-    keywords.push_back(std::make_pair("[st]", QColor(137, 208, 231)));
+  // displayed later by drainQueue(), on the GUI thread
+  PushLogEntry(stringData);
 
-    keywords.push_back(std::make_pair("fabric engine", QColor(42, 183, 229)));
-    keywords.push_back(std::make_pair("fabric canvas", QColor(42, 183, 229)));
-    keywords.push_back(std::make_pair("KL stack trace:", QColor(42, 183, 229)));
-
-    keywords.push_back(std::make_pair("frogs", QColor(0, 255, 0)));
-    keywords.push_back(std::make_pair("frog", QColor(0, 255, 0)));
+  if(s_logFunc)
+    (*s_logFunc)(stringData);
+  else
+    printf("%s\n", stringData);
+}
 
-    keywords.push_back(std::make_pair("teapots", QColor(255, 0, 255)));
-    keywords.push_back(std::make_pair("teapot", QColor(255, 0, 255)));
+void DFGLogWidget::drainQueue()
+{
+  if(sLogWidgets.size() == 0)
+    return;
 
-    keywords.push_back(std::make_pair("viewport capture]", QColor(235, 215, 255)));
+  std::deque<std::string> entries;
+  int dropped = TakeLogEntries(entries);
+  if(entries.empty())
+    return;
 
-    // create a QString from the data and set the global
-    // flags indicating if the string contains the error
-    // and/or warning words.
-    QString s(stringData);
-    bool messageContainsErrors   = (s.indexOf("error",   0, Qt::CaseInsensitive) >= 0);
-    bool messageContainsWarnings = (s.indexOf("warning", 0, Qt::CaseInsensitive) >= 0);
+  static LogKeywordMatcher const matcher;
+  std::vector<LogKeywordMatcher::Match> matches;
+  std::vector<LogSegment> segments;
+  if(dropped > 0)
+  {
+    QString text = QString("[%1 older log lines were dropped]").arg(dropped);
+    AppendLogSegments(matcher, text, matches, segments);
+  }
+  for(size_t i=0;i<entries.size();i++)
+    AppendLogSegments(matcher, QString(entries[i].c_str()), matches, segments);
 
-    // split the string using the keywords.
-    QStringList messages;
-    while (true)
+  // insert the colorized strings into
+  // the log widgets' plain text edits.
+  for(size_t i=0;i<sLogWidgets.size();i++)
+  {
+    QPlainTextEdit &t = *sLogWidgets[i]->m_text;
+
+    QTextCharFormat format = t.currentCharFormat();
+    QTextCursor cursor(t.document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.beginEditBlock();
+    bool firstLine = t.document()->isEmpty();
+    for(size_t j=0;j<segments.size();j++)
     {
-      int sIndex = -1;
-      int kIndex = -1;
-      for (size_t i=0;i<keywords.size();i++)
-      {
-        int index = s.indexOf(keywords[i].first, 0, Qt::CaseInsensitive);
-        if (index < 0)
-          continue;
-        if (sIndex < 0 || index < sIndex)
-        {
-          sIndex = index;
-          kIndex = i;
-        }
-      }
-      if (sIndex < 0)
-      {
-        if (s.size())
-          messages.push_back(s);
-        break;
-      }
-      else
+      if(segments[j].newLine)
       {
-        if (sIndex)
-          messages.push_back(s.mid(0, sIndex));
-        messages.push_back(s.mid(sIndex, keywords[kIndex].first.size()));
-        s = s.mid(sIndex + keywords[kIndex].first.size());
+        if(!firstLine)
+          cursor.insertBlock();
+        firstLine = false;
       }
+      format.setForeground(segments[j].color);
+      cursor.insertText(segments[j].text, format);
     }
+    cursor.endEditBlock();
 
-    // insert the colorized strings into
-    // the log widgets' plain text edits.
-    for(size_t i=0;i<sLogWidgets.size();i++)
-    {
-      QPlainTextEdit &t = *sLogWidgets[i]->m_text;
-
-      QTextCharFormat format = t.currentCharFormat();
-      for (int j=0;j<messages.size();j++)
-      {
-        bool messageIsKeyword = false;
-        QColor textColor(defaultTextColor);
-        for (size_t k=0;k<keywords.size();k++)
-        {
-          if (keywords[k].first.compare(messages[j], Qt::CaseInsensitive))
-            continue;
-          textColor = keywords[k].second;
-          messageIsKeyword = true;
-          break;
-        }
-        if (messageContainsErrors)
-        {
-          if (!messageIsKeyword)
-          {
-            textColor.setRed  (255);
-            textColor.setGreen( 20);
-            textColor.setBlue ( 10);
-          }
-        }
-        else if (messageContainsWarnings)
-        {
-          textColor.setRed  (230);
-          textColor.setGreen(230);
-          textColor.setBlue ( 10);
-        }
-        if (j == 0)
-          t.appendPlainText("");
-        format.setForeground(textColor);
-        t.setCurrentCharFormat(format);
-        t.moveCursor(QTextCursor::End);
-        t.setCurrentCharFormat(format);
-        t.insertPlainText(messages[j]);
-      }
-
-      // [FE-6563] scroll to the last line.
-      QTextCursor cursor = t.textCursor();
-      cursor.movePosition(QTextCursor::End);
-      t.setTextCursor(cursor);
-      t.ensureCursorVisible();
-    }
-  }
-  else
-  {
-    sUnconsumedMessages.push_back(stringData);
+    // [FE-6563] scroll to the last line.
+    t.moveCursor(QTextCursor::End);
+    t.ensureCursorVisible();
   }
+}
 
-  if(s_logFunc)
-    (*s_logFunc)(stringData);
-  else
-    printf("%s\n", stringData);
+void DFGLogWidget::setMaxLineCount(int count)
+{
+  s_maxLineCount = std::max(1, count);
+  for(size_t i=0;i<sLogWidgets.size();i++)
+    sLogWidgets[i]->m_text->setMaximumBlockCount(s_maxLineCount);
 }
 
 void DFGLogWidget::keyPressEvent(QKeyEvent * event)
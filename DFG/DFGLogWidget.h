@@ -9,6 +9,8 @@
 #include "DFGConfig.h"
 #include "DFGController.h"
 
+class QTimer;
+
 namespace FabricUI
 {
 
@@ -106,18 +108,30 @@ namespace FabricUI
 
       static void setLogFunc(DFGController::LogFunc func);
 
+      // maximum number of lines kept by the log widgets, the oldest
+      // lines are removed first
+      static void setMaxLineCount(int count);
+      static int maxLineCount() { return s_maxLineCount; }
+
     public slots:
 
       void clear();
       void showContextMenu( QPoint const &pos );
 
+    private slots:
+
+      // the reports can come from any thread: they are queued
+      // by callback() and appended to the widgets on a timer
+      void drainQueue();
+
     private:
 
       DFGLogWidgetPlainTextEdit * m_text;
       DFGConfig m_config;
+      QTimer * m_drainTimer;
 
       static DFGController::LogFunc s_logFunc;
-      static std::vector<std::string> sUnconsumedMessages;
+      static int s_maxLineCount;
       static std::vector<DFGLogWidget*> sLogWidgets;
     };
 
@@ -15,8 +15,15 @@
 #include <FabricUI/DFG/DFGNotificationRouter.h>
 #include <FabricUI/DFG/DFGWidget.h>
 
+#include <FTL/JSONDec.h>
 #include <FTL/JSONValue.h>
 
+#include <QElapsedTimer>
+
+#include <assert.h>
+#include <string.h>
+#include <set>
+
 using namespace FabricServices;
 using namespace FabricUI;
 using namespace FabricUI::DFG;
@@ -28,10 +35,21 @@ DFGNotificationRouter::DFGNotificationRouter(
   : m_dfgController( dfgController )
   , m_config( config )
   , m_performChecks( true )
+  , m_batchDepth( 0 )
+  , m_flushing( false )
+  , m_active( true )
+  , m_stale( false )
+  , m_pendingDesc( NULL )
+  , m_pendingLoadPosted( false )
 {
   onExecChanged();
 }
 
+DFGNotificationRouter::~DFGNotificationRouter()
+{
+  clearPendingNodes();
+}
+
 void DFGNotificationRouter::onExecChanged()
 {
   FabricCore::DFGExec &exec = m_dfgController->getExec();
@@ -41,617 +59,1165 @@ void DFGNotificationRouter::onExecChanged()
     m_coreDFGView = FabricCore::DFGView();
 }
 
+void DFGNotificationRouter::beginBatch()
+{
+  ++m_batchDepth;
+}
+
+void DFGNotificationRouter::endBatch()
+{
+  assert( m_batchDepth > 0 );
+  if ( --m_batchDepth == 0 && m_active )
+    flushNotifications();
+}
+
+void DFGNotificationRouter::setActive( bool active )
+{
+  if ( m_active == active )
+    return;
+  m_active = active;
+  if ( !m_active || m_stale )
+    return;
+
+  if ( m_batchDepth == 0 && !m_pendingJSONOffsets.empty() )
+    flushNotifications();
+  if ( !m_pendingNodes.empty() )
+    postLoadPendingNodes();
+}
+
+void DFGNotificationRouter::expectNodePosEcho(
+  FTL::StrRef nodeName,
+  std::string const &uiGraphPos
+  )
+{
+  m_expectedNodePosEchoes[std::string( nodeName.data(), nodeName.size() )] =
+    uiGraphPos;
+}
+
 void DFGNotificationRouter::callback( FTL::CStrRef jsonStr )
 {
-  try
-  {
-    // printf( "notif = %s\n", jsonStr.c_str() );
-    
-    // FabricCore::DFGStringResult desc = m_exec.getDesc();
-    // printf( "exec = %s\n", desc.getCString() );
+  // printf( "notif = %s\n", jsonStr.c_str() );
 
-    onNotification(jsonStr);
+  if ( m_stale )
+    return;
 
-    FTL::JSONStrWithLoc jsonStrWithLoc( jsonStr );
-    FTL::OwnedPtr<FTL::JSONObject> jsonObject(
-      FTL::JSONValue::Decode( jsonStrWithLoc )->cast<FTL::JSONObject>()
-      );
-    FTL::StrRef descStr = jsonObject->getString( FTL_STR("desc") );
+  onNotification(jsonStr);
 
-    if(descStr == FTL_STR("nodeInserted"))
-    {
-      onNodeInserted(
-        jsonObject->getString( FTL_STR("nodeName") ),
-        jsonObject->get( FTL_STR("nodeDesc") )->cast<FTL::JSONObject>()
-        );
-    }
-    else if(descStr == FTL_STR("nodeRemoved"))
-    {
-      onNodeRemoved(
-        jsonObject->getString( FTL_STR("nodeName") )
-        );
-    }
-    else if(descStr == FTL_STR("nodePortInserted"))
-    {
-      onNodePortInserted(
-        jsonObject->getString( FTL_STR("nodeName") ),
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->get( FTL_STR("portDesc") )->cast<FTL::JSONObject>()
-        );
-    }
-    else if(descStr == FTL_STR("nodePortRemoved"))
-    {
-      onNodePortRemoved(
-        jsonObject->getString( FTL_STR("nodeName") ),
-        jsonObject->getString( FTL_STR("portName") )
-        );
-    }
-    else if(descStr == FTL_STR("execPortInserted"))
-    {
-      onExecPortInserted(
-        jsonObject->getSInt32( FTL_STR( "portIndex" ) ),
-        jsonObject->getString( FTL_STR( "portName" ) ),
-        jsonObject->get( FTL_STR("portDesc") )->cast<FTL::JSONObject>()
-        );
-    }
-    else if(descStr == FTL_STR("execFixedPortInserted"))
-    {
-      onExecFixedPortInserted(
-        jsonObject->getSInt32( FTL_STR( "portIndex" ) ),
-        jsonObject->getString( FTL_STR( "portName" ) ),
-        jsonObject->get( FTL_STR("portDesc") )->cast<FTL::JSONObject>()
-        );
-    }
-    else if(descStr == FTL_STR("execPortRemoved"))
-    {
-      onExecPortRemoved(
-        jsonObject->getSInt32( FTL_STR( "portIndex" ) ),
-        jsonObject->getString( FTL_STR( "portName" ) )
-        );
-    }
-    else if(descStr == FTL_STR("execFixedPortRemoved"))
-    {
-      onExecFixedPortRemoved(
-        jsonObject->getSInt32( FTL_STR( "portIndex" ) ),
-        jsonObject->getString( FTL_STR( "portName" ) )
-        );
-    }
-    else if(descStr == FTL_STR("portsConnected"))
-    {
-      onPortsConnected(
-        jsonObject->getString( FTL_STR("srcPath") ),
-        jsonObject->getString( FTL_STR("dstPath") )
-        );
-    }
-    else if(descStr == FTL_STR("portsDisconnected"))
-    {
-      onPortsDisconnected(
-        jsonObject->getString( FTL_STR("srcPath") ),
-        jsonObject->getString( FTL_STR("dstPath") )
-        );
-    }
-    else if(descStr == FTL_STR("nodeMetadataChanged"))
-    {
-      onNodeMetadataChanged(
-        jsonObject->getString( FTL_STR("nodeName") ),
-        jsonObject->getString( FTL_STR("key") ),
-        jsonObject->getString( FTL_STR("value") )
-        );
-    }
-    else if(descStr == FTL_STR("execBlockMetadataChanged"))
-    {
-      onExecBlockMetadataChanged(
-        jsonObject->getString( FTL_STR("blockName") ),
-        jsonObject->getString( FTL_STR("key") ),
-        jsonObject->getString( FTL_STR("value") )
-        );
-    }
-    else if(descStr == FTL_STR("instExecTitleChanged"))
-    {
-      onNodeTitleChanged(
-        jsonObject->getString( FTL_STR("instName") ),
-        jsonObject->getString( FTL_STR("execTitle") )
-        );
-    }
-    else if(descStr == FTL_STR("nodeRenamed"))
-    {
-      onNodeRenamed(
-        jsonObject->getString( FTL_STR("oldNodeName") ),
-        jsonObject->getString( FTL_STR("nodeName") )
-        );
-    }
-    else if(descStr == FTL_STR("execBlockRenamed"))
-    {
-      onNodeRenamed(
-        jsonObject->getString( FTL_STR("oldBlockName") ),
-        jsonObject->getString( FTL_STR("blockName") )
-        );
-    }
-    else if(descStr == FTL_STR("instBlockRenamed"))
-    {
-      onInstBlockRenamed(
-        jsonObject->getSInt32( FTL_STR("instIndex") ),
-        jsonObject->getString( FTL_STR("instName") ),
-        jsonObject->getSInt32( FTL_STR("blockIndex") ),
-        jsonObject->getString( FTL_STR("oldBlockName") ),
-        jsonObject->getString( FTL_STR("blockName") )
-        );
-    }
-    else if(descStr == FTL_STR("execPortRenamed"))
-    {
-      onExecPortRenamed(
-        jsonObject->getString( FTL_STR("oldPortName") ),
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->get( FTL_STR("portDesc") )->cast<FTL::JSONObject>()
-        );
-    }
-    else if(descStr == FTL_STR("execFixedPortRenamed"))
-    {
-      onExecFixedPortRenamed(
-        jsonObject->getString( FTL_STR("oldPortName") ),
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->get( FTL_STR("portDesc") )->cast<FTL::JSONObject>()
-        );
-    }
-    else if(descStr == FTL_STR("nodePortRenamed"))
-    {
-      onNodePortRenamed(
-        jsonObject->getString( FTL_STR("nodeName") ),
-        jsonObject->getString( FTL_STR("oldPortName") ),
-        jsonObject->getString( FTL_STR("portName") )
-        );
-    }
-    else if(descStr == FTL_STR("execMetadataChanged"))
-    {
-      onExecMetadataChanged(
-        jsonObject->getString( FTL_STR("key") ),
-        jsonObject->getString( FTL_STR("value") )
-        );
-    }
-    else if(descStr == FTL_STR("extDepAdded"))
-    {
-      onExtDepAdded(
-        jsonObject->getString( FTL_STR("name") ),
-        jsonObject->getString( FTL_STR("versionRange") )
-        );
-    }
-    else if(descStr == FTL_STR("extDepRemoved"))
-    {
-      onExtDepRemoved(
-        jsonObject->getString( FTL_STR("name") ),
-        jsonObject->getString( FTL_STR("versionRange") )
-        );
-    }
-    else if(descStr == FTL_STR("nodeCacheRuleChanged"))
-    {
-      onNodeCacheRuleChanged(
-        jsonObject->getString( FTL_STR("nodeName") ),
-        jsonObject->getString( FTL_STR("cacheRule") )
-        );
-    }
-    else if(descStr == FTL_STR("execCacheRuleChanged"))
-    {
-      onExecCacheRuleChanged(
-        jsonObject->getString( FTL_STR("cacheRule") )
-        );
+  if ( !m_active )
+  {
+    // the graph is put aside: don't let the queue grow without bounds
+    // for an exec that may never be displayed again
+    static size_t const MaxInactiveQueueSize = 1 << 20;
+    if ( strstr( jsonStr.c_str(), "\"removedFromOwner\"" ) != NULL
+      || m_pendingJSON.size() + jsonStr.size() > MaxInactiveQueueSize )
+    {
+      m_stale = true;
+      m_pendingJSON.clear();
+      m_pendingJSONOffsets.clear();
+      clearPendingNodes();
+      return;
     }
-    else if(descStr == FTL_STR("execPortResolvedTypeChanged"))
+  }
+
+  m_pendingJSONOffsets.push_back( m_pendingJSON.size() );
+  m_pendingJSON.append( jsonStr.data(), jsonStr.size() );
+  m_pendingJSON.push_back( '\0' );
+
+  if ( m_batchDepth == 0 && m_active )
+    flushNotifications();
+}
+
+DFGNotificationRouter::HandlerMap const &DFGNotificationRouter::GetHandlerMap()
+{
+  static HandlerMap handlerMap;
+  if ( handlerMap.empty() )
+  {
+#define ADD_HANDLER( desc, kind, nodeKey, otherKey ) \
+    { \
+      HandlerEntry entry = { \
+        &DFGNotificationRouter::handler_##desc, kind, nodeKey, otherKey \
+      }; \
+      handlerMap[FTL_STR(#desc)] = entry; \
+    }
+#define ADD_IGNORED( desc ) \
+    { \
+      HandlerEntry entry = { \
+        &DFGNotificationRouter::handler_ignored, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() \
+      }; \
+      handlerMap[FTL_STR(#desc)] = entry; \
+    }
+
+    ADD_HANDLER( execBlockInserted, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execBlockMetadataChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execBlockPortDefaultValuesChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execBlockPortInserted, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execBlockPortOutsidePortTypeChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execBlockPortRemoved, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execBlockPortRenamed, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execBlockPortResolvedTypeChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execBlockPortsReordered, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execBlockPortTypeSpecChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execBlockRemoved, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execBlockRenamed, CoalesceKind_NodeRenamed, FTL_STR("blockName"), FTL_STR("oldBlockName") )
+    ADD_HANDLER( execCacheRuleChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execDidAttachPreset, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execEditWouldSplitFromPresetMayHaveChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execFixedPortInserted, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execFixedPortRemoved, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execFixedPortRenamed, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execFixedPortResolvedTypeChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execFixedPortsReordered, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execMetadataChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execPortDefaultValuesChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execPortInserted, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execPortMetadataChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execPortRemoved, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execPortRenamed, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execPortResolvedTypeChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execPortsReordered, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execPortTypeChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execPortTypeSpecChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execTitleChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( execWillDetachPreset, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( extDepAdded, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( extDepRemoved, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( extDepsChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( funcCodeChanged, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( instBlockExecEditWouldSplitFromPresetMayHaveChanged, CoalesceKind_NodeScoped, FTL_STR("instName"), FTL::StrRef() )
+    ADD_HANDLER( instBlockInserted, CoalesceKind_NodeScoped, FTL_STR("instName"), FTL::StrRef() )
+    ADD_HANDLER( instBlockPortDefaultValuesChanged, CoalesceKind_NodeScoped, FTL_STR("instName"), FTL::StrRef() )
+    ADD_HANDLER( instBlockPortInserted, CoalesceKind_NodeScoped, FTL_STR("instName"), FTL::StrRef() )
+    ADD_HANDLER( instBlockPortRemoved, CoalesceKind_NodeScoped, FTL_STR("instName"), FTL::StrRef() )
+    ADD_HANDLER( instBlockPortRenamed, CoalesceKind_NodeScoped, FTL_STR("instName"), FTL::StrRef() )
+    ADD_HANDLER( instBlockPortResolvedTypeChanged, CoalesceKind_NodeScoped, FTL_STR("instName"), FTL::StrRef() )
+    ADD_HANDLER( instBlockPortsReordered, CoalesceKind_NodeScoped, FTL_STR("instName"), FTL::StrRef() )
+    ADD_HANDLER( instBlockRemoved, CoalesceKind_NodeScoped, FTL_STR("instName"), FTL::StrRef() )
+    ADD_HANDLER( instBlockRenamed, CoalesceKind_NodeScoped, FTL_STR("instName"), FTL::StrRef() )
+    ADD_HANDLER( instExecDidAttachPreset, CoalesceKind_NodeScoped, FTL_STR("nodeName"), FTL::StrRef() )
+    ADD_HANDLER( instExecEditWouldSplitFromPresetMayHaveChanged, CoalesceKind_NodeScoped, FTL_STR("instName"), FTL::StrRef() )
+    ADD_HANDLER( instExecTitleChanged, CoalesceKind_NodeScoped, FTL_STR("instName"), FTL::StrRef() )
+    ADD_HANDLER( instExecWillDetachPreset, CoalesceKind_NodeScoped, FTL_STR("nodeName"), FTL::StrRef() )
+    ADD_HANDLER( nodeCacheRuleChanged, CoalesceKind_NodeScoped, FTL_STR("nodeName"), FTL::StrRef() )
+    ADD_HANDLER( nodeInserted, CoalesceKind_NodeInserted, FTL_STR("nodeName"), FTL::StrRef() )
+    ADD_HANDLER( nodeMetadataChanged, CoalesceKind_NodeMetadataChanged, FTL_STR("nodeName"), FTL_STR("key") )
+    ADD_HANDLER( nodePortDefaultValuesChanged, CoalesceKind_NodeScoped, FTL_STR("nodeName"), FTL::StrRef() )
+    ADD_HANDLER( nodePortInserted, CoalesceKind_NodeScoped, FTL_STR("nodeName"), FTL::StrRef() )
+    ADD_HANDLER( nodePortMetadataChanged, CoalesceKind_NodeScoped, FTL_STR("nodeName"), FTL::StrRef() )
+    ADD_HANDLER( nodePortRemoved, CoalesceKind_NodeScoped, FTL_STR("nodeName"), FTL::StrRef() )
+    ADD_HANDLER( nodePortRenamed, CoalesceKind_NodeScoped, FTL_STR("nodeName"), FTL::StrRef() )
+    ADD_HANDLER( nodePortResolvedTypeChanged, CoalesceKind_NodeScoped, FTL_STR("nodeName"), FTL::StrRef() )
+    ADD_HANDLER( nodePortsReordered, CoalesceKind_NodeScoped, FTL_STR("nodeName"), FTL::StrRef() )
+    ADD_HANDLER( nodePortTypeChanged, CoalesceKind_NodeScoped, FTL_STR("nodeName"), FTL::StrRef() )
+    ADD_HANDLER( nodeRemoved, CoalesceKind_NodeRemoved, FTL_STR("nodeName"), FTL::StrRef() )
+    ADD_HANDLER( nodeRenamed, CoalesceKind_NodeRenamed, FTL_STR("nodeName"), FTL_STR("oldNodeName") )
+    ADD_HANDLER( portsConnected, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( portsDisconnected, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    ADD_HANDLER( refVarPathChanged, CoalesceKind_NodeScoped, FTL_STR("refName"), FTL::StrRef() )
+    ADD_HANDLER( removedFromOwner, CoalesceKind_None, FTL::StrRef(), FTL::StrRef() )
+    // TODO
+    ADD_IGNORED( nlsPortInserted )
+    ADD_IGNORED( nlsPortMetadataChanged )
+    ADD_IGNORED( nlsPortRemoved )
+    ADD_IGNORED( nlsPortRenamed )
+    ADD_IGNORED( nlsPortResolvedTypeChanged )
+    ADD_IGNORED( nlsPortTypeSpecChanged )
+    ADD_IGNORED( nlsPortsReordered )
+
+#undef ADD_IGNORED
+#undef ADD_HANDLER
+  }
+  return handlerMap;
+}
+
+DFGNotificationRouter::Field const *
+DFGNotificationRouter::Notification::findField( FTL::StrRef key ) const
+{
+  for ( size_t i = 0; i < m_fieldCount; ++i )
+  {
+    Field const &field = m_fields[i];
+    if ( FTL::StrRef( &m_arena[field.keyOffset], field.keyLength ) == key )
+      return &field;
+  }
+  return NULL;
+}
+
+FTL::CStrRef DFGNotificationRouter::Notification::getString(
+  FTL::StrRef key
+  ) const
+{
+  Field const *field = findField( key );
+  if ( !field )
+    return FTL::CStrRef();
+  return FTL::CStrRef( &m_arena[field->valueOffset], field->valueLength );
+}
+
+int32_t DFGNotificationRouter::Notification::getSInt32(
+  FTL::StrRef key
+  ) const
+{
+  Field const *field = findField( key );
+  if ( !field )
+    return 0;
+  return field->intValue;
+}
+
+FTL::JSONObject const *
+DFGNotificationRouter::Notification::decodeJSONObject() const
+{
+  FTL::JSONStrWithLoc jsonStrWithLoc( m_json );
+  return FTL::JSONValue::Decode( jsonStrWithLoc )->cast<FTL::JSONObject>();
+}
+
+DFGNotificationRouter::Notification DFGNotificationRouter::notification(
+  QueuedNotification const &queued
+  ) const
+{
+  Notification result;
+  result.m_arena = m_arena.data();
+  result.m_fields = m_fields.empty()? NULL: &m_fields[0] + queued.firstField;
+  result.m_fieldCount = queued.fieldCount;
+  result.m_json = FTL::CStrRef(
+    m_processingJSON.data() + queued.jsonOffset,
+    queued.jsonLength
+    );
+  return result;
+}
+
+void DFGNotificationRouter::preParseNotification(
+  FTL::CStrRef jsonStr,
+  size_t jsonOffset
+  )
+{
+  // Only the top-level string and integer members are decoded here; this
+  // is all most notifications carry and it only appends to buffers that
+  // are reused from batch to batch.
+  QueuedNotification queued;
+  queued.entry = NULL;
+  queued.jsonOffset = jsonOffset;
+  queued.jsonLength = jsonStr.size();
+  queued.firstField = m_fields.size();
+  queued.fieldCount = 0;
+  queued.dropped = false;
+
+  try
+  {
+    FTL::JSONStrWithLoc jsonStrWithLoc( jsonStr );
+    FTL::JSONObjectDec<FTL::JSONStrWithLoc> jsonObjectDec( jsonStrWithLoc );
+    FTL::JSONEnt<FTL::JSONStrWithLoc> keyEnt, valueEnt;
+    while ( jsonObjectDec.getNext( keyEnt, valueEnt ) )
     {
-      onExecPortResolvedTypeChanged(
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->getStringOrEmpty( FTL_STR("newResolvedType") )
-        );
+      if ( keyEnt.stringIs( FTL_STR("desc") ) )
+      {
+        size_t descOffset = m_arena.size();
+        valueEnt.stringAppendTo( m_arena );
+        FTL::StrRef descStr(
+          m_arena.data() + descOffset,
+          m_arena.size() - descOffset
+          );
+
+        HandlerMap const &handlerMap = GetHandlerMap();
+        HandlerMap::const_iterator it = handlerMap.find( descStr );
+        if ( it != handlerMap.end() )
+          queued.entry = &it->second;
+        m_arena.resize( descOffset );
+        continue;
+      }
+
+      Field field;
+      field.intValue = 0;
+      if ( valueEnt.getType() == valueEnt.Type_String )
+      {
+        field.keyOffset = m_arena.size();
+        keyEnt.stringAppendTo( m_arena );
+        field.keyLength = m_arena.size() - field.keyOffset;
+        m_arena.push_back( '\0' );
+
+        field.valueOffset = m_arena.size();
+        valueEnt.stringAppendTo( m_arena );
+        field.valueLength = m_arena.size() - field.valueOffset;
+        m_arena.push_back( '\0' );
+      }
+      else if ( valueEnt.getType() == valueEnt.Type_Int32 )
+      {
+        field.keyOffset = m_arena.size();
+        keyEnt.stringAppendTo( m_arena );
+        field.keyLength = m_arena.size() - field.keyOffset;
+        m_arena.push_back( '\0' );
+
+        field.valueOffset = field.keyOffset + field.keyLength;
+        field.valueLength = 0;
+        field.intValue = valueEnt.int32Value();
+      }
+      else
+        continue;
+
+      m_fields.push_back( field );
+      ++queued.fieldCount;
     }
-    else if(descStr == FTL_STR("execFixedPortResolvedTypeChanged"))
+  }
+  catch ( FTL::JSONException e )
+  {
+    printf(
+      "NotificationRouter::callback: caught FTL::JSONException: %s\n",
+      e.getDescCStr()
+      );
+    return;
+  }
+
+  if ( !queued.entry )
+  {
+    printf(
+      "NotificationRouter::callback: Unhandled notification:\n%s\n",
+      jsonStr.data()
+      );
+    return;
+  }
+
+  m_queue.push_back( queued );
+}
+
+typedef std::set< std::pair<FTL::StrRef, FTL::StrRef> > SeenMetadata;
+
+static void EraseSeenMetadata(
+  SeenMetadata &seenMetadata,
+  FTL::StrRef nodeName
+  )
+{
+  SeenMetadata::iterator it =
+    seenMetadata.lower_bound( std::make_pair( nodeName, FTL::StrRef() ) );
+  while ( it != seenMetadata.end() && it->first == nodeName )
+    seenMetadata.erase( it++ );
+}
+
+void DFGNotificationRouter::coalesceNotifications()
+{
+  // Walk the batch backwards: everything said about a node that is removed
+  // later in the batch is moot, and only the last value written to a node
+  // metadata key matters. Inserting or renaming a node ends the scope of
+  // its name, since older notifications refer to a different node.
+  typedef std::map<FTL::StrRef, size_t> RemovedNodes;
+  RemovedNodes removedNodes;
+  SeenMetadata seenMetadata;
+
+  for ( size_t i = m_queue.size(); i--; )
+  {
+    QueuedNotification &queued = m_queue[i];
+    HandlerEntry const &entry = *queued.entry;
+    if ( entry.coalesceKind == CoalesceKind_None )
+      continue;
+
+    Notification notif = notification( queued );
+    FTL::StrRef nodeName = notif.getString( entry.nodeKey );
+
+    switch ( entry.coalesceKind )
     {
-      onExecFixedPortResolvedTypeChanged(
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->getStringOrEmpty( FTL_STR("newResolvedType") )
-        );
+      case CoalesceKind_NodeRemoved:
+        removedNodes[nodeName] = i;
+        break;
+
+      case CoalesceKind_NodeInserted:
+      {
+        RemovedNodes::iterator it = removedNodes.find( nodeName );
+        if ( it != removedNodes.end() )
+        {
+          // created and destroyed within the batch
+          queued.dropped = true;
+          m_queue[it->second].dropped = true;
+          removedNodes.erase( it );
+        }
+        EraseSeenMetadata( seenMetadata, nodeName );
+      }
+      break;
+
+      case CoalesceKind_NodeRenamed:
+      {
+        FTL::StrRef oldNodeName = notif.getString( entry.otherKey );
+        removedNodes.erase( nodeName );
+        removedNodes.erase( oldNodeName );
+        EraseSeenMetadata( seenMetadata, nodeName );
+        EraseSeenMetadata( seenMetadata, oldNodeName );
+      }
+      break;
+
+      case CoalesceKind_NodeMetadataChanged:
+        if ( removedNodes.find( nodeName ) != removedNodes.end() )
+          queued.dropped = true;
+        else if ( !seenMetadata.insert(
+          std::make_pair( nodeName, notif.getString( entry.otherKey ) )
+          ).second )
+          queued.dropped = true;
+        break;
+
+      case CoalesceKind_NodeScoped:
+        if ( removedNodes.find( nodeName ) != removedNodes.end() )
+          queued.dropped = true;
+        break;
+
+      default:
+        break;
     }
-    else if(descStr == FTL_STR("execBlockPortResolvedTypeChanged"))
-    {
-      onExecBlockPortResolvedTypeChanged(
-        jsonObject->getString( FTL_STR("blockName") ),
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->getStringOrEmpty( FTL_STR("newResolvedType") )
+  }
+}
+
+void DFGNotificationRouter::flushNotifications()
+{
+  // notifications emitted by the Core while we are applying a batch are
+  // picked up by the loop below
+  if ( m_flushing )
+    return;
+
+  // the notifications can refer to any pin or connection of the graph
+  completeGraphLoad();
+
+  m_flushing = true;
+
+  bool removedFromOwner = false;
+
+  m_dfgController->beginInteraction();
+
+  while ( !m_pendingJSONOffsets.empty() && !removedFromOwner )
+  {
+    m_processingJSON.swap( m_pendingJSON );
+    m_processingJSONOffsets.swap( m_pendingJSONOffsets );
+    m_pendingJSON.clear();
+    m_pendingJSONOffsets.clear();
+
+    m_arena.clear();
+    m_fields.clear();
+    m_queue.clear();
+
+    size_t count = m_processingJSONOffsets.size();
+    for ( size_t i = 0; i < count; ++i )
+    {
+      size_t begin = m_processingJSONOffsets[i];
+      size_t end = i + 1 < count?
+        m_processingJSONOffsets[i + 1]: m_processingJSON.size();
+      preParseNotification(
+        FTL::CStrRef( m_processingJSON.data() + begin, end - begin - 1 ),
+        begin
         );
     }
-    else if(descStr == FTL_STR("instBlockPortResolvedTypeChanged"))
+
+    if ( m_queue.size() > 1 )
+      coalesceNotifications();
+
+    for ( size_t i = 0; i < m_queue.size(); ++i )
     {
-      onInstBlockPortResolvedTypeChanged(
-        jsonObject->getString( FTL_STR("instName") ),
-        jsonObject->getString( FTL_STR("blockName") ),
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->getStringOrEmpty( FTL_STR("newResolvedType") )
-        );
+      QueuedNotification const &queued = m_queue[i];
+      if ( queued.dropped )
+        continue;
+
+      if ( queued.entry->handler != &DFGNotificationRouter::handler_nodeRemoved )
+        flushNodeRemovals();
+
+      // [FE-5435] going up destroys this router, so it must come last
+      if ( queued.entry->handler == &DFGNotificationRouter::handler_removedFromOwner )
+      {
+        removedFromOwner = true;
+        break;
+      }
+
+      noteNodeErrorsMayHaveChanged( queued );
+
+      try
+      {
+        (this->*queued.entry->handler)( notification( queued ) );
+      }
+      catch ( FabricCore::Exception e )
+      {
+        printf(
+          "NotificationRouter::callback: caught Core exception: %s\n",
+          e.getDesc_cstr()
+          );
+      }
+      catch ( FTL::JSONException e )
+      {
+        printf(
+          "NotificationRouter::callback: caught FTL::JSONException: %s\n",
+          e.getDescCStr()
+          );
+      }
     }
-    else if(descStr == FTL_STR("execPortTypeSpecChanged"))
+
+    flushNodeRemovals();
+  }
+
+  m_pendingJSON.clear();
+  m_pendingJSONOffsets.clear();
+  m_expectedNodePosEchoes.clear();
+
+  m_dfgController->endInteraction();
+
+  m_flushing = false;
+
+  if ( removedFromOwner )
+    onRemovedFromOwner();
+}
+
+void DFGNotificationRouter::flushNodeRemovals()
+{
+  if ( m_nodesToRemove.empty() )
+    return;
+
+  if ( GraphView::Graph * uiGraph = m_dfgController->graph() )
+    uiGraph->removeNodes( m_nodesToRemove );
+  m_nodesToRemove.clear();
+}
+
+// the node of a "node.port" or "node.block.port" path, empty for exec ports
+static FTL::StrRef NodeNameOfPath( FTL::StrRef path )
+{
+  FTL::StrRef::Split split = path.split( '.' );
+  return split.second.empty()? FTL::StrRef(): split.first;
+}
+
+void DFGNotificationRouter::noteNodeErrorsMayHaveChanged(
+  QueuedNotification const &queued
+  )
+{
+  HandlerEntry const &entry = *queued.entry;
+  Handler handler = entry.handler;
+
+  if ( handler == &DFGNotificationRouter::handler_portsConnected
+    || handler == &DFGNotificationRouter::handler_portsDisconnected )
+  {
+    Notification notif = notification( queued );
+    m_dfgController->nodeErrorsMayHaveChanged(
+      NodeNameOfPath( notif.getString( FTL_STR("srcPath") ) )
+      );
+    m_dfgController->nodeErrorsMayHaveChanged(
+      NodeNameOfPath( notif.getString( FTL_STR("dstPath") ) )
+      );
+  }
+  // purely cosmetic changes: they don't account for a topoDirty either,
+  // so they must not hide a change made elsewhere in the binding
+  else if ( entry.coalesceKind == CoalesceKind_NodeMetadataChanged
+    || handler == &DFGNotificationRouter::handler_nodePortMetadataChanged
+    || handler == &DFGNotificationRouter::handler_instExecTitleChanged
+    || handler == &DFGNotificationRouter::handler_execMetadataChanged
+    || handler == &DFGNotificationRouter::handler_execPortMetadataChanged
+    || handler == &DFGNotificationRouter::handler_execBlockMetadataChanged
+    || handler == &DFGNotificationRouter::handler_execTitleChanged
+    || handler == &DFGNotificationRouter::handler_ignored )
+    return;
+  else if ( !entry.nodeKey.empty() )
+    m_dfgController->nodeErrorsMayHaveChanged(
+      notification( queued ).getString( entry.nodeKey )
+      );
+  // changes of the exec itself, eg. its ports or extension dependencies
+  else
+    m_dfgController->allNodeErrorsMayHaveChanged();
+}
+
+static void GetNewOrder(
+  FTL::JSONObject const *jsonObject,
+  std::vector<unsigned int> &indices
+  )
+{
+  const FTL::JSONArray * newOrder = jsonObject->maybeGetArray( FTL_STR("newOrder") );
+  if ( newOrder )
+  {
+    indices.reserve( newOrder->size() );
+    for( size_t i = 0; i < newOrder->size(); i++ )
     {
-      onExecPortTypeSpecChanged(
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->getStringOrEmpty( FTL_STR("newTypeSpec") )
-        );
+      const FTL::JSONValue * indexVal = newOrder->get( i );
+      unsigned int index = indexVal->getSInt32Value();
+      indices.push_back( index );
     }
-    else if(descStr == FTL_STR("execBlockPortTypeSpecChanged"))
-    {
-      onExecBlockPortTypeSpecChanged(
-        jsonObject->getString( FTL_STR("blockName") ),
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->getStringOrEmpty( FTL_STR("newTypeSpec") )
-        );
-    }
-    else if(descStr == FTL_STR("nodePortResolvedTypeChanged"))
-    {
-      onNodePortResolvedTypeChanged(
-        jsonObject->getString( FTL_STR("nodeName") ),
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->getStringOrEmpty( FTL_STR("newResolvedType") )
-        );
-    }
-    else if(descStr == FTL_STR("nodePortMetadataChanged"))
-    {
-      onNodePortMetadataChanged(
-        jsonObject->getString( FTL_STR("nodeName") ),
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->getString( FTL_STR("key") ),
-        jsonObject->getString( FTL_STR("value") )
-        );
-    }
-    else if(descStr == FTL_STR("execPortMetadataChanged"))
-    {
-      onExecPortMetadataChanged(
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->getString( FTL_STR("key") ),
-        jsonObject->getString( FTL_STR("value") )
-        );
-    }
-    else if(descStr == FTL_STR("execPortTypeChanged"))
-    {
-      onExecPortTypeChanged(
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->getString( FTL_STR("newExecPortType") )
-        );
-    }
-    else if(descStr == FTL_STR("nodePortTypeChanged"))
-    {
-      onNodePortTypeChanged(
-        jsonObject->getString( FTL_STR("nodeName") ),
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->getString( FTL_STR("newNodePortType") )
-        );
-    }
-    else if(descStr == FTL_STR("execBlockPortOutsidePortTypeChanged"))
-    {
-      onExecBlockPortOutsidePortTypeChanged(
-        jsonObject->getString( FTL_STR("blockName") ),
-        jsonObject->getString( FTL_STR("portName") ),
-        jsonObject->getString( FTL_STR("newOutsidePortType") )
-        );
-    }
-    else if(descStr == FTL_STR("refVarPathChanged"))
-    {
-      onRefVarPathChanged(
-        jsonObject->getString( FTL_STR("refName") ),
-        jsonObject->getString( FTL_STR("newVarPath") )
-        );
-    }
-    else if(descStr == FTL_STR("funcCodeChanged"))
-    {
-      onFuncCodeChanged(
-        jsonObject->getString( FTL_STR("code") )
-        );
-    }
-    else if(descStr == FTL_STR("execTitleChanged"))
-    {
-      onExecTitleChanged(
-        jsonObject->getString( FTL_STR("title") )
-        );
-    }
-    else if(descStr == FTL_STR("extDepsChanged"))
-    {
-      onExecExtDepsChanged(
-        jsonObject->getString( FTL_STR("extDeps") )
-        );
-    }
-    else if( descStr == FTL_STR("execPortDefaultValuesChanged") )
-    {
-      onExecPortDefaultValuesChanged(
-        jsonObject->getString( FTL_STR("portName") )
-        );
-    }
-    else if( descStr == FTL_STR("nodePortDefaultValuesChanged") )
-    {
-      onNodePortDefaultValuesChanged(
-        jsonObject->getString( FTL_STR("nodeName") ),
-        jsonObject->getString( FTL_STR("portName") )
-        );
-    }
-    else if( descStr == FTL_STR("execBlockPortDefaultValuesChanged") )
-    {
-      onExecBlockPortDefaultValuesChanged(
-        jsonObject->getString( FTL_STR("blockName") ),
-        jsonObject->getString( FTL_STR("portName") )
-        );
-    }
-    else if( descStr == FTL_STR("instBlockPortDefaultValuesChanged") )
-    {
-      onInstBlockPortDefaultValuesChanged(
-        jsonObject->getString( FTL_STR("instName") ),
-        jsonObject->getString( FTL_STR("blockName") ),
-        jsonObject->getString( FTL_STR("portName") )
-        );
-    }
-    else if ( descStr == FTL_STR("removedFromOwner") )
-    {
-      onRemovedFromOwner();
-    }
-    else if ( descStr == FTL_STR("execPortsReordered") )
-    {
-      const FTL::JSONArray * newOrder = jsonObject->maybeGetArray( FTL_STR("newOrder") );
-      if ( newOrder )
-      {
-        std::vector<unsigned int> indices;
-        for( size_t i = 0; i < newOrder->size(); i++ )
-        {
-          const FTL::JSONValue * indexVal = newOrder->get( i );
-          unsigned int index = indexVal->getSInt32Value();
-          indices.push_back( index );
-        }
+  }
+}
 
-        if( indices.size() > 0 )
-          onExecPortsReordered( indices.size(), &indices[ 0 ] );
-      }
-    }
-    else if ( descStr == FTL_STR("execFixedPortsReordered") )
-    {
-      const FTL::JSONArray * newOrder = jsonObject->maybeGetArray( FTL_STR("newOrder") );
-      if ( newOrder )
-      {
-        std::vector<unsigned int> indices;
-        for( size_t i = 0; i < newOrder->size(); i++ )
-        {
-          const FTL::JSONValue * indexVal = newOrder->get( i );
-          unsigned int index = indexVal->getSInt32Value();
-          indices.push_back( index );
-        }
+void DFGNotificationRouter::handler_nodeInserted( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  onNodeInserted(
+    notification.getString( FTL_STR("nodeName") ),
+    jsonObject->get( FTL_STR("nodeDesc") )->cast<FTL::JSONObject>()
+    );
+}
+
+void DFGNotificationRouter::handler_nodeRemoved( Notification const &notification )
+{
+  // consecutive removals are applied with a single Graph::removeNodes,
+  // see flushNodeRemovals()
+  GraphView::Graph * uiGraph = m_dfgController->graph();
+  if(!uiGraph)
+    return;
+  GraphView::Node * uiNode =
+    uiGraph->node( notification.getString( FTL_STR("nodeName") ) );
+  if(!uiNode)
+    return;
+  m_nodesToRemove.push_back( uiNode );
+}
+
+void DFGNotificationRouter::handler_nodePortInserted( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  onNodePortInserted(
+    notification.getString( FTL_STR("nodeName") ),
+    notification.getString( FTL_STR("portName") ),
+    jsonObject->get( FTL_STR("portDesc") )->cast<FTL::JSONObject>()
+    );
+}
+
+void DFGNotificationRouter::handler_nodePortRemoved( Notification const &notification )
+{
+  onNodePortRemoved(
+    notification.getString( FTL_STR("nodeName") ),
+    notification.getString( FTL_STR("portName") )
+    );
+}
+
+void DFGNotificationRouter::handler_execPortInserted( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  onExecPortInserted(
+    notification.getSInt32( FTL_STR( "portIndex" ) ),
+    notification.getString( FTL_STR( "portName" ) ),
+    jsonObject->get( FTL_STR("portDesc") )->cast<FTL::JSONObject>()
+    );
+}
+
+void DFGNotificationRouter::handler_execFixedPortInserted( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  onExecFixedPortInserted(
+    notification.getSInt32( FTL_STR( "portIndex" ) ),
+    notification.getString( FTL_STR( "portName" ) ),
+    jsonObject->get( FTL_STR("portDesc") )->cast<FTL::JSONObject>()
+    );
+}
+
+void DFGNotificationRouter::handler_execPortRemoved( Notification const &notification )
+{
+  onExecPortRemoved(
+    notification.getSInt32( FTL_STR( "portIndex" ) ),
+    notification.getString( FTL_STR( "portName" ) )
+    );
+}
+
+void DFGNotificationRouter::handler_execFixedPortRemoved( Notification const &notification )
+{
+  onExecFixedPortRemoved(
+    notification.getSInt32( FTL_STR( "portIndex" ) ),
+    notification.getString( FTL_STR( "portName" ) )
+    );
+}
+
+void DFGNotificationRouter::handler_portsConnected( Notification const &notification )
+{
+  onPortsConnected(
+    notification.getString( FTL_STR("srcPath") ),
+    notification.getString( FTL_STR("dstPath") )
+    );
+}
+
+void DFGNotificationRouter::handler_portsDisconnected( Notification const &notification )
+{
+  onPortsDisconnected(
+    notification.getString( FTL_STR("srcPath") ),
+    notification.getString( FTL_STR("dstPath") )
+    );
+}
+
+void DFGNotificationRouter::handler_nodeMetadataChanged( Notification const &notification )
+{
+  onNodeMetadataChanged(
+    notification.getString( FTL_STR("nodeName") ),
+    notification.getString( FTL_STR("key") ),
+    notification.getString( FTL_STR("value") )
+    );
+}
+
+void DFGNotificationRouter::handler_execBlockMetadataChanged( Notification const &notification )
+{
+  onExecBlockMetadataChanged(
+    notification.getString( FTL_STR("blockName") ),
+    notification.getString( FTL_STR("key") ),
+    notification.getString( FTL_STR("value") )
+    );
+}
+
+void DFGNotificationRouter::handler_instExecTitleChanged( Notification const &notification )
+{
+  onNodeTitleChanged(
+    notification.getString( FTL_STR("instName") ),
+    notification.getString( FTL_STR("execTitle") )
+    );
+}
+
+void DFGNotificationRouter::handler_nodeRenamed( Notification const &notification )
+{
+  onNodeRenamed(
+    notification.getString( FTL_STR("oldNodeName") ),
+    notification.getString( FTL_STR("nodeName") )
+    );
+}
+
+void DFGNotificationRouter::handler_execBlockRenamed( Notification const &notification )
+{
+  onNodeRenamed(
+    notification.getString( FTL_STR("oldBlockName") ),
+    notification.getString( FTL_STR("blockName") )
+    );
+}
+
+void DFGNotificationRouter::handler_instBlockRenamed( Notification const &notification )
+{
+  onInstBlockRenamed(
+    notification.getSInt32( FTL_STR("instIndex") ),
+    notification.getString( FTL_STR("instName") ),
+    notification.getSInt32( FTL_STR("blockIndex") ),
+    notification.getString( FTL_STR("oldBlockName") ),
+    notification.getString( FTL_STR("blockName") )
+    );
+}
+
+void DFGNotificationRouter::handler_execPortRenamed( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  onExecPortRenamed(
+    notification.getString( FTL_STR("oldPortName") ),
+    notification.getString( FTL_STR("portName") ),
+    jsonObject->get( FTL_STR("portDesc") )->cast<FTL::JSONObject>()
+    );
+}
+
+void DFGNotificationRouter::handler_execFixedPortRenamed( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  onExecFixedPortRenamed(
+    notification.getString( FTL_STR("oldPortName") ),
+    notification.getString( FTL_STR("portName") ),
+    jsonObject->get( FTL_STR("portDesc") )->cast<FTL::JSONObject>()
+    );
+}
+
+void DFGNotificationRouter::handler_nodePortRenamed( Notification const &notification )
+{
+  onNodePortRenamed(
+    notification.getString( FTL_STR("nodeName") ),
+    notification.getString( FTL_STR("oldPortName") ),
+    notification.getString( FTL_STR("portName") )
+    );
+}
+
+void DFGNotificationRouter::handler_execMetadataChanged( Notification const &notification )
+{
+  onExecMetadataChanged(
+    notification.getString( FTL_STR("key") ),
+    notification.getString( FTL_STR("value") )
+    );
+}
+
+void DFGNotificationRouter::handler_extDepAdded( Notification const &notification )
+{
+  onExtDepAdded(
+    notification.getString( FTL_STR("name") ),
+    notification.getString( FTL_STR("versionRange") )
+    );
+}
+
+void DFGNotificationRouter::handler_extDepRemoved( Notification const &notification )
+{
+  onExtDepRemoved(
+    notification.getString( FTL_STR("name") ),
+    notification.getString( FTL_STR("versionRange") )
+    );
+}
+
+void DFGNotificationRouter::handler_nodeCacheRuleChanged( Notification const &notification )
+{
+  onNodeCacheRuleChanged(
+    notification.getString( FTL_STR("nodeName") ),
+    notification.getString( FTL_STR("cacheRule") )
+    );
+}
+
+void DFGNotificationRouter::handler_execCacheRuleChanged( Notification const &notification )
+{
+  onExecCacheRuleChanged(
+    notification.getString( FTL_STR("cacheRule") )
+    );
+}
+
+void DFGNotificationRouter::handler_execPortResolvedTypeChanged( Notification const &notification )
+{
+  onExecPortResolvedTypeChanged(
+    notification.getString( FTL_STR("portName") ),
+    notification.getString( FTL_STR("newResolvedType") )
+    );
+}
+
+void DFGNotificationRouter::handler_execFixedPortResolvedTypeChanged( Notification const &notification )
+{
+  onExecFixedPortResolvedTypeChanged(
+    notification.getString( FTL_STR("portName") ),
+    notification.getString( FTL_STR("newResolvedType") )
+    );
+}
+
+void DFGNotificationRouter::handler_execBlockPortResolvedTypeChanged( Notification const &notification )
+{
+  onExecBlockPortResolvedTypeChanged(
+    notification.getString( FTL_STR("blockName") ),
+    notification.getString( FTL_STR("portName") ),
+    notification.getString( FTL_STR("newResolvedType") )
+    );
+}
+
+void DFGNotificationRouter::handler_instBlockPortResolvedTypeChanged( Notification const &notification )
+{
+  onInstBlockPortResolvedTypeChanged(
+    notification.getString( FTL_STR("instName") ),
+    notification.getString( FTL_STR("blockName") ),
+    notification.getString( FTL_STR("portName") ),
+    notification.getString( FTL_STR("newResolvedType") )
+    );
+}
+
+void DFGNotificationRouter::handler_execPortTypeSpecChanged( Notification const &notification )
+{
+  onExecPortTypeSpecChanged(
+    notification.getString( FTL_STR("portName") ),
+    notification.getString( FTL_STR("newTypeSpec") )
+    );
+}
+
+void DFGNotificationRouter::handler_execBlockPortTypeSpecChanged( Notification const &notification )
+{
+  onExecBlockPortTypeSpecChanged(
+    notification.getString( FTL_STR("blockName") ),
+    notification.getString( FTL_STR("portName") ),
+    notification.getString( FTL_STR("newTypeSpec") )
+    );
+}
+
+void DFGNotificationRouter::handler_nodePortResolvedTypeChanged( Notification const &notification )
+{
+  onNodePortResolvedTypeChanged(
+    notification.getString( FTL_STR("nodeName") ),
+    notification.getString( FTL_STR("portName") ),
+    notification.getString( FTL_STR("newResolvedType") )
+    );
+}
+
+void DFGNotificationRouter::handler_nodePortMetadataChanged( Notification const &notification )
+{
+  onNodePortMetadataChanged(
+    notification.getString( FTL_STR("nodeName") ),
+    notification.getString( FTL_STR("portName") ),
+    notification.getString( FTL_STR("key") ),
+    notification.getString( FTL_STR("value") )
+    );
+}
+
+void DFGNotificationRouter::handler_execPortMetadataChanged( Notification const &notification )
+{
+  onExecPortMetadataChanged(
+    notification.getString( FTL_STR("portName") ),
+    notification.getString( FTL_STR("key") ),
+    notification.getString( FTL_STR("value") )
+    );
+}
+
+void DFGNotificationRouter::handler_execPortTypeChanged( Notification const &notification )
+{
+  onExecPortTypeChanged(
+    notification.getString( FTL_STR("portName") ),
+    notification.getString( FTL_STR("newExecPortType") )
+    );
+}
+
+void DFGNotificationRouter::handler_nodePortTypeChanged( Notification const &notification )
+{
+  onNodePortTypeChanged(
+    notification.getString( FTL_STR("nodeName") ),
+    notification.getString( FTL_STR("portName") ),
+    notification.getString( FTL_STR("newNodePortType") )
+    );
+}
+
+void DFGNotificationRouter::handler_execBlockPortOutsidePortTypeChanged( Notification const &notification )
+{
+  onExecBlockPortOutsidePortTypeChanged(
+    notification.getString( FTL_STR("blockName") ),
+    notification.getString( FTL_STR("portName") ),
+    notification.getString( FTL_STR("newOutsidePortType") )
+    );
+}
+
+void DFGNotificationRouter::handler_refVarPathChanged( Notification const &notification )
+{
+  onRefVarPathChanged(
+    notification.getString( FTL_STR("refName") ),
+    notification.getString( FTL_STR("newVarPath") )
+    );
+}
+
+void DFGNotificationRouter::handler_funcCodeChanged( Notification const &notification )
+{
+  onFuncCodeChanged(
+    notification.getString( FTL_STR("code") )
+    );
+}
+
+void DFGNotificationRouter::handler_execTitleChanged( Notification const &notification )
+{
+  onExecTitleChanged(
+    notification.getString( FTL_STR("title") )
+    );
+}
+
+void DFGNotificationRouter::handler_extDepsChanged( Notification const &notification )
+{
+  onExecExtDepsChanged(
+    notification.getString( FTL_STR("extDeps") )
+    );
+}
+
+void DFGNotificationRouter::handler_execPortDefaultValuesChanged( Notification const &notification )
+{
+  onExecPortDefaultValuesChanged(
+    notification.getString( FTL_STR("portName") )
+    );
+}
+
+void DFGNotificationRouter::handler_nodePortDefaultValuesChanged( Notification const &notification )
+{
+  onNodePortDefaultValuesChanged(
+    notification.getString( FTL_STR("nodeName") ),
+    notification.getString( FTL_STR("portName") )
+    );
+}
+
+void DFGNotificationRouter::handler_execBlockPortDefaultValuesChanged( Notification const &notification )
+{
+  onExecBlockPortDefaultValuesChanged(
+    notification.getString( FTL_STR("blockName") ),
+    notification.getString( FTL_STR("portName") )
+    );
+}
+
+void DFGNotificationRouter::handler_instBlockPortDefaultValuesChanged( Notification const &notification )
+{
+  onInstBlockPortDefaultValuesChanged(
+    notification.getString( FTL_STR("instName") ),
+    notification.getString( FTL_STR("blockName") ),
+    notification.getString( FTL_STR("portName") )
+    );
+}
+
+void DFGNotificationRouter::handler_removedFromOwner( Notification const &notification )
+{
+  // deferred to the end of the batch by flushNotifications()
+}
+
+void DFGNotificationRouter::handler_execPortsReordered( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  std::vector<unsigned int> indices;
+  GetNewOrder( jsonObject.get(), indices );
+  if( indices.size() > 0 )
+    onExecPortsReordered( indices.size(), &indices[ 0 ] );
+}
+
+void DFGNotificationRouter::handler_execFixedPortsReordered( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  std::vector<unsigned int> indices;
+  GetNewOrder( jsonObject.get(), indices );
+  if( indices.size() > 0 )
+    onExecFixedPortsReordered( indices.size(), &indices[ 0 ] );
+}
+
+void DFGNotificationRouter::handler_execBlockPortsReordered( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  std::vector<unsigned int> indices;
+  GetNewOrder( jsonObject.get(), indices );
+  if( indices.size() > 0 )
+    onExecBlockPortsReordered(
+      notification.getString( FTL_STR("blockName") ),
+      indices.size(), &indices[ 0 ]
+      );
+}
+
+void DFGNotificationRouter::handler_nodePortsReordered( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  std::vector<unsigned int> indices;
+  GetNewOrder( jsonObject.get(), indices );
+  if( indices.size() > 0 )
+    onNodePortsReordered(
+      notification.getString( FTL_STR("nodeName") ),
+      indices.size(), &indices[ 0 ]
+      );
+}
+
+void DFGNotificationRouter::handler_instBlockPortsReordered( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  std::vector<unsigned int> indices;
+  GetNewOrder( jsonObject.get(), indices );
+  if( indices.size() > 0 )
+    onInstBlockPortsReordered(
+      notification.getString( FTL_STR("instName") ),
+      notification.getSInt32( FTL_STR("blockIndex") ),
+      indices.size(), &indices[0]
+      );
+}
+
+void DFGNotificationRouter::handler_instBlockPortRenamed( Notification const &notification )
+{
+  onInstBlockPortRenamed(
+    notification.getString( FTL_STR("instName") ),
+    notification.getSInt32( FTL_STR("blockIndex") ),
+    notification.getSInt32( FTL_STR("portIndex") ),
+    notification.getString( FTL_STR("portName") )
+    );
+}
+
+void DFGNotificationRouter::handler_execDidAttachPreset( Notification const &notification )
+{
+  onExecDidAttachPreset(
+    notification.getString( FTL_STR("presetFilePath") )
+    );
+}
+
+void DFGNotificationRouter::handler_instExecDidAttachPreset( Notification const &notification )
+{
+  onInstExecDidAttachPreset(
+    notification.getString( FTL_STR("nodeName") ),
+    notification.getString( FTL_STR("presetFilePath") )
+    );
+}
+
+void DFGNotificationRouter::handler_execWillDetachPreset( Notification const &notification )
+{
+  onExecWillDetachPreset(
+    notification.getString( FTL_STR("presetFilePath") )
+    );
+}
+
+void DFGNotificationRouter::handler_instExecWillDetachPreset( Notification const &notification )
+{
+  onInstExecWillDetachPreset(
+    notification.getString( FTL_STR("nodeName") ),
+    notification.getString( FTL_STR("presetFilePath") )
+    );
+}
+
+void DFGNotificationRouter::handler_execEditWouldSplitFromPresetMayHaveChanged( Notification const &notification )
+{
+  onExecEditWouldSplitFromPresetMayHaveChanged();
+}
+
+void DFGNotificationRouter::handler_instExecEditWouldSplitFromPresetMayHaveChanged( Notification const &notification )
+{
+  onInstExecEditWouldSplitFromPresetMayHaveChanged(
+    notification.getString( FTL_STR("instName") )
+    );
+}
+
+void DFGNotificationRouter::handler_instBlockExecEditWouldSplitFromPresetMayHaveChanged( Notification const &notification )
+{
+  onInstBlockExecEditWouldSplitFromPresetMayHaveChanged(
+    notification.getString( FTL_STR("instName") ),
+    notification.getString( FTL_STR("blockName") )
+    );
+}
+
+void DFGNotificationRouter::handler_instBlockInserted( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  onInstBlockInserted(
+    notification.getString( FTL_STR("instName") ),
+    notification.getSInt32( FTL_STR("blockIndex") ),
+    jsonObject->getObject( FTL_STR("blockDesc") )
+    );
+}
+
+void DFGNotificationRouter::handler_instBlockPortInserted( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  onInstBlockPortInserted(
+    notification.getString( FTL_STR("instName") ),
+    notification.getSInt32( FTL_STR("blockIndex") ),
+    notification.getSInt32( FTL_STR("portIndex") ),
+    jsonObject->getObject( FTL_STR("portDesc") )
+    );
+}
+
+void DFGNotificationRouter::handler_instBlockPortRemoved( Notification const &notification )
+{
+  onInstBlockPortRemoved(
+    notification.getString( FTL_STR("instName") ),
+    notification.getSInt32( FTL_STR("blockIndex") ),
+    notification.getSInt32( FTL_STR("portIndex") )
+    );
+}
+
+void DFGNotificationRouter::handler_instBlockRemoved( Notification const &notification )
+{
+  onInstBlockRemoved(
+    notification.getString( FTL_STR("instName") ),
+    notification.getSInt32( FTL_STR("blockIndex") ),
+    notification.getString( FTL_STR("blockName") )
+    );
+}
+
+void DFGNotificationRouter::handler_execBlockInserted( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  onExecBlockInserted(
+    notification.getSInt32( FTL_STR("blockIndex") ),
+    jsonObject->getObject( FTL_STR("blockDesc") )
+    );
+}
+
+void DFGNotificationRouter::handler_execBlockPortInserted( Notification const &notification )
+{
+  FTL::OwnedPtr<FTL::JSONObject const> jsonObject( notification.decodeJSONObject() );
+  onExecBlockPortInserted(
+    notification.getSInt32( FTL_STR("blockIndex") ),
+    notification.getString( FTL_STR("blockName") ),
+    notification.getSInt32( FTL_STR("portIndex") ),
+    jsonObject->getObject( FTL_STR("portDesc") )
+    );
+}
 
-        if( indices.size() > 0 )
-          onExecFixedPortsReordered( indices.size(), &indices[ 0 ] );
-      }
-    }
-    else if ( descStr == FTL_STR("execBlockPortsReordered") )
-    {
-      const FTL::JSONArray * newOrder = jsonObject->maybeGetArray( FTL_STR("newOrder") );
-      if ( newOrder )
-      {
-        std::vector<unsigned int> indices;
-        for( size_t i = 0; i < newOrder->size(); i++ )
-        {
-          const FTL::JSONValue * indexVal = newOrder->get( i );
-          unsigned int index = indexVal->getSInt32Value();
-          indices.push_back( index );
-        }
+void DFGNotificationRouter::handler_execBlockPortRenamed( Notification const &notification )
+{
+  onExecBlockPortRenamed(
+    notification.getSInt32( FTL_STR("blockIndex") ),
+    notification.getString( FTL_STR("blockName") ),
+    notification.getSInt32( FTL_STR("portIndex") ),
+    notification.getString( FTL_STR("oldPortName") ),
+    notification.getString( FTL_STR("portName") )
+    );
+}
 
-        if( indices.size() > 0 )
-        {
-          FTL::CStrRef blockName = jsonObject->getString( FTL_STR("blockName") );
-          onExecBlockPortsReordered(
-            blockName,
-            indices.size(), &indices[ 0 ]
-            );
-        }
-      }
-    }
-    else if (descStr == FTL_STR("nodePortsReordered") )
-    {
-      FTL::CStrRef nodeName = jsonObject->getString( FTL_STR("nodeName") );
-      const FTL::JSONArray * newOrder = jsonObject->maybeGetArray( FTL_STR("newOrder") );
-      if ( newOrder )
-      {
-        std::vector<unsigned int> indices;
-        for( size_t i = 0; i < newOrder->size(); i++ )
-        {
-          const FTL::JSONValue * indexVal = newOrder->get( i );
-          unsigned int index = indexVal->getSInt32Value();
-          indices.push_back( index );
-        }
+void DFGNotificationRouter::handler_execBlockPortRemoved( Notification const &notification )
+{
+  onExecBlockPortRemoved(
+    notification.getSInt32( FTL_STR("blockIndex") ),
+    notification.getString( FTL_STR("blockName") ),
+    notification.getSInt32( FTL_STR("portIndex") ),
+    notification.getString( FTL_STR("portName") )
+    );
+}
 
-        if( indices.size() > 0 )
-          onNodePortsReordered( nodeName, indices.size(), &indices[ 0 ] );
-      }
-    }
-    else if (descStr == FTL_STR("instBlockPortsReordered") )
-    {
-      FTL::CStrRef instName = jsonObject->getString( FTL_STR("instName") );
-      int blockIndex = jsonObject->getSInt32( FTL_STR("blockIndex") );
-      const FTL::JSONArray * newOrder = jsonObject->maybeGetArray( FTL_STR("newOrder") );
-      if ( newOrder )
-      {
-        std::vector<unsigned int> indices;
-        for( size_t i = 0; i < newOrder->size(); i++ )
-        {
-          const FTL::JSONValue * indexVal = newOrder->get( i );
-          unsigned int index = indexVal->getSInt32Value();
-          indices.push_back( index );
-        }
+void DFGNotificationRouter::handler_execBlockRemoved( Notification const &notification )
+{
+  onExecBlockRemoved(
+    notification.getSInt32( FTL_STR("blockIndex") ),
+    notification.getString( FTL_STR("blockName") )
+    );
+}
 
-        if( indices.size() > 0 )
-          onInstBlockPortsReordered(
-            instName, blockIndex, indices.size(), &indices[0]
-            );
-      }
-    }
-    else if (descStr == FTL_STR("instBlockPortRenamed") )
-    {
-      FTL::CStrRef instName = jsonObject->getString( FTL_STR("instName") );
-      int blockIndex = jsonObject->getSInt32( FTL_STR("blockIndex") );
-      int portIndex = jsonObject->getSInt32( FTL_STR("portIndex") );
-      FTL::CStrRef newPortName = jsonObject->getString( FTL_STR("portName") );
-      onInstBlockPortRenamed( instName, blockIndex, portIndex, newPortName );
-    }
-    else if (descStr == FTL_STR("execDidAttachPreset") )
-    {
-      FTL::CStrRef presetFilePath = jsonObject->getString( FTL_STR("presetFilePath") );
-      onExecDidAttachPreset( presetFilePath );
-    }
-    else if (descStr == FTL_STR("instExecDidAttachPreset") )
-    {
-      FTL::CStrRef nodeName = jsonObject->getString( FTL_STR("nodeName") );
-      FTL::CStrRef presetFilePath = jsonObject->getString( FTL_STR("presetFilePath") );
-      onInstExecDidAttachPreset( nodeName, presetFilePath );
-    }
-    else if (descStr == FTL_STR("execWillDetachPreset") )
-    {
-      FTL::CStrRef presetFilePath = jsonObject->getString( FTL_STR("presetFilePath") );
-      onExecWillDetachPreset( presetFilePath );
-    }
-    else if (descStr == FTL_STR("instExecWillDetachPreset") )
-    {
-      FTL::CStrRef nodeName = jsonObject->getString( FTL_STR("nodeName") );
-      FTL::CStrRef presetFilePath = jsonObject->getString( FTL_STR("presetFilePath") );
-      onInstExecWillDetachPreset( nodeName, presetFilePath );
-    }
-    else if (descStr == FTL_STR("execEditWouldSplitFromPresetMayHaveChanged") )
-    {
-      onExecEditWouldSplitFromPresetMayHaveChanged();
-    }
-    else if (descStr == FTL_STR("instExecEditWouldSplitFromPresetMayHaveChanged") )
-    {
-      FTL::CStrRef instName = jsonObject->getString( FTL_STR("instName") );
-      onInstExecEditWouldSplitFromPresetMayHaveChanged( instName );
-    }
-    else if (descStr == FTL_STR("instBlockExecEditWouldSplitFromPresetMayHaveChanged") )
-    {
-      FTL::CStrRef instName = jsonObject->getString( FTL_STR("instName") );
-      FTL::CStrRef blockName = jsonObject->getString( FTL_STR("blockName") );
-      onInstBlockExecEditWouldSplitFromPresetMayHaveChanged( instName, blockName );
-    }
-    else if( descStr == FTL_STR("instBlockInserted") )
-    {
-      onInstBlockInserted(
-        jsonObject->getString( FTL_STR("instName") ),
-        jsonObject->getSInt32( FTL_STR("blockIndex") ),
-        jsonObject->getObject( FTL_STR("blockDesc") )
-        );
-    }
-    else if( descStr == FTL_STR("instBlockPortInserted") )
-    {
-      onInstBlockPortInserted(
-        jsonObject->getString( FTL_STR("instName") ),
-        jsonObject->getSInt32( FTL_STR("blockIndex") ),
-        jsonObject->getSInt32( FTL_STR("portIndex") ),
-        jsonObject->getObject( FTL_STR("portDesc") )
-        );
-    }
-    else if( descStr == FTL_STR("instBlockPortRemoved") )
-    {
-      onInstBlockPortRemoved(
-        jsonObject->getString( FTL_STR("instName") ),
-        jsonObject->getSInt32( FTL_STR("blockIndex") ),
-        jsonObject->getSInt32( FTL_STR("portIndex") )
-        );
-    }
-    else if( descStr == FTL_STR("instBlockRemoved") )
-    {
-      onInstBlockRemoved(
-        jsonObject->getString( FTL_STR("instName") ),
-        jsonObject->getSInt32( FTL_STR("blockIndex") ),
-        jsonObject->getString( FTL_STR("blockName") )
-        );
-    }
-    else if( descStr == FTL_STR("execBlockInserted") )
-    {
-      onExecBlockInserted(
-        jsonObject->getSInt32( FTL_STR("blockIndex") ),
-        jsonObject->getObject( FTL_STR("blockDesc") )
-        );
-    }
-    else if( descStr == FTL_STR("execBlockPortInserted") )
-    {
-      onExecBlockPortInserted(
-        jsonObject->getSInt32( FTL_STR("blockIndex") ),
-        jsonObject->getString( FTL_STR("blockName") ),
-        jsonObject->getSInt32( FTL_STR("portIndex") ),
-        jsonObject->getObject( FTL_STR("portDesc") )
-        );
-    }
-    else if( descStr == FTL_STR("execBlockPortRenamed") )
-    {
-      onExecBlockPortRenamed(
-        jsonObject->getSInt32( FTL_STR("blockIndex") ),
-        jsonObject->getString( FTL_STR("blockName") ),
-        jsonObject->getSInt32( FTL_STR("portIndex") ),
-        jsonObject->getString( FTL_STR("oldPortName") ),
-        jsonObject->getString( FTL_STR("portName") )
-        );
-    }
-    else if( descStr == FTL_STR("execBlockPortRemoved") )
-    {
-      onExecBlockPortRemoved(
-        jsonObject->getSInt32( FTL_STR("blockIndex") ),
-        jsonObject->getString( FTL_STR("blockName") ),
-        jsonObject->getSInt32( FTL_STR("portIndex") ),
-        jsonObject->getString( FTL_STR("portName") )
-        );
-    }
-    else if( descStr == FTL_STR("execBlockRemoved") )
-    {
-      onExecBlockRemoved(
-        jsonObject->getSInt32( FTL_STR("blockIndex") ),
-        jsonObject->getString( FTL_STR("blockName") )
-        );
-    }
-    else if( descStr == FTL_STR("nlsPortInserted") )
-    {
-      // TODO
-    }
-    else if( descStr == FTL_STR("nlsPortMetadataChanged") )
-    {
-      // TODO
-    }
-    else if( descStr == FTL_STR("nlsPortRemoved") )
-    {
-      // TODO
-    }
-    else if( descStr == FTL_STR("nlsPortRenamed") )
-    {
-      // TODO
-    }
-    else if( descStr == FTL_STR("nlsPortResolvedTypeChanged") )
-    {
-      // TODO
-    }
-    else if( descStr == FTL_STR("nlsPortTypeSpecChanged") )
-    {
-      // TODO
-    }
-    else if( descStr == FTL_STR("nlsPortsReordered") )
-    {
-      // TODO
-    }
-    else
-    {
-      printf(
-        "NotificationRouter::callback: Unhandled notification:\n%s\n",
-        jsonStr.data()
-        );
-    }
-  }
-  catch ( FabricCore::Exception e )
-  {
-    printf(
-      "NotificationRouter::callback: caught Core exception: %s\n",
-      e.getDesc_cstr()
-      );
-  }
-  catch ( FTL::JSONException e )
-  {
-    printf(
-      "NotificationRouter::callback: caught FTL::JSONException: %s\n",
-      e.getDescCStr()
-      );
-  }
+void DFGNotificationRouter::handler_ignored( Notification const &notification )
+{
 }
 
 void DFGNotificationRouter::onGraphSet()
@@ -660,19 +1226,23 @@ void DFGNotificationRouter::onGraphSet()
   if ( !exec )
     return;
 
+  clearPendingNodes();
+  m_pendingGraph = m_dfgController->graph();
+
   FabricCore::DFGStringResult desc = exec.getDesc();
   char const *descData;
   uint32_t descSize;
   desc.getStringDataAndLength( descData, descSize );
 
-  FTL::JSONStrWithLoc jsonSrcWithLoc( FTL::StrRef( descData, descSize ) );
-  FTL::OwnedPtr<FTL::JSONValue const> rootValue(
-    FTL::JSONValue::Decode( jsonSrcWithLoc )
-    );
+  // kept along with the decoded desc in case some nodes are only
+  // populated later on
+  m_pendingDescJSON.assign( descData, descSize );
+  FTL::JSONStrWithLoc jsonSrcWithLoc( m_pendingDescJSON );
+  m_pendingDesc = FTL::JSONValue::Decode( jsonSrcWithLoc );
 
   try
   {
-    FTL::JSONObject const *rootObject = rootValue->cast<FTL::JSONObject>();
+    FTL::JSONObject const *rootObject = m_pendingDesc->cast<FTL::JSONObject>();
 
     if ( FTL::JSONArray const *fixedPortsArray =
       rootObject->maybeGet( FTL_STR("fixedPorts") )->castOrNull<FTL::JSONArray>() )
@@ -717,14 +1287,25 @@ void DFGNotificationRouter::onGraphSet()
     {
       FTL::JSONArray const *nodesArray =
         rootObject->get( FTL_STR("nodes") )->cast<FTL::JSONArray>();
+
+      // Large graphs are loaded in two phases: the nodes are first created
+      // as placeholders (title, colors and position only) so that the
+      // graph can be drawn right away, then their pins, blocks and
+      // connections are built in idle time, starting with the ones in
+      // view (see loadPendingNodes)
+      bool progressive =
+        nodesArray->size() >= m_config.progressiveLoadMinNodeCount;
+
       for ( size_t i = 0; i < nodesArray->size(); ++i )
       {
         FTL::JSONObject const *nodeObject =
           nodesArray->get( i )->cast<FTL::JSONObject>();
-        onNodeInserted(
-          nodeObject->getString( FTL_STR("name") ),
-          nodeObject
-          );
+        FTL::CStrRef nodeName = nodeObject->getString( FTL_STR("name") );
+        if ( !progressive
+          || exec.getNodeType( nodeName.c_str() ) == FabricCore::DFGNodeType_User )
+          onNodeInserted( nodeName, nodeObject ); // backdrops have no pins
+        else if ( insertNodePlaceholder( nodeName, nodeObject ) )
+          m_pendingNodes[nodeName.c_str()] = nodeObject;
       }
 
       FTL::JSONObject const *connectionsObject =
@@ -739,7 +1320,12 @@ void DFGNotificationRouter::onGraphSet()
         {
           FTL::JSONValue const *dstValue = *it;
           FTL::CStrRef dstPath = dstValue->getStringValue();
-          onPortsConnected( srcPath, dstPath );
+          if ( isPendingPath( srcPath ) || isPendingPath( dstPath ) )
+            m_pendingConnections.push_back(
+              std::make_pair( srcPath.c_str(), dstPath.c_str() )
+              );
+          else
+            onPortsConnected( srcPath, dstPath );
         }
       }
     }
@@ -760,9 +1346,196 @@ void DFGNotificationRouter::onGraphSet()
     }
   }
   catch ( FTL::JSONException je )
+  {
+    printf( "Caught JSONException: %s\n", je.getDescCStr() );
+    m_pendingNodes.clear();
+    m_pendingConnections.clear();
+  }
+
+  if ( m_pendingNodes.empty() )
+  {
+    clearPendingNodes();
+    return;
+  }
+
+  QObject::connect(
+    m_pendingGraph, SIGNAL( nodeSelected( FabricUI::GraphView::Node * ) ),
+    this, SLOT( completeNodeLoad( FabricUI::GraphView::Node * ) )
+    );
+  postLoadPendingNodes();
+}
+
+void DFGNotificationRouter::completeGraphLoad()
+{
+  if ( m_pendingNodes.empty() || !m_active )
+    return;
+
+  if ( m_dfgController->graph() == m_pendingGraph )
+  {
+    while ( !m_pendingNodes.empty() )
+      loadPendingNode( m_pendingNodes.begin()->first );
+    loadPendingConnections();
+  }
+
+  clearPendingNodes();
+}
+
+void DFGNotificationRouter::postLoadPendingNodes()
+{
+  if ( m_pendingLoadPosted )
+    return;
+  m_pendingLoadPosted = true;
+  QMetaObject::invokeMethod( this, "loadPendingNodes", Qt::QueuedConnection );
+}
+
+void DFGNotificationRouter::loadPendingNodes()
+{
+  m_pendingLoadPosted = false;
+  if ( m_pendingNodes.empty() || !m_active )
+    return;
+
+  GraphView::Graph *uiGraph = m_dfgController->graph();
+  if ( !uiGraph || uiGraph != m_pendingGraph )
+  {
+    clearPendingNodes();
+    return;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  qint64 sliceMs = m_config.progressiveLoadSliceMs;
+
+  // the nodes in view first, as they might have been panned to
+  if ( GraphView::MainPanel *uiMainPanel = uiGraph->mainPanel() )
+  {
+    std::vector<GraphView::Node *> uiNodes =
+      uiGraph->nodesInRect( uiMainPanel->visibleGraphRect() );
+    for ( size_t i = 0; i < uiNodes.size() && timer.elapsed() < sliceMs; ++i )
+    {
+      std::string nodeName = uiNodes[i]->name().c_str();
+      if ( m_pendingNodes.find( nodeName ) != m_pendingNodes.end() )
+        loadPendingNode( nodeName );
+    }
+  }
+
+  while ( !m_pendingNodes.empty() && timer.elapsed() < sliceMs )
+    loadPendingNode( m_pendingNodes.begin()->first );
+
+  loadPendingConnections();
+
+  if ( m_pendingNodes.empty() )
+    clearPendingNodes();
+  else
+    postLoadPendingNodes();
+}
+
+void DFGNotificationRouter::completeNodeLoad(
+  FabricUI::GraphView::Node *uiNode
+  )
+{
+  if ( !m_active )
+    return;
+
+  std::string nodeName = uiNode->name().c_str();
+  if ( m_pendingNodes.find( nodeName ) == m_pendingNodes.end() )
+    return;
+
+  loadPendingNode( nodeName );
+
+  // its pins must show all its connections: build the pending
+  // nodes at the other end of the ones that are still pending
+  std::vector<std::string> neighbourNames;
+  for ( size_t i = 0; i < m_pendingConnections.size(); ++i )
+  {
+    std::pair<std::string, std::string> const &connection =
+      m_pendingConnections[i];
+    FTL::StrRef srcRef = NodeNameOfPath( connection.first );
+    FTL::StrRef dstRef = NodeNameOfPath( connection.second );
+    std::string srcNodeName( srcRef.data(), srcRef.size() );
+    std::string dstNodeName( dstRef.data(), dstRef.size() );
+    if ( srcNodeName == nodeName )
+      neighbourNames.push_back( dstNodeName );
+    else if ( dstNodeName == nodeName )
+      neighbourNames.push_back( srcNodeName );
+  }
+  for ( size_t i = 0; i < neighbourNames.size(); ++i )
+    loadPendingNode( neighbourNames[i] );
+
+  loadPendingConnections();
+}
+
+void DFGNotificationRouter::loadPendingNode( std::string const &nodeName )
+{
+  std::map<std::string, FTL::JSONObject const *>::iterator it =
+    m_pendingNodes.find( nodeName );
+  if ( it == m_pendingNodes.end() )
+    return;
+
+  // copied since the entry goes away
+  std::string name = it->first;
+  FTL::JSONObject const *nodeObject = it->second;
+  m_pendingNodes.erase( it );
+
+  try
+  {
+    populateNode( name, nodeObject );
+  }
+  catch ( FTL::JSONException je )
   {
     printf( "Caught JSONException: %s\n", je.getDescCStr() );
   }
+  catch ( FabricCore::Exception e )
+  {
+    printf( "%s\n", e.getDesc_cstr() );
+  }
+}
+
+void DFGNotificationRouter::loadPendingConnections()
+{
+  size_t count = 0;
+  for ( size_t i = 0; i < m_pendingConnections.size(); ++i )
+  {
+    std::pair<std::string, std::string> const &connection =
+      m_pendingConnections[i];
+    if ( isPendingPath( connection.first )
+      || isPendingPath( connection.second ) )
+    {
+      if ( count != i )
+        m_pendingConnections[count] = connection;
+      ++count;
+    }
+    else onPortsConnected( connection.first, connection.second );
+  }
+  m_pendingConnections.resize( count );
+}
+
+bool DFGNotificationRouter::isPendingPath( FTL::CStrRef path ) const
+{
+  if ( m_pendingNodes.empty() )
+    return false;
+
+  // exec ports have no node name
+  std::pair<FTL::StrRef, FTL::CStrRef> split = path.split('.');
+  if ( split.second.empty() )
+    return false;
+  return m_pendingNodes.find(
+    std::string( split.first.data(), split.first.size() )
+    ) != m_pendingNodes.end();
+}
+
+void DFGNotificationRouter::clearPendingNodes()
+{
+  if ( m_pendingGraph )
+    QObject::disconnect(
+      m_pendingGraph, SIGNAL( nodeSelected( FabricUI::GraphView::Node * ) ),
+      this, SLOT( completeNodeLoad( FabricUI::GraphView::Node * ) )
+      );
+  m_pendingGraph = NULL;
+  m_pendingNodes.clear();
+  m_pendingConnections.clear();
+  delete m_pendingDesc;
+  m_pendingDesc = NULL;
+  m_pendingDescJSON.clear();
 }
 
 void DFGNotificationRouter::onNotification(FTL::CStrRef json)
@@ -773,14 +1546,23 @@ void DFGNotificationRouter::onNodeInserted(
   FTL::CStrRef nodeName,
   FTL::JSONObject const *jsonObject
   )
+{
+  if ( insertNodePlaceholder( nodeName, jsonObject ) )
+    populateNode( nodeName, jsonObject );
+}
+
+GraphView::Node *DFGNotificationRouter::insertNodePlaceholder(
+  FTL::CStrRef nodeName,
+  FTL::JSONObject const *jsonObject
+  )
 {
   FabricCore::DFGExec &exec = m_dfgController->getExec();
   if ( !exec )
-    return;
+    return NULL;
 
   GraphView::Graph * uiGraph = m_dfgController->graph();
   if(!uiGraph)
-    return;
+    return NULL;
 
   FabricCore::DFGNodeType nodeType = exec.getNodeType( nodeName.c_str() );
   GraphView::Node * uiNode;
@@ -791,7 +1573,7 @@ void DFGNotificationRouter::onNodeInserted(
   else
     uiNode = uiGraph->addPlainNode( nodeName, FTL::CStrRef() );
   if(!uiNode)
-    return;
+    return NULL;
 
   if(nodeType == FabricCore::DFGNodeType_Var ||
     nodeType == FabricCore::DFGNodeType_Get ||
@@ -814,7 +1596,46 @@ void DFGNotificationRouter::onNodeInserted(
       uiNode->setTitle( nodeName );
       uiNode->setTitleSuffixAsterisk();
     }
+  }
+  else if(nodeType == FabricCore::DFGNodeType_Var)
+  {
+    FTL::CStrRef name;
+    if ( jsonObject->maybeGetString( FTL_STR("name"), name ) )
+      uiNode->setTitle( name );
+  }
+  else if(nodeType == FabricCore::DFGNodeType_Get || nodeType == FabricCore::DFGNodeType_Set)
+  {
+    FTL::CStrRef varPath = exec.getRefVarPath( nodeName.c_str() );
+    onRefVarPathChanged(nodeName, varPath);
+  }
+
+  if ( FTL::JSONObject const *metadataJSONObject =
+    jsonObject->maybeGetObject( FTL_STR("metadata") ) )
+  {
+    FTL::CStrRef uiGraphPos;
+    if ( metadataJSONObject->maybeGetString( FTL_STR("uiGraphPos"), uiGraphPos ) )
+      onNodeMetadataChanged( nodeName, FTL_STR("uiGraphPos"), uiGraphPos );
+  }
+
+  return uiNode;
+}
+
+void DFGNotificationRouter::populateNode(
+  FTL::CStrRef nodeName,
+  FTL::JSONObject const *jsonObject
+  )
+{
+  FabricCore::DFGExec &exec = m_dfgController->getExec();
+  if ( !exec )
+    return;
+
+  GraphView::Graph * uiGraph = m_dfgController->graph();
+  if(!uiGraph)
+    return;
 
+  FabricCore::DFGNodeType nodeType = exec.getNodeType( nodeName.c_str() );
+  if(nodeType == FabricCore::DFGNodeType_Inst)
+  {
     if ( FTL::JSONArray const *blocksArray =
       jsonObject->maybeGet( FTL_STR("blocks") )->castOrNull<FTL::JSONArray>() )
     {
@@ -830,19 +1651,11 @@ void DFGNotificationRouter::onNodeInserted(
       }
     }
 
-    FabricCore::DFGExec subExec = exec.getSubExec( nodeName.c_str() );
-    uiNode->setCanEdit( !subExec.editWouldSplitFromPreset() );
-  }
-  else if(nodeType == FabricCore::DFGNodeType_Var)
-  {
-    FTL::CStrRef name;
-    if ( jsonObject->maybeGetString( FTL_STR("name"), name ) )
-      uiNode->setTitle( name );
-  }
-  else if(nodeType == FabricCore::DFGNodeType_Get || nodeType == FabricCore::DFGNodeType_Set)
-  {
-    FTL::CStrRef varPath = exec.getRefVarPath( nodeName.c_str() );
-    onRefVarPathChanged(nodeName, varPath);
+    if ( GraphView::Node *uiNode = uiGraph->node( nodeName ) )
+    {
+      FabricCore::DFGExec subExec = exec.getSubExec( nodeName.c_str() );
+      uiNode->setCanEdit( !subExec.editWouldSplitFromPreset() );
+    }
   }
 
   FTL::JSONArray const *portsJSONArray =
@@ -907,6 +1720,8 @@ void DFGNotificationRouter::onNodeInserted(
       it != metadataJSONObject->end(); ++it )
     {
       FTL::CStrRef key = it->key();
+      if ( key == FTL_STR("uiGraphPos") )
+        continue; // already set by insertNodePlaceholder
       FTL::CStrRef value = it->value()->cast<FTL::JSONString>()->getValue();
       onNodeMetadataChanged(nodeName, key, value);
     }
@@ -1566,6 +2381,18 @@ void DFGNotificationRouter::onNodeMetadataChanged(
 
   if(key == FTL_STR("uiGraphPos"))
   {
+    std::map<std::string, std::string>::iterator it =
+      m_expectedNodePosEchoes.find(
+        std::string( nodeName.data(), nodeName.size() )
+        );
+    if ( it != m_expectedNodePosEchoes.end() )
+    {
+      bool isEcho = FTL::StrRef( it->second ) == value;
+      m_expectedNodePosEchoes.erase( it );
+      if ( isEcho )
+        return;
+    }
+
     FTL::JSONStrWithLoc jsonStrWithLoc( value );
     FTL::OwnedPtr<FTL::JSONValue const> jsonValue(
       FTL::JSONValue::Decode( jsonStrWithLoc )
@@ -3,12 +3,20 @@
 #ifndef __UI_DFG_DFGNotificationRouter__
 #define __UI_DFG_DFGNotificationRouter__
 
+#include <map>
 #include <string>
+#include <vector>
 #include <FabricCore.h>
 #include <FTL/CStrRef.h>
 #include <FTL/JSONValue.h>
+#if defined(FTL_PLATFORM_WINDOWS)
+# include <unordered_map>
+#else
+# include <tr1/unordered_map>
+#endif
 #include <FabricUI/DFG/DFGConfig.h>
 #include <FabricUI/GraphView/Node.h>
+#include <QPointer>
 
 namespace FabricUI
 {
@@ -31,12 +39,75 @@ namespace FabricUI
         DFGController *dfgController,
         const DFGConfig & config = DFGConfig()
         );
-      virtual ~DFGNotificationRouter() {}
+      virtual ~DFGNotificationRouter();
+
+      // While at least one batch is open, the notifications coming from
+      // the Core are only queued; they are coalesced and applied to the
+      // GraphView in a single interaction when the outermost batch closes.
+      class Batch
+      {
+      public:
+
+        Batch( DFGNotificationRouter *router )
+          : m_router( router )
+        {
+          if ( m_router )
+            m_router->beginBatch();
+        }
+
+        ~Batch()
+        {
+          if ( m_router )
+            m_router->endBatch();
+        }
+
+      private:
+
+        DFGNotificationRouter *m_router;
+      };
+
+      void beginBatch();
+      void endBatch();
+
+      // Used when the UI node has already been moved by whoever writes its
+      // uiGraphPos metadata (see DFGController::gvcDoMoveNodes): the
+      // notification carrying that exact value is then dropped rather than
+      // decoded and applied again. The expectations only last until the
+      // current batch is flushed.
+      void expectNodePosEcho(
+        FTL::StrRef nodeName,
+        std::string const &uiGraphPos
+        );
+
+      // An inactive router keeps the graph it built while that graph is not
+      // displayed (see DFGWidget::onExecChanged): the notifications of its
+      // exec are only queued, and are applied when it is activated again.
+      // If the exec is removed, or if too much is queued, the router
+      // becomes stale and its graph must be rebuilt instead.
+      void setActive( bool active );
+      bool isActive() const
+        { return m_active; }
+      bool isStale() const
+        { return m_stale; }
+
+      // Builds right away the content of the nodes that onGraphSet left
+      // as placeholders. Must be called before relying on the pins or
+      // the connections of the whole graph.
+      void completeGraphLoad();
 
     public slots:
 
       void onExecChanged();
 
+      // Same as completeGraphLoad, for a single node, the nodes it is
+      // connected to and their connections to it. Also called when a
+      // node is selected.
+      void completeNodeLoad( FabricUI::GraphView::Node *uiNode );
+
+    private slots:
+
+      void loadPendingNodes();
+
     protected:
 
       void onGraphSet();
@@ -45,6 +116,16 @@ namespace FabricUI
         FTL::CStrRef nodeName,
         FTL::JSONObject const *jsonObject
         );
+      // The two halves of onNodeInserted: the node itself, with its title,
+      // colors and position, then its pins, blocks and other metadata
+      GraphView::Node *insertNodePlaceholder(
+        FTL::CStrRef nodeName,
+        FTL::JSONObject const *jsonObject
+        );
+      void populateNode(
+        FTL::CStrRef nodeName,
+        FTL::JSONObject const *jsonObject
+        );
       void onNodeRemoved(
         FTL::CStrRef nodeName
         );
@@ -333,6 +414,174 @@ namespace FabricUI
 
     private:
 
+      // A top-level member of a queued notification, pre-parsed by the
+      // streaming decoder. Strings are stored '\0'-terminated in the
+      // router's string arena so they can be handed out as FTL::CStrRef.
+      struct Field
+      {
+        size_t keyOffset;
+        size_t keyLength;
+        size_t valueOffset;
+        size_t valueLength;
+        int32_t intValue;
+      };
+
+      // Read-only view on a pre-parsed notification. Nested objects and
+      // arrays are not pre-parsed; handlers that need them decode the
+      // original JSON on demand.
+      class Notification
+      {
+        friend class DFGNotificationRouter;
+
+      public:
+
+        FTL::CStrRef json() const
+          { return m_json; }
+
+        FTL::CStrRef getString( FTL::StrRef key ) const;
+        int32_t getSInt32( FTL::StrRef key ) const;
+
+        FTL::JSONObject const *decodeJSONObject() const;
+
+      private:
+
+        Field const *findField( FTL::StrRef key ) const;
+
+        char const *m_arena;
+        Field const *m_fields;
+        size_t m_fieldCount;
+        FTL::CStrRef m_json;
+      };
+
+      typedef void (DFGNotificationRouter::*Handler)(
+        Notification const &notification
+        );
+
+      // How a notification takes part in the coalescing of a batch
+      enum CoalesceKind
+      {
+        CoalesceKind_None,
+        CoalesceKind_NodeInserted,
+        CoalesceKind_NodeRemoved,
+        CoalesceKind_NodeRenamed,
+        CoalesceKind_NodeMetadataChanged,
+        CoalesceKind_NodeScoped
+      };
+
+      struct HandlerEntry
+      {
+        Handler handler;
+        CoalesceKind coalesceKind;
+        FTL::StrRef nodeKey;
+        FTL::StrRef otherKey;
+      };
+
+      struct QueuedNotification
+      {
+        HandlerEntry const *entry;
+        size_t jsonOffset;
+        size_t jsonLength;
+        size_t firstField;
+        size_t fieldCount;
+        bool dropped;
+      };
+
+#if defined(FTL_PLATFORM_WINDOWS)
+      typedef std::unordered_map<
+#else
+      typedef std::tr1::unordered_map<
+#endif
+        FTL::StrRef,
+        HandlerEntry,
+        FTL::StrRef::Hash,
+        FTL::StrRef::Equals
+        > HandlerMap;
+
+      static HandlerMap const &GetHandlerMap();
+
+      void flushNotifications();
+      void preParseNotification( FTL::CStrRef jsonStr, size_t jsonOffset );
+      void coalesceNotifications();
+      void flushNodeRemovals();
+      // tells the controller which node errors the notification can change
+      void noteNodeErrorsMayHaveChanged( QueuedNotification const &queued );
+      Notification notification( QueuedNotification const &queued ) const;
+
+      void handler_nodeInserted( Notification const &notification );
+      void handler_nodeRemoved( Notification const &notification );
+      void handler_nodePortInserted( Notification const &notification );
+      void handler_nodePortRemoved( Notification const &notification );
+      void handler_execPortInserted( Notification const &notification );
+      void handler_execFixedPortInserted( Notification const &notification );
+      void handler_execPortRemoved( Notification const &notification );
+      void handler_execFixedPortRemoved( Notification const &notification );
+      void handler_portsConnected( Notification const &notification );
+      void handler_portsDisconnected( Notification const &notification );
+      void handler_nodeMetadataChanged( Notification const &notification );
+      void handler_execBlockMetadataChanged( Notification const &notification );
+      void handler_instExecTitleChanged( Notification const &notification );
+      void handler_nodeRenamed( Notification const &notification );
+      void handler_execBlockRenamed( Notification const &notification );
+      void handler_instBlockRenamed( Notification const &notification );
+      void handler_execPortRenamed( Notification const &notification );
+      void handler_execFixedPortRenamed( Notification const &notification );
+      void handler_nodePortRenamed( Notification const &notification );
+      void handler_execMetadataChanged( Notification const &notification );
+      void handler_extDepAdded( Notification const &notification );
+      void handler_extDepRemoved( Notification const &notification );
+      void handler_nodeCacheRuleChanged( Notification const &notification );
+      void handler_execCacheRuleChanged( Notification const &notification );
+      void handler_execPortResolvedTypeChanged( Notification const &notification );
+      void handler_execFixedPortResolvedTypeChanged( Notification const &notification );
+      void handler_execBlockPortResolvedTypeChanged( Notification const &notification );
+      void handler_instBlockPortResolvedTypeChanged( Notification const &notification );
+      void handler_execPortTypeSpecChanged( Notification const &notification );
+      void handler_execBlockPortTypeSpecChanged( Notification const &notification );
+      void handler_nodePortResolvedTypeChanged( Notification const &notification );
+      void handler_nodePortMetadataChanged( Notification const &notification );
+      void handler_execPortMetadataChanged( Notification const &notification );
+      void handler_execPortTypeChanged( Notification const &notification );
+      void handler_nodePortTypeChanged( Notification const &notification );
+      void handler_execBlockPortOutsidePortTypeChanged( Notification const &notification );
+      void handler_refVarPathChanged( Notification const &notification );
+      void handler_funcCodeChanged( Notification const &notification );
+      void handler_execTitleChanged( Notification const &notification );
+      void handler_extDepsChanged( Notification const &notification );
+      void handler_execPortDefaultValuesChanged( Notification const &notification );
+      void handler_nodePortDefaultValuesChanged( Notification const &notification );
+      void handler_execBlockPortDefaultValuesChanged( Notification const &notification );
+      void handler_instBlockPortDefaultValuesChanged( Notification const &notification );
+      void handler_removedFromOwner( Notification const &notification );
+      void handler_execPortsReordered( Notification const &notification );
+      void handler_execFixedPortsReordered( Notification const &notification );
+      void handler_execBlockPortsReordered( Notification const &notification );
+      void handler_nodePortsReordered( Notification const &notification );
+      void handler_instBlockPortsReordered( Notification const &notification );
+      void handler_instBlockPortRenamed( Notification const &notification );
+      void handler_execDidAttachPreset( Notification const &notification );
+      void handler_instExecDidAttachPreset( Notification const &notification );
+      void handler_execWillDetachPreset( Notification const &notification );
+      void handler_instExecWillDetachPreset( Notification const &notification );
+      void handler_execEditWouldSplitFromPresetMayHaveChanged( Notification const &notification );
+      void handler_instExecEditWouldSplitFromPresetMayHaveChanged( Notification const &notification );
+      void handler_instBlockExecEditWouldSplitFromPresetMayHaveChanged( Notification const &notification );
+      void handler_instBlockInserted( Notification const &notification );
+      void handler_instBlockPortInserted( Notification const &notification );
+      void handler_instBlockPortRemoved( Notification const &notification );
+      void handler_instBlockRemoved( Notification const &notification );
+      void handler_execBlockInserted( Notification const &notification );
+      void handler_execBlockPortInserted( Notification const &notification );
+      void handler_execBlockPortRenamed( Notification const &notification );
+      void handler_execBlockPortRemoved( Notification const &notification );
+      void handler_execBlockRemoved( Notification const &notification );
+      void handler_ignored( Notification const &notification );
+
+      void postLoadPendingNodes();
+      void loadPendingNode( std::string const &nodeName );
+      void loadPendingConnections();
+      bool isPendingPath( FTL::CStrRef path ) const;
+      void clearPendingNodes();
+
       void checkAndFixPanelPortOrder();
       void checkAndFixNodePortOrder(FabricCore::DFGExec &nodeExec, GraphView::Node *uiNode);
 
@@ -353,6 +602,34 @@ namespace FabricUI
       FabricCore::DFGView m_coreDFGView;
       DFGConfig m_config;
       bool m_performChecks;
+
+      unsigned m_batchDepth;
+      bool m_flushing;
+      bool m_active;
+      bool m_stale;
+      std::map<std::string, std::string> m_expectedNodePosEchoes;
+
+      // Raw notifications waiting to be applied, stored back-to-back
+      // ('\0'-separated) to avoid an allocation per notification
+      std::string m_pendingJSON;
+      std::vector<size_t> m_pendingJSONOffsets;
+
+      // Buffers of the batch being applied; reused from batch to batch
+      std::string m_processingJSON;
+      std::vector<size_t> m_processingJSONOffsets;
+      std::string m_arena;
+      std::vector<Field> m_fields;
+      std::vector<QueuedNotification> m_queue;
+      std::vector<GraphView::Node *> m_nodesToRemove;
+
+      // Two-phase loading of large graphs (see onGraphSet): the decoded
+      // desc of the exec is kept until all its nodes have been populated
+      std::string m_pendingDescJSON;
+      FTL::JSONValue const *m_pendingDesc;
+      QPointer<GraphView::Graph> m_pendingGraph;
+      std::map<std::string, FTL::JSONObject const *> m_pendingNodes;
+      std::vector< std::pair<std::string, std::string> > m_pendingConnections;
+      bool m_pendingLoadPosted;
     };
 
   };
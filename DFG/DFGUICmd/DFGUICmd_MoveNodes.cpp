@@ -3,37 +3,116 @@
 //
 
 #include <FabricUI/DFG/DFGUICmd/DFGUICmd_MoveNodes.h>
+#include <FTL/JSONEnc.h>
+
+#include <algorithm>
 
 FABRIC_UI_DFG_NAMESPACE_BEGIN
 
+DFGUICmd_MoveNodes::DFGUICmd_MoveNodes(
+  FabricCore::DFGBinding const &binding,
+  QString execPath,
+  FabricCore::DFGExec const &exec,
+  QStringList nodeNames,
+  QList<QPointF> newTopLeftPoss
+  )
+  : DFGUICmd_Exec( binding, execPath, exec )
+{
+  int count = std::min( nodeNames.size(), newTopLeftPoss.size() );
+  m_nodeNames.reserve( count );
+  m_newTopLeftPoss.reserve( count );
+  for ( int i = 0; i < count; ++i )
+  {
+    QByteArray nodeNameBA = nodeNames[i].toUtf8();
+    m_nodeNames.push_back(
+      std::string( nodeNameBA.constData(), nodeNameBA.size() )
+      );
+    m_newTopLeftPoss.push_back( newTopLeftPoss[i] );
+  }
+}
+
+std::string DFGUICmd_MoveNodes::EncodeUIGraphPos( QPointF pos )
+{
+  std::string json;
+  {
+    FTL::JSONEnc<std::string> je( json, FTL::JSONFormat::Packed() );
+    FTL::JSONObjectEnc<std::string> joe( je );
+    {
+      FTL::JSONEnc<std::string> xJE( joe, FTL_STR("x") );
+      FTL::JSONFloat64Enc<std::string> xJFE( xJE, pos.x() );
+    }
+    {
+      FTL::JSONEnc<std::string> yJE( joe, FTL_STR("y") );
+      FTL::JSONFloat64Enc<std::string> yJFE( yJE, pos.y() );
+    }
+  }
+  return json;
+}
+
 void DFGUICmd_MoveNodes::appendDesc( QString &desc )
 {
+  QStringList nodeNames;
+  nodeNames.reserve( int( m_nodeNames.size() ) );
+  for ( size_t i = 0; i < m_nodeNames.size(); ++i )
+    nodeNames.append( QString::fromUtf8(
+      m_nodeNames[i].data(), int( m_nodeNames[i].size() )
+      ) );
+
   desc += "Move ";
-  appendDesc_NodeNames( m_nodeNames, desc );
+  appendDesc_NodeNames( nodeNames, desc );
 }
 
 void DFGUICmd_MoveNodes::invoke( unsigned &coreUndoCount )
 {
-  QList<QByteArray> nodeNameBAs;
-  nodeNameBAs.reserve( m_nodeNames.size() );
-  foreach ( QString nodeName, m_nodeNames )
-    nodeNameBAs.push_back( nodeName.toUtf8() );
-
-  std::vector<FTL::CStrRef> nodeNames;
-  nodeNames.reserve( m_nodeNames.size() );
-  foreach ( QByteArray nodeNameBA, nodeNameBAs )
-    nodeNames.push_back( nodeNameBA.constData() );
-
-  std::vector<QPointF> newTopLeftPoss;
-  newTopLeftPoss.reserve( m_newTopLeftPoss.size() );
-  foreach ( QPointF newTopLeftPos, m_newTopLeftPoss )
-    newTopLeftPoss.push_back( newTopLeftPos );
-
-  moveNodes(
-    nodeNames,
-    newTopLeftPoss,
-    coreUndoCount
-    );
+  FabricCore::DFGExec &exec = getExec();
+
+  m_oldUIGraphPoss.resize( m_nodeNames.size() );
+  for ( size_t i = 0; i < m_nodeNames.size(); ++i )
+  {
+    FTL::CStrRef oldUIGraphPos =
+      exec.getItemMetadata( m_nodeNames[i].c_str(), "uiGraphPos" );
+    m_oldUIGraphPoss[i].assign( oldUIGraphPos.data(), oldUIGraphPos.size() );
+  }
+
+  setNewUIGraphPoss();
+
+  // nothing to undo in the Core : see undo()
+  coreUndoCount = 0;
+}
+
+void DFGUICmd_MoveNodes::setNewUIGraphPoss()
+{
+  FabricCore::DFGExec &exec = getExec();
+  for ( size_t i = 0; i < m_nodeNames.size(); ++i )
+    exec.setItemMetadata(
+      m_nodeNames[i].c_str(),
+      "uiGraphPos",
+      EncodeUIGraphPos( m_newTopLeftPoss[i] ).c_str(),
+      false, // canUndo
+      false // shouldSplitFromPreset
+      );
+}
+
+void DFGUICmd_MoveNodes::undo()
+{
+  DFGUICmd_Exec::undo();
+
+  FabricCore::DFGExec &exec = getExec();
+  for ( size_t i = m_nodeNames.size(); i--; )
+    exec.setItemMetadata(
+      m_nodeNames[i].c_str(),
+      "uiGraphPos",
+      m_oldUIGraphPoss[i].c_str(),
+      false, // canUndo
+      false // shouldSplitFromPreset
+      );
+}
+
+void DFGUICmd_MoveNodes::redo()
+{
+  DFGUICmd_Exec::redo();
+
+  setNewUIGraphPoss();
 }
 
 FABRIC_UI_DFG_NAMESPACE_END
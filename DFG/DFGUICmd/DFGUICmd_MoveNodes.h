@@ -6,8 +6,16 @@
 #include <FabricUI/DFG/DFGUICmd/DFGUICmd_Exec.h>
 #include <FTL/ArrayRef.h>
 
+#include <string>
+#include <vector>
+
 FABRIC_UI_DFG_NAMESPACE_BEGIN
 
+// Moves can involve hundreds of nodes at once: the names are converted to
+// UTF-8 once, and the command keeps its own (name, old pos, new pos)
+// arrays. Rather than one Core undo entry per node, the uiGraphPos
+// metadata is written without Core undo and undo/redo write the old/new
+// values back themselves.
 class DFGUICmd_MoveNodes
   : public DFGUICmd_Exec
 {
@@ -19,16 +27,19 @@ public:
     FabricCore::DFGExec const &exec,
     QStringList nodeNames,
     QList<QPointF> newTopLeftPoss
-    )
-    : DFGUICmd_Exec( binding, execPath, exec )
-    , m_nodeNames( nodeNames )
-    , m_newTopLeftPoss( newTopLeftPoss )
-  {
-  }
+    );
 
   static FTL::CStrRef CmdName()
     { return DFG_CMD_NAME("MoveNodes"); }
 
+  // The uiGraphPos metadata value for a position, as written by this
+  // command (used by the DFGController to recognize the echoes)
+  static std::string EncodeUIGraphPos( QPointF pos );
+
+  virtual void undo();
+
+  virtual void redo();
+
 protected:
   
   virtual void appendDesc( QString &desc );
@@ -37,8 +48,12 @@ protected:
 
 private:
 
-  QList<QString> m_nodeNames;
-  QList<QPointF> m_newTopLeftPoss;
+  void setNewUIGraphPoss();
+
+  std::vector<std::string> m_nodeNames;
+  std::vector<QPointF> m_newTopLeftPoss;
+  // the metadata values found when invoked, restored as-is by undo
+  std::vector<std::string> m_oldUIGraphPoss;
 };
 
 FABRIC_UI_DFG_NAMESPACE_END
@@ -16,11 +16,14 @@
 #include <FabricUI/ModelItems/InstModelItem.h>
 #include <FabricUI/ModelItems/SetModelItem.h>
 #include <FabricUI/ModelItems/VarModelItem.h>
+#include <FabricUI/ValueEditor/BaseModelItem.h>
 #include <FabricUI/ValueEditor/BaseViewItem.h>
 #include <FabricUI/ValueEditor/ItemMetadata.h>
 #include <FabricUI/ValueEditor/VETreeWidget.h>
 #include <FabricUI/ValueEditor/VETreeWidgetItem.h>
 #include <FabricUI/DFG/DFGVEEditorContextualMenu.h>
+#include <QElapsedTimer>
+#include <QTimer>
 #include <iostream>
 using namespace FabricUI;
 using namespace DFG;
@@ -30,6 +33,7 @@ DFGVEEditorOwner::DFGVEEditorOwner( DFGWidget * dfgWidget )
   : m_dfgWidget(dfgWidget)
   , m_setGraph( NULL )
   , m_notifProxy( NULL )
+  , m_refreshOutputsPending( false )
 {
   m_valueEditor->setContextMenuPolicy(Qt::CustomContextMenu);
   m_valueEditor->setMouseTracking(true);
@@ -40,6 +44,12 @@ DFGVEEditorOwner::DFGVEEditorOwner( DFGWidget * dfgWidget )
     this,
     SLOT(onItemOveredChanged(QTreeWidgetItem*, QTreeWidgetItem*))
     );
+
+  // Outputs scrolled or expanded into view might be stale
+  connect(
+    m_valueEditor, SIGNAL( visibleItemsChanged() ),
+    this, SLOT( scheduleRefreshOutputs() )
+    );
 }
 
 DFGVEEditorOwner::~DFGVEEditorOwner()
@@ -672,7 +682,11 @@ void DFGVEEditorOwner::onOutputsChanged()
     return;
 
   // We need to update all -out- values to reflect the
-  // result of the new calculation
+  // result of the new calculation. Getting a value and
+  // updating its widgets is costly, so it is only done for
+  // the outputs on screen, and not more than once per
+  // event loop pass when evaluating repeatedly (eg, playback)
+  m_staleOutputs.clear();
   FabricUI::ModelItems::ChildVec::iterator itr =
     m_modelRoot->GetChildItrBegin();
   FabricUI::ModelItems::ChildVec::iterator end =
@@ -685,12 +699,61 @@ void DFGVEEditorOwner::onOutputsChanged()
       FTL::CStrRef vePortType =
         childItemMetadata->getString( ValueEditor::ItemMetadata::VEPortTypeKey.c_str() );
       if ( vePortType != FTL_STR("In") )
-      {
-        QVariant val = childModelItem->getValue();
-        childModelItem->emitModelValueChanged( val );
-      }
+        m_staleOutputs.append( childModelItem );
     }
   }
+
+  scheduleRefreshOutputs();
+}
+
+void DFGVEEditorOwner::scheduleRefreshOutputs()
+{
+  if ( m_refreshOutputsPending || m_staleOutputs.isEmpty() )
+    return;
+  m_refreshOutputsPending = true;
+  QTimer::singleShot( 0, this, SLOT( refreshOutputs() ) );
+}
+
+void DFGVEEditorOwner::refreshOutputs()
+{
+  m_refreshOutputsPending = false;
+
+  QElapsedTimer timer;
+  timer.start();
+  qint64 sliceMs = getDfgWidget()->getConfig().valueEditorRefreshSliceMs;
+
+  bool outOfTime = false;
+  for ( int i = 0; i < m_staleOutputs.size(); )
+  {
+    ValueEditor::BaseModelItem *modelItem = m_staleOutputs[i];
+    if ( modelItem == NULL )
+    {
+      m_staleOutputs.removeAt( i );
+      continue;
+    }
+
+    // The hidden outputs stay stale until they are shown
+    // (see VETreeWidget::visibleItemsChanged); the collapsed
+    // ones are rebuilt from the model when expanded
+    if ( !m_valueEditor->isModelItemVisible( modelItem ) )
+    {
+      ++i;
+      continue;
+    }
+
+    if ( timer.elapsed() >= sliceMs )
+    {
+      outOfTime = true;
+      break;
+    }
+
+    QVariant val = modelItem->getValue();
+    modelItem->emitModelValueChanged( val );
+    m_staleOutputs.removeAt( i );
+  }
+
+  if ( outOfTime )
+    scheduleRefreshOutputs();
 }
 
 void DFGVEEditorOwner::onBindingArgInserted( unsigned index, FTL::CStrRef name, FTL::CStrRef type )
@@ -1089,13 +1152,16 @@ void DFGVEEditorOwner::onGraphSet( FabricUI::GraphView::Graph * graph )
 {
   if(graph != m_setGraph)
   {
+    // the graph may have been set before (see DFGWidget::onExecChanged)
     connect( 
       graph, SIGNAL( sidePanelInspectRequested() ),
-      this, SLOT( onSidePanelInspectRequested() )
+      this, SLOT( onSidePanelInspectRequested() ),
+      Qt::UniqueConnection
       );
     connect(
       graph, SIGNAL( nodeInspectRequested( FabricUI::GraphView::Node* ) ),
-      this, SLOT( onNodeInspectRequested( FabricUI::GraphView::Node* ) )
+      this, SLOT( onNodeInspectRequested( FabricUI::GraphView::Node* ) ),
+      Qt::UniqueConnection
       );
 
     
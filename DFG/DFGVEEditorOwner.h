@@ -7,6 +7,7 @@
 
 #include <FabricUI/ValueEditor/VEEditorOwner.h>
 #include <FabricUI/DFG/DFGNotifier.h>
+#include <QPointer>
 #include <QTreeWidgetItem>
 
 class BaseModelItem;
@@ -300,6 +301,14 @@ namespace FabricUI {
       FabricUI::DFG::DFGWidget * getDfgWidget();
       FabricUI::DFG::DFGController * getDFGController();
 
+    private slots:
+
+      void scheduleRefreshOutputs();
+      // Refreshes the stale outputs that are shown, for at most
+      // DFGConfig::valueEditorRefreshSliceMs, then posts itself again
+      // for the ones left
+      void refreshOutputs();
+
     private:
 
       void setModelRoot(
@@ -317,6 +326,10 @@ namespace FabricUI {
       QSharedPointer<DFG::DFGNotifier> m_notifier;
       QSharedPointer<DFG::DFGNotifier> m_subNotifier;
       DFGVEEditorOwner_NotifProxy *m_notifProxy;
+
+      // The outputs whose view doesn't show the last evaluation yet
+      QList< QPointer<ValueEditor::BaseModelItem> > m_staleOutputs;
+      bool m_refreshOutputsPending;
     };
 }
 }
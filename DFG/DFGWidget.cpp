@@ -64,6 +64,8 @@ DFGWidget::DFGWidget(
   , m_errorsWidget( 0 )
   , m_uiGraph( 0 )
   , m_router( 0 )
+  , m_uiGraphIsCacheable( false )
+  , m_uiGraphBindingID( 0 )
   , m_tabSearchVariablesDirty( true )
   , m_manager( manager )
   , m_dfgConfig( dfgConfig )
@@ -291,6 +293,8 @@ DFGWidget::~DFGWidget()
 
   if ( m_router )
     delete m_router;
+
+  clearUIGraphCache();
 }
 
 GraphView::Graph * DFGWidget::getUIGraph()
@@ -3075,15 +3079,50 @@ void DFGWidget::populateMenuBar(QMenuBar *menuBar, bool addFileMenu, bool addEdi
 
 void DFGWidget::onExecChanged()
 {
+  FabricCore::DFGExec &exec = m_uiController->getExec();
+
+  bool isCacheable = isUIGraphCacheable();
+  unsigned bindingID = 0;
+  std::string execPath;
+  if ( isCacheable )
+  {
+    bindingID = m_uiController->getBinding().getBindingID();
+    execPath = m_uiController->getExecPath().c_str();
+  }
+
   if ( m_router )
   {
     m_uiController->setRouter( 0 );
-    delete m_router;
+    // the graph we are leaving is rebuilt when the same exec is refreshed
+    // (see DFGController::refreshExec)
+    if ( m_uiGraphIsCacheable && m_uiGraph
+      && ( !isCacheable
+        || bindingID != m_uiGraphBindingID
+        || execPath != m_uiGraphExecPath ) )
+      putUIGraphAside();
+    else
+      delete m_router;
     m_router = 0;
   }
 
-  FabricCore::DFGExec &exec = m_uiController->getExec();
-  if ( exec.isValid() )
+  if ( !exec.isValid() )
+    clearUIGraphCache();
+
+  bool restored =
+    isCacheable && restoreCachedUIGraph( bindingID, execPath );
+  if ( restored )
+  {
+    m_uiController->setGraph(m_uiGraph);
+    m_uiController->setRouter(m_router);
+
+    onExecSplitChanged();
+    m_uiGraph->setCompsBlockedOverlayVisibility(m_uiController->getHost().areCompsBlocked());
+
+    m_uiGraphViewWidget->show();
+    m_uiGraphViewWidget->setFocus();
+    m_errorsWidget->focusBinding();
+  }
+  else if ( exec.isValid() )
   {
     m_uiGraph = new GraphView::Graph( NULL, m_dfgConfig.graphConfig );
     m_uiGraph->setController(m_uiController.get());
@@ -3164,13 +3203,22 @@ void DFGWidget::onExecChanged()
     m_isEditable = false;
   }
 
+  m_uiGraphIsCacheable = isCacheable;
+  m_uiGraphBindingID = bindingID;
+  m_uiGraphExecPath = execPath;
+  m_uiGraphExec = isCacheable ? exec : FabricCore::DFGExec();
+
   m_uiGraphViewWidget->setGraph(m_uiGraph);
 
   if ( m_uiGraph )
   {
     try
     {
-      m_router->onGraphSet();
+      // a restored graph only misses what changed while it was put aside
+      if ( restored )
+        m_router->setActive( true );
+      else
+        m_router->onGraphSet();
     }
     catch(FabricCore::Exception e)
     {
@@ -3183,11 +3231,130 @@ void DFGWidget::onExecChanged()
 
   this->tabSearchBlockToggleChanged();
 
+  // a restored graph was upgraded when it was built
+  if ( m_uiGraph && !restored )
+    m_uiController->upgradeBackDrops();
   m_uiController->updateNodeErrors();
 
   emit execChanged();
 }
 
+bool DFGWidget::isUIGraphCacheable()
+{
+  FabricCore::DFGExec &exec = m_uiController->getExec();
+  return m_dfgConfig.uiGraphCacheSize > 0
+    && exec.isValid()
+    && m_uiController->getExecBlockName().empty()
+    && exec.getType() == FabricCore::DFGExecType_Graph;
+}
+
+void DFGWidget::putUIGraphAside()
+{
+  m_router->setActive( false );
+
+  CachedUIGraph cachedUIGraph;
+  cachedUIGraph.bindingID = m_uiGraphBindingID;
+  cachedUIGraph.execPath = m_uiGraphExecPath;
+  cachedUIGraph.exec = m_uiGraphExec;
+  cachedUIGraph.graph = m_uiGraph;
+  cachedUIGraph.router = m_router;
+  m_uiGraphCache.insert( m_uiGraphCache.begin(), cachedUIGraph );
+
+  while ( m_uiGraphCache.size() > m_dfgConfig.uiGraphCacheSize )
+  {
+    DeleteCachedUIGraph( m_uiGraphCache.back() );
+    m_uiGraphCache.pop_back();
+  }
+
+  m_uiGraph = NULL;
+  m_router = NULL;
+}
+
+bool DFGWidget::restoreCachedUIGraph(
+  unsigned bindingID,
+  std::string const &execPath
+  )
+{
+  for ( std::vector<CachedUIGraph>::iterator it = m_uiGraphCache.begin();
+    it != m_uiGraphCache.end(); ++it )
+  {
+    if ( it->bindingID != bindingID || execPath != it->execPath )
+      continue;
+
+    CachedUIGraph cachedUIGraph = *it;
+    m_uiGraphCache.erase( it );
+
+    if ( !cachedUIGraphIsUpToDate( cachedUIGraph ) )
+    {
+      DeleteCachedUIGraph( cachedUIGraph );
+      return false;
+    }
+
+    m_uiGraph = cachedUIGraph.graph;
+    m_router = cachedUIGraph.router;
+    return true;
+  }
+  return false;
+}
+
+bool DFGWidget::cachedUIGraphIsUpToDate(
+  CachedUIGraph const &cachedUIGraph
+  )
+{
+  if ( cachedUIGraph.router->isStale() )
+    return false;
+
+  // the exec may have been renamed or replaced by another one
+  // at the same path, which the router can't tell
+  try
+  {
+    FabricCore::DFGExec exec = cachedUIGraph.exec;
+    if ( !exec.isValid() )
+      return false;
+    FabricCore::String execPath = exec.getExecPath();
+    if ( std::string( execPath.getCStr(), execPath.getSize() )
+      != cachedUIGraph.execPath )
+      return false;
+  }
+  catch ( FabricCore::Exception e )
+  {
+    return false;
+  }
+
+  // the settings may have been toggled on another graph in the meantime
+  if ( getSettings() )
+  {
+    GraphView::GraphConfig &config = cachedUIGraph.graph->config();
+#define MAYBE_CHECK_CONFIG_VALUE( name ) if ( config.name != getSettings()->value( "DFGWidget/" #name, config.name ).toBool() ) return false;
+
+    MAYBE_CHECK_CONFIG_VALUE( dimConnectionLines )
+    MAYBE_CHECK_CONFIG_VALUE( connectionShowTooltip )
+    MAYBE_CHECK_CONFIG_VALUE( highlightConnectionTargets )
+    MAYBE_CHECK_CONFIG_VALUE( connectionDrawAsCurves )
+    MAYBE_CHECK_CONFIG_VALUE( portsCentered )
+    MAYBE_CHECK_CONFIG_VALUE( mainPanelDrawGrid )
+    MAYBE_CHECK_CONFIG_VALUE( mainPanelGridSnap )
+    MAYBE_CHECK_CONFIG_VALUE( mainPanelNodeSnap )
+    MAYBE_CHECK_CONFIG_VALUE( mainPanelPortSnap )
+  }
+
+  return true;
+}
+
+void DFGWidget::clearUIGraphCache()
+{
+  for ( size_t i = 0; i < m_uiGraphCache.size(); ++i )
+    DeleteCachedUIGraph( m_uiGraphCache[i] );
+  m_uiGraphCache.clear();
+}
+
+void DFGWidget::DeleteCachedUIGraph( CachedUIGraph &cachedUIGraph )
+{
+  delete cachedUIGraph.router;
+  // we may be called from one of the graph's own event handlers
+  cachedUIGraph.graph->deleteLater();
+}
+
 void DFGWidget::reloadStyles()
 {
   QString styleSheet = LoadFabricStyleSheet( "FabricUI.qss" );
@@ -3245,6 +3412,9 @@ void DFGWidget::replaceBinding(
   )
 {
   m_priorExecStack.clear();
+  // none of the graphs built so far can be displayed again
+  m_uiGraphIsCacheable = false;
+  clearUIGraphCache();
   FabricCore::DFGExec exec = binding.getExec();
   m_uiController->setBindingExec( binding, FTL::StrRef(), exec );
 }
@@ -241,12 +241,40 @@ namespace DFG {
       bool checkForUnsaved();
       QPointF getTabSearchScenePos() const;
 
+      // A built graph, with the router that keeps it up to date, put aside
+      // when leaving its exec so that entering it again is immediate
+      struct CachedUIGraph
+      {
+        unsigned bindingID;
+        std::string execPath;
+        FabricCore::DFGExec exec;
+        GraphView::Graph *graph;
+        DFGNotificationRouter *router;
+      };
+
+      bool isUIGraphCacheable();
+      void putUIGraphAside();
+      bool restoreCachedUIGraph(
+        unsigned bindingID,
+        std::string const &execPath
+        );
+      bool cachedUIGraphIsUpToDate( CachedUIGraph const &cachedUIGraph );
+      void clearUIGraphCache();
+      static void DeleteCachedUIGraph( CachedUIGraph &cachedUIGraph );
+
       DFGGraphViewWidget * m_uiGraphViewWidget;
       DFGExecHeaderWidget * m_uiHeader;
       DFGErrorsWidget *m_errorsWidget;
       GraphView::Graph * m_uiGraph;
       FTL::OwnedPtr<DFGController> m_uiController;
       DFGNotificationRouter * m_router;
+      // what m_uiGraph was built for, when it can be put aside
+      bool m_uiGraphIsCacheable;
+      unsigned m_uiGraphBindingID;
+      std::string m_uiGraphExecPath;
+      FabricCore::DFGExec m_uiGraphExec;
+      // most recently left first
+      std::vector<CachedUIGraph> m_uiGraphCache;
       DFGKLEditorWidget * m_klEditor;
       DFGExecBlockEditorWidget *m_execBlockEditorWidget;
       QPoint m_tabSearchPos;
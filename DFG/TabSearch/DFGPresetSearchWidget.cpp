@@ -5,6 +5,7 @@
 #include "QueryEdit.h"
 #include "ResultsView.h"
 #include "DetailsWidget.h"
+#include "PresetSearchWorker.h"
 
 #include "Data.h"
 
@@ -17,11 +18,18 @@
 #include <QPushButton>
 #include <QLabel>
 #include <QLayout>
+#include <QThread>
+#include <QTimer>
+#include <QMutexLocker>
 
 using namespace FabricUI::DFG;
 
 static const QKeySequence ToggleDetailsKey = Qt::CTRL + Qt::Key_Tab;
 
+// Typing a word shouldn't trigger a search for each of its letters
+static const int DefaultSearchDebounceInterval = 60;
+static const unsigned DefaultMaxResults = 64;
+
 static const size_t NbHints = 8;
 struct Hint
 {
@@ -199,7 +207,28 @@ DFGPresetSearchWidget::DFGPresetSearchWidget( FabricCore::DFGHost* host )
   , m_detailsWidget( new TabSearch::DetailsWidget( m_host ) )
   , m_detailsPanel( new QScrollArea() )
   , m_detailsPanelToggled( true )
-{
+  , m_searchThread( new QThread( this ) )
+  , m_searchWorker( new TabSearch::PresetSearchWorker() )
+  , m_searchTimer( new QTimer( this ) )
+  , m_searchGeneration( 0 )
+  , m_resultsGeneration( 0 )
+  , m_validatePending( false )
+  , m_maxResults( DefaultMaxResults )
+{
+  m_searchWorker->moveToThread( m_searchThread );
+  connect(
+    m_searchWorker, SIGNAL( resultsReady( unsigned, QByteArray ) ),
+    this, SLOT( onSearchResults( unsigned, QByteArray ) ),
+    Qt::QueuedConnection
+  );
+  m_searchThread->start();
+
+  m_searchTimer->setSingleShot( true );
+  m_searchTimer->setInterval( DefaultSearchDebounceInterval );
+  connect(
+    m_searchTimer, SIGNAL( timeout() ),
+    this, SLOT( startSearch() )
+  );
 
   registerStaticEntries();
 
@@ -372,9 +401,25 @@ DFGPresetSearchWidget::DFGPresetSearchWidget( FabricCore::DFGHost* host )
 
 DFGPresetSearchWidget::~DFGPresetSearchWidget()
 {
+  m_searchTimer->stop();
+  m_searchWorker->cancel();
+  m_searchThread->quit();
+  m_searchThread->wait();
+  delete m_searchWorker;
+
   this->unregisterVariables();
 }
 
+void DFGPresetSearchWidget::setSearchDebounceInterval( int msec )
+{
+  m_searchTimer->setInterval( std::max( 0, msec ) );
+}
+
+int DFGPresetSearchWidget::searchDebounceInterval() const
+{
+  return m_searchTimer->interval();
+}
+
 void DFGPresetSearchWidget::showForSearch( QPoint globalPos )
 {
   move( QPoint( 0, 0 ) );
@@ -402,52 +447,79 @@ void DFGPresetSearchWidget::keyPressEvent( QKeyEvent *event )
 
 void DFGPresetSearchWidget::onQueryChanged( const TabSearch::Query& query )
 {
+  // The query changed after Enter was pressed : don't validate
+  m_validatePending = false;
+
+  // Registering entries writes to the database : keep it on this thread
   registerStaticEntries();
 
-  std::vector<std::string> searchTermsStr = query.getSplitText();
+  // (Re)starting the timer : only the last of a burst
+  // of changes will actually be searched
+  if( m_searchTimer->interval() > 0 )
+    m_searchTimer->start();
+  else
+    startSearch();
+}
+
+void DFGPresetSearchWidget::startSearch()
+{
+  m_searchTimer->stop();
+
+  const TabSearch::Query& query = m_queryEdit->query();
+
+  TabSearch::PresetSearchWorker::Request request;
+  request.host = *m_host;
+  request.maxResults = m_maxResults;
+  request.generation = ++m_searchGeneration;
 
   // Remove tags (i.e. terms that contain ':') because they should be
   // in query.getTags() instead (otherwise, it means they are being typed)
-  {
-    std::vector<std::string> filteredTerms;
-    for( size_t i = 0; i < searchTermsStr.size(); i++ )
-      if( !TabSearch::Query::Tag::IsTag( searchTermsStr[i] ) )
-      {
-        // Converting the string to Latin1 because Core/DFGHost::searchPresets
-        // currently only supports encodings with 1 byte per char
-        std::string searchTerm = ToLatin1( searchTermsStr[i] );
-        filteredTerms.push_back( searchTerm );
-      }
-    searchTermsStr = filteredTerms;
-  }
+  std::vector<std::string> searchTermsStr = query.getSplitText();
+  for( size_t i = 0; i < searchTermsStr.size(); i++ )
+    if( !TabSearch::Query::Tag::IsTag( searchTermsStr[i] ) )
+    {
+      // Converting the string to Latin1 because Core/DFGHost::searchPresets
+      // currently only supports encodings with 1 byte per char
+      request.terms.push_back( ToLatin1( searchTermsStr[i] ) );
+    }
 
-  std::vector<char const*> searchTerms( searchTermsStr.size() );
+  const TabSearch::Query::Tags& queryTags = query.getTags();
+  request.tags.assign( queryTags.begin(), queryTags.end() );
 
-  for( unsigned int i = 0; i < searchTermsStr.size(); i++ )
-    searchTerms[i] = searchTermsStr[i].data();
+  // Querying the DataBase of presets (see onSearchResults)
+  m_searchWorker->post( request );
+}
 
-  std::vector<char const *> requiredTags;
-  const TabSearch::Query::Tags& queryTags = query.getTags();
-  requiredTags.resize( queryTags.size() );
-  for( size_t i=0; i<queryTags.size(); i++ )
-    requiredTags[i] = queryTags[i].data();
-
-  // Querying the DataBase of presets
-  FabricCore::String json = m_host->searchPresets(
-    searchTerms.size(),
-    searchTerms.data(),
-    requiredTags.size(),
-    requiredTags.data(),
-    0,
-    16
-  );
-  std::string jsonStr( json.getCStr(), json.getSize() );
+void DFGPresetSearchWidget::onSearchResults( unsigned generation, QByteArray json )
+{
+  // A more recent search has been started since
+  if( generation != m_searchGeneration )
+    return;
+
+  m_resultsGeneration = generation;
+
+  // The search failed : keeping the previous results,
+  // but they can't be validated for this query
+  if( json.isEmpty() )
+  {
+    m_validatePending = false;
+    return;
+  }
+
+  const TabSearch::Query& query = m_queryEdit->query();
+  std::string jsonStr( json.constData(), json.size() );
 
   hidePreview();
   m_status->setHintsEnabled( query.getTags().size() == 0 && query.getText().empty() );
   m_resultsView->setResults( jsonStr, query );
 
   updateSize();
+
+  if( m_validatePending )
+  {
+    m_validatePending = false;
+    m_resultsView->validateSelection();
+  }
 }
 
 void DFGPresetSearchWidget::updateResults()
@@ -491,6 +563,8 @@ void DFGPresetSearchWidget::registerStaticEntries()
 
   try
   {
+    QMutexLocker databaseLock( m_searchWorker->databaseMutex() );
+
     TabSearch::Result backdropResult( BackdropType, "BackDrop" );
     if( !m_host->searchDBHasUser( backdropResult.data() ) )
       m_host->searchDBAddUser(
@@ -542,6 +616,7 @@ void DFGPresetSearchWidget::registerVariable( const std::string& name, const std
   const std::string nameTag = "name:" + name;
   const std::string typeTag = "porttype:" + type;
   const std::string functions[] = { VariableSetType, VariableGetType };
+  QMutexLocker databaseLock( m_searchWorker->databaseMutex() );
   for( size_t i = 0; i < sizeof( functions ) / sizeof( std::string ); i++ )
   {
     const std::string& functionType = functions[i];
@@ -574,6 +649,7 @@ void DFGPresetSearchWidget::registerVariable( const std::string& name, const std
 
 void DFGPresetSearchWidget::unregisterVariables()
 {
+  QMutexLocker databaseLock( m_searchWorker->databaseMutex() );
   for( std::set<std::string>::const_iterator it = m_registeredVariables.begin();
     it != m_registeredVariables.end(); it++ )
   {
@@ -644,6 +720,18 @@ void DFGPresetSearchWidget::updateSize()
 
 void DFGPresetSearchWidget::validateSelection()
 {
+  // Don't wait for the debounce : the query is complete
+  if( m_searchTimer->isActive() )
+    startSearch();
+
+  // The displayed results are those of a previous query :
+  // validating once the results of this one arrive
+  if( m_resultsGeneration != m_searchGeneration )
+  {
+    m_validatePending = true;
+    return;
+  }
+
   m_resultsView->validateSelection();
 }
 
@@ -786,6 +874,8 @@ void DFGPresetSearchWidget::onLogClear()
 
 void DFGPresetSearchWidget::close()
 {
+  m_validatePending = false;
+
   if( m_clearQueryOnClose )
     m_queryEdit->clear();
   else
@@ -4,11 +4,14 @@
 #define __UI_DFG_TabSearch_DFGPresetSearchWidget__
 
 #include <FabricUI/DFG/DFGTabSearchWidget.h>
+#include <QByteArray>
 
 #include <set>
 
 class QFrame;
 class QScrollArea;
+class QThread;
+class QTimer;
 
 namespace FabricUI
 {
@@ -22,6 +25,7 @@ namespace FabricUI
       class Toggle;
       struct Query;
       class Result;
+      class PresetSearchWorker;
     }
 
     class DFGPresetSearchWidget : public DFGAbstractTabSearchWidget
@@ -42,6 +46,14 @@ namespace FabricUI
       void showEvent( QShowEvent * event ) FTL_OVERRIDE;
       void toggleNewBlocks( bool );
 
+      // Delay (in milliseconds) between the last change of the Query
+      // and the search being sent to the DFGHost
+      void setSearchDebounceInterval( int msec );
+      int searchDebounceInterval() const;
+      // Maximum number of presets requested to the DFGHost
+      void setMaxResults( unsigned maxResults ) { m_maxResults = maxResults; }
+      unsigned maxResults() const { return m_maxResults; }
+
     signals:
       // Emitted when a Result (there are different types) has been chosen
       void selectedPreset( QString preset );
@@ -61,6 +73,8 @@ namespace FabricUI
 
     private slots:
       void onQueryChanged( const TabSearch::Query& query );
+      void startSearch();
+      void onSearchResults( unsigned generation, QByteArray json );
       void onResultValidated( const TabSearch::Result& result );
       void validateSelection();
       void hidePreview();
@@ -102,6 +116,18 @@ namespace FabricUI
       TabSearch::Toggle* m_toggleDetailsButton;
       bool m_detailsPanelToggled;
       class MoveHandle;
+
+      // The search itself runs on m_searchThread; m_searchGeneration
+      // identifies the latest request, older results are ignored
+      QThread* m_searchThread;
+      TabSearch::PresetSearchWorker* m_searchWorker;
+      QTimer* m_searchTimer;
+      unsigned m_searchGeneration;
+      // Generation of the displayed results : if it isn't the latest one,
+      // validating the selection waits for the results (m_validatePending)
+      unsigned m_resultsGeneration;
+      bool m_validatePending;
+      unsigned m_maxResults;
     };
   };
 };
@@ -0,0 +1,97 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#include "PresetSearchWorker.h"
+
+#include <QMutexLocker>
+#include <iostream>
+
+using namespace FabricUI::DFG::TabSearch;
+
+PresetSearchWorker::PresetSearchWorker()
+  : m_hasPending( false )
+  , m_latestGeneration( 0 )
+{
+}
+
+void PresetSearchWorker::post( const Request& request )
+{
+  bool wasPending;
+  {
+    QMutexLocker lock( &m_mutex );
+    wasPending = m_hasPending;
+    m_pending = request;
+    m_hasPending = true;
+    m_latestGeneration = request.generation;
+  }
+  // If a request was already waiting, its process() call
+  // is still queued and will pick up this one instead
+  if( !wasPending )
+    QMetaObject::invokeMethod( this, "process", Qt::QueuedConnection );
+}
+
+void PresetSearchWorker::cancel()
+{
+  QMutexLocker lock( &m_mutex );
+  m_hasPending = false;
+  m_pending = Request();
+  m_latestGeneration++;
+}
+
+bool PresetSearchWorker::isObsolete( unsigned generation )
+{
+  QMutexLocker lock( &m_mutex );
+  return generation != m_latestGeneration;
+}
+
+void PresetSearchWorker::process()
+{
+  Request request;
+  {
+    QMutexLocker lock( &m_mutex );
+    if( !m_hasPending )
+      return;
+    request = m_pending;
+    m_pending = Request();
+    m_hasPending = false;
+  }
+
+  if( !request.host.isValid() )
+  {
+    // Still answering, so nobody waits for these results
+    if( !isObsolete( request.generation ) )
+      emit resultsReady( request.generation, QByteArray() );
+    return;
+  }
+
+  std::vector<char const *> terms( request.terms.size() );
+  for( size_t i = 0; i < request.terms.size(); i++ )
+    terms[i] = request.terms[i].data();
+
+  std::vector<char const *> tags( request.tags.size() );
+  for( size_t i = 0; i < request.tags.size(); i++ )
+    tags[i] = request.tags[i].data();
+
+  QByteArray json;
+  try
+  {
+    QMutexLocker databaseLock( &m_databaseMutex );
+    FabricCore::String result = request.host.searchPresets(
+      terms.size(),
+      terms.data(),
+      tags.size(),
+      tags.data(),
+      0,
+      request.maxResults
+    );
+    json = QByteArray( result.getCStr(), int( result.getSize() ) );
+  }
+  catch( const FabricCore::Exception& e )
+  {
+    std::cerr << "PresetSearchWorker::process : " << e.getDesc_cstr() << std::endl;
+    json.clear(); // Still answering, so nobody waits for these results
+  }
+
+  // Don't bother the GUI thread with results nobody is waiting for
+  if( !isObsolete( request.generation ) )
+    emit resultsReady( request.generation, json );
+}
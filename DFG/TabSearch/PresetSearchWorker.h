@@ -0,0 +1,73 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#ifndef __UI_DFG_TabSearch_PresetSearchWorker__
+#define __UI_DFG_TabSearch_PresetSearchWorker__
+
+#include <FabricCore.h>
+#include <QObject>
+#include <QByteArray>
+#include <QMutex>
+#include <string>
+#include <vector>
+
+namespace FabricUI
+{
+  namespace DFG
+  {
+    namespace TabSearch
+    {
+      // Runs DFGHost::searchPresets away from the GUI thread.
+      // Only the most recent request is kept : a request posted while
+      // another one is pending replaces it, and results of a request
+      // that has been superseded in the meantime are dropped.
+      class PresetSearchWorker : public QObject
+      {
+        Q_OBJECT
+
+      public:
+
+        struct Request
+        {
+          FabricCore::DFGHost host;
+          // Already converted to Latin1 (see DFGPresetSearchWidget::onQueryChanged)
+          std::vector<std::string> terms;
+          std::vector<std::string> tags;
+          unsigned maxResults;
+          unsigned generation;
+          Request() : maxResults( 0 ), generation( 0 ) {}
+        };
+
+        PresetSearchWorker();
+
+        // Thread-safe : can be called from the GUI thread
+        void post( const Request& request );
+        // Thread-safe : marks all the requests posted so far as obsolete
+        void cancel();
+
+        // Held while searchPresets runs : the search database of the
+        // DFGHost is not thread-safe, so it must also be held by the
+        // GUI thread while adding or removing entries
+        QMutex* databaseMutex() { return &m_databaseMutex; }
+
+      signals:
+        // Emitted from the worker thread, with the JSON returned by searchPresets
+        // (empty if the search failed)
+        void resultsReady( unsigned generation, QByteArray json );
+
+      private slots:
+        void process();
+
+      private:
+        bool isObsolete( unsigned generation );
+
+        QMutex m_mutex;
+        QMutex m_databaseMutex;
+        Request m_pending;
+        bool m_hasPending;
+        unsigned m_latestGeneration;
+      };
+    }
+  };
+};
+
+#endif // __UI_DFG_TabSearch_PresetSearchWorker__
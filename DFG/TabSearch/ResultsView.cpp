@@ -317,14 +317,8 @@ struct ReducedNode : Node< PresetAnd< Tags > >
 
 // Third and last step : this tree is the one
 // used by the Qt model
-struct ModelNode;
 struct ModelValue : PresetAnd<Tags>
 {
-  // Pointers to the parents : this is required
-  // by the QAbstractItemModel
-  ModelNode* parent;
-  size_t index;
-
   QString toString() const
   {
     if( isPreset() )
@@ -334,21 +328,86 @@ struct ModelValue : PresetAnd<Tags>
   }
 };
 
-struct ModelNode : Node<ModelValue>
-{
-  // TODO : check that parent pointers have been computed
-  ModelNode() {}
-  ModelNode( const ReducedNode& o ) { this->assign( o ); }
-};
-void ComputeParents( ModelNode& item )
+// Unlike the other steps, the nodes are allocated one by one : their
+// address is used as QModelIndex::internalPointer() and must remain
+// valid while their siblings are inserted or removed (see Model::merge)
+struct ModelNode : JSONSerializable
 {
-  for( size_t i = 0; i<item.children.size(); i++ )
+  ModelValue value;
+  typedef std::vector<ModelNode*> Children;
+  Children children;
+
+  // Pointers to the parents : this is required
+  // by the QAbstractItemModel
+  ModelNode* parent;
+  size_t index;
+
+  ModelNode() : parent( NULL ), index( 0 ) {}
+  ModelNode( const Node< PresetAnd< Tags > >& o ) : parent( NULL ), index( 0 ) { this->assign( o ); }
+  ~ModelNode() { clear(); }
+
+  void assign( const Node< PresetAnd< Tags > >& o )
   {
-    item.children[i].value.parent = &item;
-    item.children[i].value.index = i;
-    ComputeParents( static_cast<ModelNode&>( item.children[i] ) );
+    this->value.assign( o.value );
+    for( size_t i = 0; i < o.children.size(); i++ )
+      this->adopt( new ModelNode( o.children[i] ) );
   }
-}
+
+  void adopt( ModelNode* child )
+  {
+    child->parent = this;
+    child->index = children.size();
+    children.push_back( child );
+  }
+
+  void clear()
+  {
+    for( size_t i = 0; i < children.size(); i++ )
+      delete children[i];
+    children.clear();
+  }
+
+  // Recomputes the indexes of the children, starting at "start"
+  void updateIndexes( size_t start )
+  {
+    for( size_t i = start; i < children.size(); i++ )
+    {
+      children[i]->parent = this;
+      children[i]->index = i;
+    }
+  }
+
+  // Identifies a node between two consecutive searches
+  std::string key() const
+  {
+    std::string dst;
+    if( value.isPreset() )
+      dst = value.getPreset().name;
+    dst += '|';
+    if( value.hasOther() )
+    {
+      const Tags& tags = value.getOther();
+      for( Tags::const_iterator it = tags.begin(); it != tags.end(); it++ )
+        dst += it->name + ' ';
+    }
+    return dst;
+  }
+
+  FTL::JSONValue* toJSON() const FTL_OVERRIDE
+  {
+    FTL::JSONObject* obj = new FTL::JSONObject();
+    obj->insert( "value", value.toJSON() );
+    FTL::JSONArray* ar = new FTL::JSONArray();
+    for( size_t i=0; i<children.size(); i++ )
+      ar->push_back( children[i]->toJSON() );
+    obj->insert( "children", ar );
+    return obj;
+  }
+
+private:
+  ModelNode( const ModelNode& );
+  ModelNode& operator=( const ModelNode& );
+};
 
 TmpNode BuildResultTree(
   const std::string& searchResult,
@@ -461,6 +520,16 @@ namespace Test
     return sum;
   }
 
+  size_t CountPresets( const ModelNode& n )
+  {
+    if( n.value.isPreset() )
+      return 1;
+    size_t sum = 0;
+    for( size_t i = 0; i < n.children.size(); i++ )
+      sum += CountPresets( *n.children[i] );
+    return sum;
+  }
+
   void Write( const std::string& filePath, const std::string& content )
   {
     std::ofstream file( filePath.data() );
@@ -511,7 +580,7 @@ void ResultsView::UnitTest( const std::string& logFolder )
   newCount = Test::LogTree( redNode, logFolder + "2_reduced.json" );
   assert( newCount == originalCount );
 
-  ModelNode modNode = redNode;
+  ModelNode modNode( redNode );
   newCount = Test::LogTree( modNode, logFolder + "3_final.json" );
   assert( newCount == originalCount );
 }
@@ -546,15 +615,15 @@ public:
       return QModelIndex();
     const ModelNode* parentItem = ( parent.isValid() ? cast( parent ) : &this->root );
     return ( row < int( parentItem->children.size() ) ?
-      this->createIndex( row, column, ( void* ) &( parentItem->children[row] ) )
+      this->createIndex( row, column, ( void* ) parentItem->children[row] )
       : QModelIndex() );
   }
   QModelIndex parent( const QModelIndex & child ) const FTL_OVERRIDE
   {
     if( !child.isValid() )
       return QModelIndex();
-    const ModelNode* parent = cast( child )->value.parent;
-    return ( parent == &root ? QModelIndex() : createIndex( int(parent->value.index), 0, (void*)parent ) );
+    const ModelNode* parent = cast( child )->parent;
+    return ( parent == &root ? QModelIndex() : createIndex( int(parent->index), 0, (void*)parent ) );
   }
   int rowCount( const QModelIndex & parent = QModelIndex() ) const FTL_OVERRIDE
   {
@@ -583,20 +652,84 @@ public:
   }
 
   void setRoot( const TmpNode& root ) {
-    this->beginResetModel();
     // Performing the 3 steps here (by converting each type)
     ReducedNode node( root );
+    ModelNode newRoot;
     if( node.value.isUndefined() )
-      this->root = node;
+      newRoot.assign( node );
     else
+      newRoot.adopt( new ModelNode( node ) );
+
+    // Rather than resetting the model (which would destroy all the
+    // widgets of the view), only the rows that differ are replaced
+    this->merge( this->root, newRoot, QModelIndex() );
+  }
+
+private:
+
+  // Moves the children of "src" into "dst", keeping the children
+  // of "dst" that are identical at the beginning and at the end
+  void merge( ModelNode& dst, ModelNode& src, const QModelIndex& dstIndex )
+  {
+    ModelNode::Children& oldChildren = dst.children;
+    ModelNode::Children& newChildren = src.children;
+    const size_t oldSize = oldChildren.size();
+    const size_t newSize = newChildren.size();
+
+    size_t prefix = 0;
+    while( prefix < oldSize && prefix < newSize
+      && oldChildren[prefix]->key() == newChildren[prefix]->key() )
+      prefix++;
+    size_t suffix = 0;
+    while( suffix < oldSize - prefix && suffix < newSize - prefix
+      && oldChildren[oldSize-1-suffix]->key() == newChildren[newSize-1-suffix]->key() )
+      suffix++;
+
+    // Updating the kept rows (their scores might have changed)
+    for( size_t i = 0; i < prefix; i++ )
+      mergeNode( *oldChildren[i], *newChildren[i], index( int(i), 0, dstIndex ) );
+    for( size_t i = 0; i < suffix; i++ )
+      mergeNode(
+        *oldChildren[oldSize-1-i],
+        *newChildren[newSize-1-i],
+        index( int(oldSize-1-i), 0, dstIndex )
+      );
+
+    // Replacing the rows in between
+    if( oldSize - suffix > prefix )
     {
-      this->root = ModelNode();
-      this->root.children.push_back( ModelNode( node ) );
+      this->beginRemoveRows( dstIndex, int(prefix), int(oldSize-suffix-1) );
+      for( size_t i = prefix; i < oldSize - suffix; i++ )
+        delete oldChildren[i];
+      oldChildren.erase( oldChildren.begin() + prefix, oldChildren.begin() + ( oldSize - suffix ) );
+      dst.updateIndexes( prefix );
+      this->endRemoveRows();
     }
-    ComputeParents( this->root );
-    this->endResetModel();
+    if( newSize - suffix > prefix )
+    {
+      this->beginInsertRows( dstIndex, int(prefix), int(newSize-suffix-1) );
+      oldChildren.insert(
+        oldChildren.begin() + prefix,
+        newChildren.begin() + prefix,
+        newChildren.begin() + ( newSize - suffix )
+      );
+      // These nodes now belong to "dst"
+      for( size_t i = prefix; i < newSize - suffix; i++ )
+        newChildren[i] = NULL;
+      dst.updateIndexes( prefix );
+      this->endInsertRows();
+    }
+  }
+
+  void mergeNode( ModelNode& dst, ModelNode& src, const QModelIndex& dstIndex )
+  {
+    dst.value = src.value;
+    emit dataChanged( dstIndex, dstIndex );
+    merge( dst, src, dstIndex );
   }
 
+public:
+
   inline bool hasNoResults() const { return rowCount() == 0; }
   inline bool hasSingleResult() const { return hasNoResults() ? false : isPreset( index( 0, 0 ) ); }
   inline bool hasSeveralResults() const { return !hasNoResults() && !hasSingleResult(); }
@@ -699,15 +832,20 @@ void ResultsView::onSelectionChanged()
 
 void ResultsView::setResults( const std::string& searchResult, const Query& query )
 {
-  // The ViewItems will become obsolete since ModelItems will be destroyed
-  m_presetViewItems.clear();
-  m_tagContainerItems.clear();
+  // The Tags displayed by the presets depend on the Tags of the
+  // Query : if these changed, the existing widgets are obsolete
+  if( query.getTags() != m_viewItemsQueryTags )
+  {
+    removeViewItems( QModelIndex() );
+    m_viewItemsQueryTags = query.getTags();
+  }
 
+  // Rows that didn't change keep their widgets : see Model::merge
   m_model->setRoot( BuildResultTree( searchResult, this->minPresetScore, this->maxPresetScore, query ) );
   this->expandAll();
 
 #if USE_CUSTOM_WIDGETS
-  replaceViewItems( query );
+  updateViewItems( query );
 #endif
 
   // Select the first result
@@ -718,6 +856,27 @@ void ResultsView::setResults( const std::string& searchResult, const Query& quer
   this->scrollToTop();
 }
 
+void ResultsView::rowsAboutToBeRemoved( const QModelIndex &parent, int start, int end )
+{
+  for( int i = start; i <= end; i++ )
+    removeViewItems( m_model->index( i, 0, parent ) );
+  Parent::rowsAboutToBeRemoved( parent, start, end );
+}
+
+void ResultsView::removeViewItems( const QModelIndex& index )
+{
+  if( index.isValid() )
+  {
+    void* ptr = index.internalPointer();
+    m_presetViewItems.erase( ptr );
+    m_tagContainerItems.erase( ptr );
+    setIndexWidget( index, NULL ); // Deletes the previous widget
+  }
+
+  for( int i = 0; i < m_model->rowCount( index ); i++ )
+    removeViewItems( m_model->index( i, 0, index ) );
+}
+
 const std::string& ResultsView::getSelectedPreset()
 {
   assert( m_model->isPreset( currentIndex() ) );
@@ -880,12 +1039,28 @@ public:
   }
 };
 
-void ResultsView::replaceViewItems( const Query& query, const QModelIndex& index )
+void ResultsView::updateViewItems( const Query& query, const QModelIndex& index )
 {
   // Setting a QWidget accordingly
   if( index.isValid() )
   {
     QWidget* widget = NULL;
+    PresetViewItems::const_iterator presetItem = m_presetViewItems.find( index.internalPointer() );
+    if( presetItem != m_presetViewItems.end() )
+    {
+      // Kept from the previous results : only the score range might have changed
+      presetItem->second->setScore(
+        m_model->getPreset( index ).score,
+        this->minPresetScore,
+        this->maxPresetScore
+      );
+    }
+    else
+    if( m_tagContainerItems.find( index.internalPointer() ) != m_tagContainerItems.end() )
+    {
+      // Kept from the previous results
+    }
+    else
     if( m_model->isPreset( index ) )
     {
       const Preset& preset = m_model->getPreset( index );
@@ -936,14 +1111,16 @@ void ResultsView::replaceViewItems( const Query& query, const QModelIndex& index
       m_tagContainerItems.insert( std::pair<void*, TagContainer*>( index.internalPointer(), w ) );
       widget = w;
     }
-    assert( widget != NULL );
-    widget->setMaximumHeight( sizeHintForIndex( index ).height() );
-    setIndexWidget( index, widget );
+    if( widget != NULL )
+    {
+      widget->setMaximumHeight( sizeHintForIndex( index ).height() );
+      setIndexWidget( index, widget );
+    }
   }
 
   // Applying recursively to the children
   for( int i = 0; i < model()->rowCount( index ); i++ )
-    replaceViewItems( query, model()->index( i, 0, index ) );
+    updateViewItems( query, model()->index( i, 0, index ) );
 }
 
 void ResultsView::updateHighlight( const QModelIndex& index )
@@ -56,6 +56,7 @@ namespace FabricUI
       protected slots:
       
         void currentChanged( const QModelIndex &, const QModelIndex & ) FTL_OVERRIDE;
+        void rowsAboutToBeRemoved( const QModelIndex &, int, int ) FTL_OVERRIDE;
 
       protected:
         void leaveEvent( QEvent * ) FTL_OVERRIDE;
@@ -67,7 +68,10 @@ namespace FabricUI
         void onSelectionChanged();
 
       private:
-        void replaceViewItems( const Query&, const QModelIndex& parent = QModelIndex() );
+        // Creates the widgets of the new items, and updates the existing ones
+        void updateViewItems( const Query&, const QModelIndex& parent = QModelIndex() );
+        // Deletes the widgets of an item and of its children
+        void removeViewItems( const QModelIndex& );
         const std::string& getSelectedPreset();
         class Model;
         Model* m_model;
@@ -80,6 +84,8 @@ namespace FabricUI
         class TagContainer;
         typedef std::map< void*, TagContainer* > TagContainerItems;
         TagContainerItems m_tagContainerItems;
+        // Tags of the Query used to build the widgets above
+        Query::Tags m_viewItemsQueryTags;
         double minPresetScore, maxPresetScore;
       };
     }
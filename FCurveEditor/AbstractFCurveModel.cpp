@@ -21,3 +21,12 @@ void AbstractFCurveModel::deleteKeys( const size_t* indices, const size_t nbIndi
   for( size_t i = nbIndices; i > 0; i-- )
     this->deleteKey( indices[i-1] );
 }
+
+void AbstractFCurveModel::evaluateRange( qreal t0, qreal t1, size_t n, qreal* out ) const
+{
+  if( n == 1 )
+    out[0] = this->evaluate( t0 );
+  else
+  for( size_t i = 0; i < n; i++ )
+    out[i] = this->evaluate( t0 + ( ( t1 - t0 ) * i ) / ( n - 1 ) );
+}
@@ -53,7 +53,9 @@ public:
   virtual void autoTangent( size_t ) = 0;
 
   virtual qreal evaluate( qreal v ) const = 0;
-  // TODO : evaluate arrays, to reduce the overhead
+  // evaluates n samples, evenly spaced from t0 to t1 (both included).
+  // Models with a per-call overhead should override it
+  virtual void evaluateRange( qreal t0, qreal t1, size_t n, qreal* out ) const;
 
   virtual void init() {}
   // update() will pull changes from the underlying model, and emit change signals
@@ -34,6 +34,12 @@ inline QPointF max( const QPointF& a, const QPointF& b )
 
 inline qreal len2( const QPointF& v ) { return v.x() * v.x() + v.y() * v.y(); }
 
+// Size (in pixels) of the first subdivision of the curve
+static const qreal TessellationStep = 16;
+// Maximum distance (in pixels) between the curve and its polyline
+static const qreal TessellationTolerance = 0.25;
+static const size_t TessellationMaxSubdivisions = 64;
+
 class FCurveItem::FCurveShape : public QGraphicsItem
 {
   const FCurveItem* m_parent;
@@ -105,6 +111,9 @@ public:
   FCurveShape( const FCurveItem* parent )
     : m_parent( parent )
     , m_boundingRectDirty( true )
+    , m_polylineT0( 0 )
+    , m_polylineT1( 0 )
+    , m_polylineDirty( true )
   {
     this->updateBoundingRect();
   }
@@ -167,70 +176,111 @@ public:
       }
 
       painter->setPen( pen );
-      const size_t n = widget->width() / 1;// 8;
       if( er.width() == 0 )
         return;
 
-      // drawing the FCurve as line segments
-      if( m_parent->m_curve->getKeyCount() <= 1 )
-        painter->drawLine(
-          QPointF( er.left(), m_parent->m_curve->evaluate( er.left() ) ),
-          QPointF( er.right(), m_parent->m_curve->evaluate( er.right() ) )
-        );
-      else
+      // The polyline is cached in curve space : it is only tessellated again
+      // when the curve changes, when the zoom changes, or when the view moves
+      // beyond the margins that were tessellated around it
+      const QTransform& t = painter->transform();
+      const QPointF scale( std::abs( t.m11() ), std::abs( t.m22() ) );
+      if( m_polylineDirty
+        || !SameScale( scale.x(), m_polylineScale.x() )
+        || !SameScale( scale.y(), m_polylineScale.y() )
+        || er.left() < m_polylineT0 || er.right() > m_polylineT1 )
+        this->tessellate( er.left() - er.width(), er.right() + er.width(), scale );
+
+      painter->drawPolyline( m_polyline );
+    }
+  }
+
+  inline void setPolylineDirty()
+  {
+    m_polylineDirty = true;
+    this->update();
+  }
+
+private:
+
+  QPolygonF m_polyline;
+  qreal m_polylineT0, m_polylineT1;
+  QPointF m_polylineScale; // pixels per curve unit
+  bool m_polylineDirty;
+  std::vector<qreal> m_samples, m_refinedSamples;
+
+  static inline bool SameScale( qreal a, qreal b )
+  {
+    return std::abs( a - b ) <= 1E-3 * std::max( std::abs( a ), std::abs( b ) );
+  }
+
+  void tessellate( qreal t0, qreal t1, QPointF scale )
+  {
+    const AbstractFCurveModel* curve = m_parent->m_curve;
+    m_polyline.clear();
+    if( curve->getKeyCount() <= 1 )
+      this->appendAdaptiveSamples( t0, t1, scale );
+    else
+    {
+      // from the left of the screen, to the first key
+      size_t firstKey = curve->getIndexAfterTime( t0 );
+      qreal firstKeyTime = curve->getOrderedKey( firstKey ).pos.x();
+      this->appendAdaptiveSamples( t0, std::min( firstKeyTime, t1 ), scale );
+
+      size_t lastKey = curve->getIndexAfterTime( t1 );
+      qreal lastKeyTime = curve->getOrderedKey( lastKey ).pos.x();
+
+      // all the middle keys
+      for( size_t i = firstKey; i < lastKey; i++ )
       {
-        // from the left of the screen, to the first key
-        size_t firstKey = m_parent->m_curve->getIndexAfterTime( er.left() );
-        qreal firstKeyTime = m_parent->m_curve->getOrderedKey( firstKey ).pos.x();
-        for( size_t i = 0; true; i++ )
-        {
-          qreal x1 = er.left() + ( i * er.width() ) / n;
-          if( x1 > firstKeyTime || x1 >= er.right() )
-            break;
-          qreal x2 = std::min( er.left() + ( ( i + 1 ) * er.width() ) / n, firstKeyTime );
-          painter->drawLine(
-            QPointF( x1, m_parent->m_curve->evaluate( x1 ) ),
-            QPointF( x2, m_parent->m_curve->evaluate( x2 ) )
-          );
-        }
+        qreal leftTime = curve->getOrderedKey( i ).pos.x();
+        qreal rightTime = curve->getOrderedKey( i + 1 ).pos.x();
+        this->appendAdaptiveSamples( std::max( leftTime, t0 ), std::min( rightTime, t1 ), scale );
+      }
 
-        size_t lastKey = m_parent->m_curve->getIndexAfterTime( er.right() );
-        qreal lastKeyTime = m_parent->m_curve->getOrderedKey( lastKey ).pos.x();
+      // from the last key to the right of the screen
+      this->appendAdaptiveSamples( std::max( lastKeyTime, t0 ), t1, scale );
+    }
+    m_polylineT0 = t0;
+    m_polylineT1 = t1;
+    m_polylineScale = scale;
+    m_polylineDirty = false;
+  }
 
-        // drawing all the middle keys
-        if( lastKey > 0 )
-        {
-          for( size_t i = firstKey; i < lastKey; i++ )
-          {
-            qreal leftTime = m_parent->m_curve->getOrderedKey( i ).pos.x();
-            qreal rightTime = m_parent->m_curve->getOrderedKey( i + 1 ).pos.x();
-            for( size_t j = 0; true; j++ )
-            {
-              const qreal x = leftTime + ( er.width() * j ) / n;
-              if( x >= rightTime || x >= er.right() )
-                break;
-              qreal x2 = std::min( rightTime, leftTime + ( er.width() * (j+1) ) / n );
-              painter->drawLine(
-                QPointF( x, m_parent->m_curve->evaluate( x ) ),
-                QPointF( x2, m_parent->m_curve->evaluate( x2 ) )
-              );
-            }
-          }
-        }
+  // Appends samples of the curve in [t0;t1] : the interval is first cut
+  // in pieces of TessellationStep pixels, evaluated at their ends and middle.
+  // Pieces whose middle is close enough to the chord (linear or flat
+  // tangents) are drawn as a single line, the others are subdivided
+  // according to their deviation.
+  void appendAdaptiveSamples( qreal t0, qreal t1, QPointF scale )
+  {
+    if( !( t1 > t0 ) )
+      return;
+    const AbstractFCurveModel* curve = m_parent->m_curve;
 
-        // from the last key to the right of the screen
-        for( size_t j = 0; true; j++ )
-        {
-          const qreal x = std::max( lastKeyTime, er.left() ) + ( er.width() * j ) / n;
-          if( x >= er.right() )
-            break;
-          qreal x2 = std::min( er.right(), lastKeyTime + ( er.width() * (j+1) ) / n );
-          painter->drawLine(
-            QPointF( x, m_parent->m_curve->evaluate( x ) ),
-            QPointF( x2, m_parent->m_curve->evaluate( x2 ) )
-          );
-        }
+    const size_t n = std::max( size_t( 1 ), size_t( std::ceil( ( t1 - t0 ) * scale.x() / TessellationStep ) ) );
+    m_samples.resize( 2 * n + 1 );
+    curve->evaluateRange( t0, t1, 2 * n + 1, &m_samples[0] );
+    const qreal dt = ( t1 - t0 ) / n;
+
+    m_polyline.push_back( QPointF( t0, m_samples[0] ) );
+    for( size_t i = 0; i < n; i++ )
+    {
+      const qreal x0 = t0 + dt * i;
+      const qreal x1 = ( i + 1 == n ? t1 : x0 + dt );
+      const qreal y0 = m_samples[2*i], yMid = m_samples[2*i+1], y1 = m_samples[2*i+2];
+
+      // For a parabola, the error is divided by k^2 when splitting in k pieces
+      const qreal error = std::abs( yMid - 0.5 * ( y0 + y1 ) ) * scale.y();
+      if( error > TessellationTolerance )
+      {
+        const size_t k = std::min( TessellationMaxSubdivisions,
+          size_t( std::ceil( std::sqrt( error / TessellationTolerance ) ) ) + 1 );
+        m_refinedSamples.resize( k + 1 );
+        curve->evaluateRange( x0, x1, k + 1, &m_refinedSamples[0] );
+        for( size_t j = 1; j < k; j++ )
+          m_polyline.push_back( QPointF( x0 + ( ( x1 - x0 ) * j ) / k, m_refinedSamples[j] ) );
       }
+      m_polyline.push_back( QPointF( x1, y1 ) );
     }
   }
 };
@@ -621,6 +671,7 @@ void FCurveItem::onKeyAdded()
 {
   this->addKey( m_keys.size() );
   m_curveShape->setBoundingRectDirty();
+  m_curveShape->setPolylineDirty();
 }
 
 void FCurveItem::onKeyDeleted( size_t i )
@@ -636,6 +687,7 @@ void FCurveItem::onKeyDeleted( size_t i )
   m_keys.resize( m_keys.size() - 1 );
 
   m_curveShape->setBoundingRectDirty();
+  m_curveShape->setPolylineDirty();
 }
 
 void FCurveItem::onKeyMoved( size_t i )
@@ -644,13 +696,14 @@ void FCurveItem::onKeyMoved( size_t i )
   assert( m_keys.size() == m_curve->getKeyCount() );
   m_keys[i]->setValue( m_curve->getKey( i ) );
   m_curveShape->setBoundingRectDirty();
+  m_curveShape->setPolylineDirty();
   if( m_selectedKeys.find( i ) != m_selectedKeys.end() )
     emit this->editedKeyValueChanged();
 }
 
 void FCurveItem::onInfinityTypesChanged()
 {
-  m_curveShape->update();
+  m_curveShape->setPolylineDirty();
   this->onDirty();
 }
 
@@ -677,6 +730,7 @@ void FCurveItem::setCurve( AbstractFCurveModel* curve )
     this->addKey( i );
 
   m_curveShape->setBoundingRectDirty();
+  m_curveShape->setPolylineDirty();
 }
 
 void FCurveItem::paint( QPainter * p, const QStyleOptionGraphicsItem * s, QWidget * w )
@@ -4,23 +4,43 @@
 
 #include "DFGAnimXFCurveModel.h"
 
-#include <FabricUI/Commands/CommandManager.h>
+#include <FabricUI/Commands/RTValCommandManager.h>
 #include <FabricUI/Commands/KLCommandRegistry.h> // HACK: remove
 
 #include <assert.h>
 
 using namespace FabricUI::FCurveEditor;
 
-inline void AddKeyValueToArgs( QMap<QString, QString>& args, const Key& k )
+// The args are passed as RTVals : the values are not
+// rounded by their string formatting and the commands
+// don't have to parse them, which matters during drags.
+typedef QMap<QString, FabricCore::RTVal> RTValArgs;
+
+inline void AddKeyValueToArgs( RTValArgs& args, FabricCore::Context ctx, const Key& k )
+{
+  args["time"] = FabricCore::RTVal::ConstructFloat64( ctx, k.pos.x() );
+  args["value"] = FabricCore::RTVal::ConstructFloat64( ctx, k.pos.y() );
+  args["tanInType"] = FabricCore::RTVal::ConstructUInt32( ctx, uint32_t( k.tanInType ) );
+  args["tanInX"] = FabricCore::RTVal::ConstructFloat64( ctx, k.tanIn.x() );
+  args["tanInY"] = FabricCore::RTVal::ConstructFloat64( ctx, k.tanIn.y() );
+  args["tanOutType"] = FabricCore::RTVal::ConstructUInt32( ctx, uint32_t( k.tanOutType ) );
+  args["tanOutX"] = FabricCore::RTVal::ConstructFloat64( ctx, k.tanOut.x() );
+  args["tanOutY"] = FabricCore::RTVal::ConstructFloat64( ctx, k.tanOut.y() );
+}
+
+inline FabricCore::RTVal ConstructPathValue( FabricCore::Context ctx, const QString& path )
 {
-  args["time"] = QString::number( k.pos.x() );
-  args["value"] = QString::number( k.pos.y() );
-  args["tanInType"] = QString::number( k.tanInType );
-  args["tanInX"] = QString::number( k.tanIn.x() );
-  args["tanInY"] = QString::number( k.tanIn.y() );
-  args["tanOutType"] = QString::number( k.tanOutType );
-  args["tanOutX"] = QString::number( k.tanOut.x() );
-  args["tanOutY"] = QString::number( k.tanOut.y() );
+  FabricCore::RTVal pathRV = FabricCore::RTVal::ConstructString( ctx, path.toUtf8().constData() );
+  return FabricCore::RTVal::Construct( ctx, "PathValue", 1, &pathRV );
+}
+
+inline FabricCore::RTVal ConstructIndices( FabricCore::Context ctx, const size_t* indices, const size_t nbIndices )
+{
+  FabricCore::RTVal indicesRV = FabricCore::RTVal::Construct( ctx, "UInt32[]", 0, NULL );
+  indicesRV.setArraySize( uint32_t( nbIndices ) );
+  for( size_t i = 0; i < nbIndices; i++ )
+    indicesRV.setArrayElement( uint32_t( i ), FabricCore::RTVal::ConstructUInt32( ctx, uint32_t( indices[i] ) ) );
+  return indicesRV;
 }
 
 inline void SynchronizeKLReg()
@@ -29,25 +49,38 @@ inline void SynchronizeKLReg()
     ->synchronizeKL(); // HACK : remove
 }
 
+inline void CreateCommand(
+  const QString& cmdName,
+  const RTValArgs& args,
+  int canMergeID = FabricUI::Commands::CommandManager::NoCanMergeID
+)
+{
+  // The AnimX commands are KL commands, which require a KLCommandManager
+  FabricUI::Commands::RTValCommandManager* manager = qobject_cast<FabricUI::Commands::RTValCommandManager*>(
+    FabricUI::Commands::CommandManager::getCommandManager() );
+  assert( manager != NULL );
+  manager->createCommand( cmdName, args, true, canMergeID );
+}
+
 void RTValAnimXFCurveDFGController::setPath( const char* dfgPath )
 {
-  m_dfgPath = "<" + QString(dfgPath) + ">";
+  m_dfgPath = dfgPath;
 }
 
 void RTValAnimXFCurveDFGController::setKey( size_t i, Key h, bool autoTangent )
 {
-  FabricUI::Commands::CommandManager* manager = FabricUI::Commands::CommandManager::getCommandManager();
   SynchronizeKLReg();
-  FabricCore::RTVal bRV = FabricCore::RTVal::ConstructBoolean( m_val.getContext(), true );
+  FabricCore::Context ctx = m_val.getContext();
+  FabricCore::RTVal bRV = FabricCore::RTVal::ConstructBoolean( ctx, true );
   const_cast<FabricCore::RTVal*>( &m_val )->callMethod( "", "useIds", 1, &bRV );
-  QMap<QString, QString> args;
-  args["target"] = m_dfgPath;
-  args["id"] = QString::number( i );
-  AddKeyValueToArgs( args, h );
-  args["interactionEnd"] = m_isInteracting ? "false" : "true";
-  args["autoTangent"] = autoTangent ? "true" : "false";
+  RTValArgs args;
+  args["target"] = ConstructPathValue( ctx, m_dfgPath );
+  args["id"] = FabricCore::RTVal::ConstructUInt32( ctx, uint32_t( i ) );
+  AddKeyValueToArgs( args, ctx, h );
+  args["interactionEnd"] = FabricCore::RTVal::ConstructBoolean( ctx, !m_isInteracting );
+  args["autoTangent"] = FabricCore::RTVal::ConstructBoolean( ctx, autoTangent );
   QString cmdName = "AnimX_SetKeyframe";
-  manager->createCommand( cmdName, args, true,
+  CreateCommand( cmdName, args,
     m_isInteracting ? m_interactionId : FabricUI::Commands::CommandManager::NoCanMergeID );
   m_lastCommand = cmdName;
   m_lastArgs = args;
@@ -64,33 +97,20 @@ void RTValAnimXFCurveDFGController::autoTangent( size_t i )
   this->setKey( i, this->getKey( i ), true );
 }
 
-inline QString SerializeQS( const size_t* indices, const size_t nbIndices )
-{
-  QString indicesStr = "[";
-  for( size_t i = 0; i < nbIndices; i++ )
-  {
-    if( i > 0 )
-      indicesStr += ",";
-    indicesStr += QString::number( indices[i] );
-  }
-  indicesStr += "]";
-  return indicesStr;
-}
-
 void RTValAnimXFCurveDFGController::moveKeys( const size_t* indices, const size_t nbIndices, QPointF delta )
 {
-  FabricUI::Commands::CommandManager* manager = FabricUI::Commands::CommandManager::getCommandManager();
   SynchronizeKLReg();
-  FabricCore::RTVal bRV = FabricCore::RTVal::ConstructBoolean( m_val.getContext(), true );
+  FabricCore::Context ctx = m_val.getContext();
+  FabricCore::RTVal bRV = FabricCore::RTVal::ConstructBoolean( ctx, true );
   const_cast<FabricCore::RTVal*>( &m_val )->callMethod( "", "useIds", 1, &bRV );
-  QMap<QString, QString> args;
-  args["target"] = m_dfgPath;
-  args["ids"] = SerializeQS( indices, nbIndices );
-  args["dx"] = QString::number( delta.x() );
-  args["dy"] = QString::number( delta.y() );
-  args["interactionEnd"] = m_isInteracting ? "false" : "true";
+  RTValArgs args;
+  args["target"] = ConstructPathValue( ctx, m_dfgPath );
+  args["ids"] = ConstructIndices( ctx, indices, nbIndices );
+  args["dx"] = FabricCore::RTVal::ConstructFloat64( ctx, delta.x() );
+  args["dy"] = FabricCore::RTVal::ConstructFloat64( ctx, delta.y() );
+  args["interactionEnd"] = FabricCore::RTVal::ConstructBoolean( ctx, !m_isInteracting );
   QString cmdName = "AnimX_MoveKeyframes";
-  manager->createCommand( cmdName, args, true, m_interactionId );
+  CreateCommand( cmdName, args, m_interactionId );
   m_lastCommand = cmdName;
   m_lastArgs = args;
   emit this->dirty();
@@ -98,64 +118,67 @@ void RTValAnimXFCurveDFGController::moveKeys( const size_t* indices, const size_
 
 void RTValAnimXFCurveDFGController::addKey( Key k, bool useKey, bool autoTangent )
 {
-  FabricUI::Commands::CommandManager* manager = FabricUI::Commands::CommandManager::getCommandManager();
   SynchronizeKLReg();
-  QMap<QString, QString> args;
-  args["target"] = m_dfgPath;
+  FabricCore::Context ctx = m_val.getContext();
+  RTValArgs args;
+  args["target"] = ConstructPathValue( ctx, m_dfgPath );
   if( useKey )
-    AddKeyValueToArgs( args, k );
-  args["autoTangent"] = autoTangent ? "true" : "false";
-  manager->createCommand( "AnimX_PushKeyframe", args );
+    AddKeyValueToArgs( args, ctx, k );
+  args["autoTangent"] = FabricCore::RTVal::ConstructBoolean( ctx, autoTangent );
+  CreateCommand( "AnimX_PushKeyframe", args );
   emit this->dirty();
 }
 
 void RTValAnimXFCurveDFGController::deleteKey( size_t i )
 {
-  FabricUI::Commands::CommandManager* manager = FabricUI::Commands::CommandManager::getCommandManager();
   SynchronizeKLReg();
-  QMap<QString, QString> args;
-  args["target"] = m_dfgPath;
-  args["id"] = QString::number( i );
-  manager->createCommand( "AnimX_RemoveKeyframe", args );
+  FabricCore::Context ctx = m_val.getContext();
+  RTValArgs args;
+  args["target"] = ConstructPathValue( ctx, m_dfgPath );
+  args["id"] = FabricCore::RTVal::ConstructUInt32( ctx, uint32_t( i ) );
+  CreateCommand( "AnimX_RemoveKeyframe", args );
   emit this->dirty();
 }
 
 void RTValAnimXFCurveDFGController::deleteKeys( const size_t* indices, const size_t nbIndices )
 {
-  FabricUI::Commands::CommandManager* manager = FabricUI::Commands::CommandManager::getCommandManager();
   SynchronizeKLReg();
-  QMap<QString, QString> args;
-  args["target"] = m_dfgPath;
-  args["ids"] = SerializeQS( indices, nbIndices );
-  manager->createCommand( "AnimX_RemoveKeyframes", args );
+  FabricCore::Context ctx = m_val.getContext();
+  RTValArgs args;
+  args["target"] = ConstructPathValue( ctx, m_dfgPath );
+  args["ids"] = ConstructIndices( ctx, indices, nbIndices );
+  CreateCommand( "AnimX_RemoveKeyframes", args );
   emit this->dirty();
 }
 
 void RTValAnimXFCurveDFGController::setPreInfinityType( size_t i )
 {
-  FabricUI::Commands::CommandManager* manager = FabricUI::Commands::CommandManager::getCommandManager();
   SynchronizeKLReg();
-  QMap<QString, QString> args;
-  args["target"] = m_dfgPath;
-  args["type"] = QString::number( i );
-  manager->createCommand( "AnimX_SetPreInfinityType", args );
+  FabricCore::Context ctx = m_val.getContext();
+  RTValArgs args;
+  args["target"] = ConstructPathValue( ctx, m_dfgPath );
+  args["type"] = FabricCore::RTVal::ConstructUInt32( ctx, uint32_t( i ) );
+  CreateCommand( "AnimX_SetPreInfinityType", args );
   emit this->dirty();
 }
 
 void RTValAnimXFCurveDFGController::setPostInfinityType( size_t i )
 {
-  FabricUI::Commands::CommandManager* manager = FabricUI::Commands::CommandManager::getCommandManager();
   SynchronizeKLReg();
-  QMap<QString, QString> args;
-  args["target"] = m_dfgPath;
-  args["type"] = QString::number( i );
-  manager->createCommand( "AnimX_SetPostInfinityType", args );
+  FabricCore::Context ctx = m_val.getContext();
+  RTValArgs args;
+  args["target"] = ConstructPathValue( ctx, m_dfgPath );
+  args["type"] = FabricCore::RTVal::ConstructUInt32( ctx, uint32_t( i ) );
+  CreateCommand( "AnimX_SetPostInfinityType", args );
   emit this->dirty();
 }
 
 void RTValAnimXFCurveDFGController::onInteractionBegin()
 {
-  m_interactionId = FabricUI::Commands::CommandManager::getCommandManager()->getNewCanMergeID();
+  FabricUI::Commands::CommandManager* manager = FabricUI::Commands::CommandManager::getCommandManager();
+  m_interactionId = manager->getNewCanMergeID();
+  // The steps of the interaction are only logged once, when it ends
+  manager->beginInteraction( m_interactionId );
   m_isInteracting = true;
 }
 
@@ -164,12 +187,14 @@ void RTValAnimXFCurveDFGController::onInteractionEnd()
   m_isInteracting = false;
   if( !m_lastCommand.isEmpty() )
   {
-    FabricUI::Commands::CommandManager* manager = FabricUI::Commands::CommandManager::getCommandManager();
     SynchronizeKLReg();
-    QMap<QString, QString> args = m_lastArgs;
-    args["interactionEnd"] = "true";
-    manager->createCommand( m_lastCommand, args, true, m_interactionId );
+    RTValArgs args = m_lastArgs;
+    args["interactionEnd"] = FabricCore::RTVal::ConstructBoolean( m_val.getContext(), true );
+    // The commands may have modified the previous PathValue
+    args["target"] = ConstructPathValue( m_val.getContext(), m_dfgPath );
+    CreateCommand( m_lastCommand, args, m_interactionId );
     m_lastCommand = "";
     emit this->dirty();
   }
+  FabricUI::Commands::CommandManager::getCommandManager()->endInteraction( m_interactionId );
 }
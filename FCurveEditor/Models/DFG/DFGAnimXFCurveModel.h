@@ -24,7 +24,7 @@ class RTValAnimXFCurveDFGController : public RTValAnimXFCurveVersionedConstModel
   bool m_isInteracting;
 
   QString m_lastCommand;
-  QMap<QString, QString> m_lastArgs;
+  QMap<QString, FabricCore::RTVal> m_lastArgs;
 
 public:
 
@@ -272,25 +272,21 @@ void BackDropNode::mouseReleaseEvent(QGraphicsSceneMouseEvent * event)
 
 void BackDropNode::appendOverlappingNodes( std::vector<Node*> &nodes ) const
 {
-  std::vector<Node *> all = graph()->nodes();
+  // the candidates and their rects are in graph coordinates
+  QRectF rect = mapRectToParent(boundingRect());
+  std::vector<Node *> candidates = graph()->nodesInRect(rect);
 
-  QPointF topLeft = mapToScene(boundingRect().topLeft());
-  QPointF bottomRight = mapToScene(boundingRect().bottomRight());
-  QRectF rect(topLeft, bottomRight);
-
-  for(size_t i=0;i<all.size();i++)
+  for(size_t i=0;i<candidates.size();i++)
   {
-    if ( all[i]->isBackDropNode() )
+    if ( candidates[i]->isBackDropNode() )
       continue;
-    if(all[i]->selected())
+    if(candidates[i]->selected())
       continue;
 
-    QPointF topLeft2 = all[i]->mapToScene(all[i]->boundingRect().topLeft());
-    QPointF bottomRight2 = all[i]->mapToScene(all[i]->boundingRect().bottomRight());
-    QRectF rect2(topLeft2, bottomRight2);
+    QRectF rect2 = candidates[i]->mapRectToParent(candidates[i]->boundingRect());
 
     if(rect.contains(rect2))
-      nodes.push_back(all[i]);
+      nodes.push_back(candidates[i]);
   }
 }
 
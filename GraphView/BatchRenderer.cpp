@@ -0,0 +1,212 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#include <FabricUI/GraphView/BatchRenderer.h>
+#include <FabricUI/GraphView/Connection.h>
+#include <FabricUI/GraphView/Graph.h>
+#include <FabricUI/GraphView/MainPanel.h>
+#include <FabricUI/GraphView/Node.h>
+
+#include <QGLContext>
+#include <QGLFormat>
+#include <QPaintDevice>
+#include <QTransform>
+
+using namespace FabricUI::GraphView;
+
+BatchRenderer::BatchRenderer( Graph * graph )
+  : m_graph( graph )
+  , m_dirty( true )
+{
+}
+
+bool BatchRenderer::IsSupported()
+{
+  if ( !QGLContext::currentContext() )
+    return false;
+
+  // client-side vertex arrays and the fixed function
+  // pipeline are not available on OpenGL ES 2
+  return ( QGLFormat::openGLVersionFlags() & QGLFormat::OpenGL_Version_1_1 ) != 0;
+}
+
+void BatchRenderer::AppendRect(
+  VertexArray &triangles,
+  QRectF const &rect,
+  QColor const &color
+  )
+{
+  Vertex v;
+  v.r = GLubyte( color.red() );
+  v.g = GLubyte( color.green() );
+  v.b = GLubyte( color.blue() );
+  v.a = GLubyte( color.alpha() );
+
+  QPointF const corners[6] =
+  {
+    rect.topLeft(), rect.topRight(), rect.bottomRight(),
+    rect.topLeft(), rect.bottomRight(), rect.bottomLeft()
+  };
+  for ( int i = 0; i < 6; i++ )
+  {
+    v.x = GLfloat( corners[i].x() );
+    v.y = GLfloat( corners[i].y() );
+    triangles.push_back( v );
+  }
+}
+
+void BatchRenderer::AppendOutline(
+  VertexArray &lines,
+  QRectF const &rect,
+  QColor const &color
+  )
+{
+  QPolygonF polygon;
+  polygon << rect.topLeft() << rect.topRight()
+    << rect.bottomRight() << rect.bottomLeft() << rect.topLeft();
+  AppendPolyline( lines, polygon, color );
+}
+
+void BatchRenderer::AppendPolyline(
+  VertexArray &lines,
+  QPolygonF const &polygon,
+  QColor const &color
+  )
+{
+  Vertex v;
+  v.r = GLubyte( color.red() );
+  v.g = GLubyte( color.green() );
+  v.b = GLubyte( color.blue() );
+  v.a = GLubyte( color.alpha() );
+
+  // GL_LINES rather than a strip per polyline : everything
+  // goes in a single draw call
+  for ( int i = 1; i < polygon.size(); i++ )
+  {
+    v.x = GLfloat( polygon[i - 1].x() );
+    v.y = GLfloat( polygon[i - 1].y() );
+    lines.push_back( v );
+    v.x = GLfloat( polygon[i].x() );
+    v.y = GLfloat( polygon[i].y() );
+    lines.push_back( v );
+  }
+}
+
+void BatchRenderer::appendNode( Node * node )
+{
+  // block nodes don't have a plain rectangle
+  if ( node->isBlockNode() || !node->isVisible() )
+    return;
+
+  GraphConfig const &config = m_graph->config();
+
+  // same rect as NodeRectangle::paint, in graph coordinates
+  QRectF rect = node->mapRectToParent( node->mainWidget()->geometry() );
+  float nodeWidthReduction = config.nodeWidthReduction * 0.5;
+  rect.adjust( nodeWidthReduction, 0, -nodeWidthReduction, 0 );
+
+  QColor color = node->isInspected() ? node->inspectedPen().color() : node->color();
+  AppendRect(
+    node->isBackDropNode() ? m_backDropTriangles : m_nodeTriangles,
+    rect,
+    color
+    );
+
+  if ( node->selected() )
+    AppendOutline( m_outlineLines, rect, node->selectedPen().color() );
+}
+
+void BatchRenderer::appendConnection( Connection * connection )
+{
+  if ( !connection->isVisible() )
+    return;
+
+  QColor color = connection->pen().color();
+  if ( connection->isDimmed() )
+    color.setAlphaF( color.alphaF() * 0.15 );
+
+  // the path is already up to date (see Graph::updateDirtyConnections),
+  // only flatten its curve
+  QList<QPolygonF> polygons = connection->path().toSubpathPolygons(
+    QTransform::fromTranslate( connection->pos().x(), connection->pos().y() )
+    );
+  for ( int i = 0; i < polygons.size(); i++ )
+    AppendPolyline( m_connectionLines, polygons[i], color );
+}
+
+void BatchRenderer::rebuild()
+{
+  m_backDropTriangles.clear();
+  m_connectionLines.clear();
+  m_nodeTriangles.clear();
+  m_outlineLines.clear();
+
+  std::vector<Node *> nodes = m_graph->nodes();
+  for ( size_t i = 0; i < nodes.size(); i++ )
+    appendNode( nodes[i] );
+
+  std::vector<Connection *> connections = m_graph->connections();
+  for ( size_t i = 0; i < connections.size(); i++ )
+    appendConnection( connections[i] );
+
+  m_dirty = false;
+}
+
+void BatchRenderer::DrawArray( VertexArray const &vertices, GLenum mode )
+{
+  if ( vertices.empty() )
+    return;
+  glVertexPointer( 2, GL_FLOAT, sizeof( Vertex ), &vertices[0].x );
+  glColorPointer( 4, GL_UNSIGNED_BYTE, sizeof( Vertex ), &vertices[0].r );
+  glDrawArrays( mode, 0, GLsizei( vertices.size() ) );
+}
+
+void BatchRenderer::draw( QPainter * painter )
+{
+  if ( m_dirty )
+    rebuild();
+
+  // graph coordinates -> device coordinates
+  QTransform t =
+    m_graph->mainPanel()->itemGroup()->sceneTransform() * painter->transform();
+  GLfloat const modelView[16] =
+  {
+    GLfloat( t.m11() ), GLfloat( t.m12() ), 0, GLfloat( t.m13() ),
+    GLfloat( t.m21() ), GLfloat( t.m22() ), 0, GLfloat( t.m23() ),
+    0, 0, 1, 0,
+    GLfloat( t.dx() ), GLfloat( t.dy() ), 0, GLfloat( t.m33() )
+  };
+
+  QPaintDevice * device = painter->device();
+
+  glMatrixMode( GL_PROJECTION );
+  glPushMatrix();
+  glLoadIdentity();
+  glOrtho( 0, device->width(), device->height(), 0, -1, 1 );
+  glMatrixMode( GL_MODELVIEW );
+  glPushMatrix();
+  glLoadMatrixf( modelView );
+
+  glDisable( GL_DEPTH_TEST );
+  glDisable( GL_TEXTURE_2D );
+  glEnable( GL_BLEND );
+  glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+  glEnable( GL_LINE_SMOOTH );
+  glLineWidth( GLfloat( qMax( 1.0, m_graph->config().connectionDefaultPen.widthF() ) ) );
+
+  glEnableClientState( GL_VERTEX_ARRAY );
+  glEnableClientState( GL_COLOR_ARRAY );
+
+  DrawArray( m_backDropTriangles, GL_TRIANGLES );
+  DrawArray( m_connectionLines, GL_LINES );
+  DrawArray( m_nodeTriangles, GL_TRIANGLES );
+  DrawArray( m_outlineLines, GL_LINES );
+
+  glDisableClientState( GL_COLOR_ARRAY );
+  glDisableClientState( GL_VERTEX_ARRAY );
+
+  glDisable( GL_LINE_SMOOTH );
+  glMatrixMode( GL_PROJECTION );
+  glPopMatrix();
+  glMatrixMode( GL_MODELVIEW );
+  glPopMatrix();
+}
@@ -0,0 +1,85 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#ifndef __UI_GraphView_BatchRenderer__
+#define __UI_GraphView_BatchRenderer__
+
+#include <QGLWidget>
+#include <QColor>
+#include <QPainter>
+#include <QPolygonF>
+#include <QRectF>
+
+#include <vector>
+
+namespace FabricUI
+{
+
+  namespace GraphView
+  {
+    // forward declarations
+    class Graph;
+    class Node;
+    class Connection;
+
+    // Draws the node rectangles and the connections of a Graph as a few
+    // batches of OpenGL geometry, instead of painting each item through
+    // QPainter. It is used by the GraphViewWidget when its viewport is a
+    // QGLWidget and the graph is zoomed out to LevelOfDetail_Rectangle,
+    // where nothing else of the nodes is shown: very large graphs then
+    // cost four draw calls. The QGraphicsItems are kept as they are for
+    // the interaction and skip their own painting (see
+    // Graph::isBatchRendering).
+    // The geometry is kept in graph coordinates and only rebuilt once
+    // invalidated. Only the fixed function pipeline and client-side vertex
+    // arrays are used, so that it also runs on software implementations
+    // (eg Mesa's llvmpipe with LIBGL_ALWAYS_SOFTWARE=1).
+    class BatchRenderer
+    {
+    public:
+
+      BatchRenderer( Graph * graph );
+
+      // whether the current OpenGL context can run the renderer
+      static bool IsSupported();
+
+      // the geometry will be rebuilt before the next draw
+      void invalidate()
+        { m_dirty = true; }
+
+      // to be called while the painter's GL context is current,
+      // between QPainter::beginNativePainting and endNativePainting
+      void draw( QPainter * painter );
+
+    private:
+
+      struct Vertex
+      {
+        GLfloat x, y;
+        GLubyte r, g, b, a;
+      };
+      typedef std::vector<Vertex> VertexArray;
+
+      void rebuild();
+      void appendNode( Node * node );
+      void appendConnection( Connection * connection );
+
+      static void AppendRect( VertexArray &triangles, QRectF const &rect, QColor const &color );
+      static void AppendOutline( VertexArray &lines, QRectF const &rect, QColor const &color );
+      static void AppendPolyline( VertexArray &lines, QPolygonF const &polygon, QColor const &color );
+      static void DrawArray( VertexArray const &vertices, GLenum mode );
+
+      Graph * m_graph;
+      bool m_dirty;
+
+      // in drawing order
+      VertexArray m_backDropTriangles;
+      VertexArray m_connectionLines;
+      VertexArray m_nodeTriangles;
+      VertexArray m_outlineLines;
+    };
+
+  };
+
+};
+
+#endif // __UI_GraphView_BatchRenderer__
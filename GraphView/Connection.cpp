@@ -44,6 +44,8 @@ Connection::Connection(
   , m_dragging( false )
   , m_aboutToBeDeleted( false )
   , m_hasSelectedTarget( false )
+  , m_pathDirty( false )
+  , m_shapeDirty( true )
 {
   bool isExposedConnectionSrc = (   m_src->targetType() == TargetType_Port
                                  || m_src->targetType() == TargetType_FixedPort
@@ -140,7 +142,7 @@ Connection::Connection(
 
   setZValue(-1);
 
-  dependencyMoved();
+  updatePath();
   dependencySelected();
 
   MainPanel *mainPanel = graph->mainPanel();
@@ -441,8 +443,22 @@ void Connection::mouseMoveEvent(QGraphicsSceneMouseEvent * event)
     QGraphicsPathItem::mouseMoveEvent(event);
 }
 
+bool Connection::isDimmed() const
+{
+  if (m_src->path() == m_dst->path() && !m_dragging && m_src->isRealPort() && m_dst->isRealPort())
+    return true;
+  return m_isExposedConnection && !m_hovered && !m_hasSelectedTarget && m_graph->config().dimConnectionLines;
+}
+
 void Connection::paint(QPainter * painter, const QStyleOptionGraphicsItem * option, QWidget * widget)
 {
+  // drawn by the view along with the others (see BatchRenderer),
+  // except the one being dragged which isn't part of the graph
+  if (   m_graph->isBatchRendering()
+      && m_src->targetType() != TargetType_MouseGrabber
+      && m_dst->targetType() != TargetType_MouseGrabber )
+    return;
+
   float radius = m_graph->config().pinRadius;
   if (!m_dst || m_dst->isDragging())
   {
@@ -501,11 +517,40 @@ void Connection::paint(QPainter * painter, const QStyleOptionGraphicsItem * opti
 
 QPainterPath Connection::shape() const
 {
+  // while nodes are dragged nothing needs a precise hit-test,
+  // so don't rebuild the shape for every single move
+  if (m_graph->isDraggingNodes())
+  {
+    QPainterPath path;
+    path.addRect(boundingRect());
+    return path;
+  }
+
+  if (m_shapeDirty)
+  {
+    m_shapePath = computeShapePath();
+    m_shapeDirty = false;
+  }
   return m_shapePath;
 }
 
 void Connection::dependencyMoved()
 {
+  // the paths are rebuilt by the graph, once for all
+  // the moves that happened since the last event loop pass
+  m_shapeDirty = true;
+  if (!m_pathDirty)
+  {
+    m_pathDirty = true;
+    m_graph->markConnectionDirty(this);
+  }
+}
+
+void Connection::updatePath()
+{
+  m_pathDirty = false;
+  m_shapeDirty = true;
+
   QPointF srcPnt = srcPoint();
   QPointF dstPnt = dstPoint();
 
@@ -543,120 +588,123 @@ void Connection::dependencyMoved()
     setPath(path);
   }
 
-  // create and set the path that is used
-  // as the QGraphicsPathItem's shape.
+  if (m_isExposedConnection)
   {
-    QPainterPath path;
+    m_clipPath = QPainterPath();
+    m_clipPath.addEllipse(srcPnt, m_clipRadius, m_clipRadius);
+    m_clipPath.addEllipse(dstPnt, m_clipRadius, m_clipRadius);
+  }
+}
 
-    qreal w = m_shapePathWidth;
-    qreal x = 0.5 * (dstPnt.x() - srcPnt.x());
+QPainterPath Connection::computeShapePath() const
+{
+  QPointF srcPnt = srcPoint();
+  QPointF dstPnt = dstPoint();
 
-    if (   m_graph->config().connectionDrawAsCurves
-        || m_isExposedConnection )
+  // the path that is used as the QGraphicsPathItem's shape.
+  QPainterPath path;
+
+  qreal w = m_shapePathWidth;
+  qreal x = 0.5 * (dstPnt.x() - srcPnt.x());
+
+  if (   m_graph->config().connectionDrawAsCurves
+      || m_isExposedConnection )
+  {
+    if (srcPnt.x() < dstPnt.x())
     {
-      if (srcPnt.x() < dstPnt.x())
+      if (srcPnt.y() < dstPnt.y())
       {
-        if (srcPnt.y() < dstPnt.y())
-        {
-          path.moveTo ( srcPnt + QPointF(       0, + w ) );
-          path.cubicTo( srcPnt + QPointF( + x - w, + w ),
-                        dstPnt + QPointF( - x - w, + w ),
-                        dstPnt + QPointF(       0, + w ) );
-          path.lineTo ( dstPnt + QPointF(       0, - w ) );
-          path.cubicTo( dstPnt + QPointF( - x + w, - w ),
-                        srcPnt + QPointF( + x + w, - w ),
-                        srcPnt + QPointF(       0, - w ) );
-        }
-        else
-        {
-          path.moveTo ( srcPnt + QPointF(       0, + w ) );
-          path.cubicTo( srcPnt + QPointF( + x + w, + w ),
-                        dstPnt + QPointF( - x + w, + w ),
-                        dstPnt + QPointF(       0, + w ) );
-          path.lineTo ( dstPnt + QPointF(       0, - w ) );
-          path.cubicTo( dstPnt + QPointF( - x - w, - w ),
-                        srcPnt + QPointF( + x - w, - w ),
-                        srcPnt + QPointF(       0, - w ) );
-        }
+        path.moveTo ( srcPnt + QPointF(       0, + w ) );
+        path.cubicTo( srcPnt + QPointF( + x - w, + w ),
+                      dstPnt + QPointF( - x - w, + w ),
+                      dstPnt + QPointF(       0, + w ) );
+        path.lineTo ( dstPnt + QPointF(       0, - w ) );
+        path.cubicTo( dstPnt + QPointF( - x + w, - w ),
+                      srcPnt + QPointF( + x + w, - w ),
+                      srcPnt + QPointF(       0, - w ) );
       }
       else
       {
-        QPointF s( dstPnt.y() - srcPnt.y(), -(dstPnt.x() - srcPnt.x()) );
-        qreal len = sqrt(s.x() * s.x() + s.y() * s.y());
-        if (len > 0)
-        {
-          s *= w / len;
+        path.moveTo ( srcPnt + QPointF(       0, + w ) );
+        path.cubicTo( srcPnt + QPointF( + x + w, + w ),
+                      dstPnt + QPointF( - x + w, + w ),
+                      dstPnt + QPointF(       0, + w ) );
+        path.lineTo ( dstPnt + QPointF(       0, - w ) );
+        path.cubicTo( dstPnt + QPointF( - x - w, - w ),
+                      srcPnt + QPointF( + x - w, - w ),
+                      srcPnt + QPointF(       0, - w ) );
+      }
+    }
+    else
+    {
+      QPointF s( dstPnt.y() - srcPnt.y(), -(dstPnt.x() - srcPnt.x()) );
+      qreal len = sqrt(s.x() * s.x() + s.y() * s.y());
+      if (len > 0)
+      {
+        s *= w / len;
 
-          path.moveTo( srcPnt + s );
-          path.lineTo( dstPnt + s );
-          path.lineTo( dstPnt - s );
-          path.lineTo( srcPnt - s );
-        }
+        path.moveTo( srcPnt + s );
+        path.lineTo( dstPnt + s );
+        path.lineTo( dstPnt - s );
+        path.lineTo( srcPnt - s );
+      }
+    }
+  }
+  else
+  {
+    if (srcPnt.x() < dstPnt.x())
+    {
+      if (srcPnt.y() < dstPnt.y())
+      {
+        path.moveTo( srcPnt + QPointF(       0, + w ) );
+        path.lineTo( srcPnt + QPointF( + x - w, + w ) );
+        path.lineTo( dstPnt + QPointF( - x - w, + w ) );
+        path.lineTo( dstPnt + QPointF(       0, + w ) );
+        path.lineTo( dstPnt + QPointF(       0, - w ) );
+        path.lineTo( dstPnt + QPointF( - x + w, - w ) );
+        path.lineTo( srcPnt + QPointF( + x + w, - w ) );
+        path.lineTo( srcPnt + QPointF(       0, - w ) );
+      }
+      else
+      {
+        path.moveTo( srcPnt + QPointF(       0, + w ) );
+        path.lineTo( srcPnt + QPointF( + x + w, + w ) );
+        path.lineTo( dstPnt + QPointF( - x + w, + w ) );
+        path.lineTo( dstPnt + QPointF(       0, + w ) );
+        path.lineTo( dstPnt + QPointF(       0, - w ) );
+        path.lineTo( dstPnt + QPointF( - x - w, - w ) );
+        path.lineTo( srcPnt + QPointF( + x - w, - w ) );
+        path.lineTo( srcPnt + QPointF(       0, - w ) );
       }
     }
     else
     {
-      if (srcPnt.x() < dstPnt.x())
+      if (srcPnt.y() < dstPnt.y())
       {
-        if (srcPnt.y() < dstPnt.y())
-        {
-          path.moveTo( srcPnt + QPointF(       0, + w ) );
-          path.lineTo( srcPnt + QPointF( + x - w, + w ) );
-          path.lineTo( dstPnt + QPointF( - x - w, + w ) );
-          path.lineTo( dstPnt + QPointF(       0, + w ) );
-          path.lineTo( dstPnt + QPointF(       0, - w ) );
-          path.lineTo( dstPnt + QPointF( - x + w, - w ) );
-          path.lineTo( srcPnt + QPointF( + x + w, - w ) );
-          path.lineTo( srcPnt + QPointF(       0, - w ) );
-        }
-        else
-        {
-          path.moveTo( srcPnt + QPointF(       0, + w ) );
-          path.lineTo( srcPnt + QPointF( + x + w, + w ) );
-          path.lineTo( dstPnt + QPointF( - x + w, + w ) );
-          path.lineTo( dstPnt + QPointF(       0, + w ) );
-          path.lineTo( dstPnt + QPointF(       0, - w ) );
-          path.lineTo( dstPnt + QPointF( - x - w, - w ) );
-          path.lineTo( srcPnt + QPointF( + x - w, - w ) );
-          path.lineTo( srcPnt + QPointF(       0, - w ) );
-        }
+        path.moveTo( srcPnt + QPointF(       0, - w ) );
+        path.lineTo( srcPnt + QPointF( + x - w, - w ) );
+        path.lineTo( dstPnt + QPointF( - x - w, - w ) );
+        path.lineTo( dstPnt + QPointF(       0, - w ) );
+        path.lineTo( dstPnt + QPointF(       0, + w ) );
+        path.lineTo( dstPnt + QPointF( - x + w, + w ) );
+        path.lineTo( srcPnt + QPointF( + x + w, + w ) );
+        path.lineTo( srcPnt + QPointF(       0, + w ) );
       }
       else
       {
-        if (srcPnt.y() < dstPnt.y())
-        {
-          path.moveTo( srcPnt + QPointF(       0, - w ) );
-          path.lineTo( srcPnt + QPointF( + x - w, - w ) );
-          path.lineTo( dstPnt + QPointF( - x - w, - w ) );
-          path.lineTo( dstPnt + QPointF(       0, - w ) );
-          path.lineTo( dstPnt + QPointF(       0, + w ) );
-          path.lineTo( dstPnt + QPointF( - x + w, + w ) );
-          path.lineTo( srcPnt + QPointF( + x + w, + w ) );
-          path.lineTo( srcPnt + QPointF(       0, + w ) );
-        }
-        else
-        {
-          path.moveTo( srcPnt + QPointF(       0, - w ) );
-          path.lineTo( srcPnt + QPointF( + x + w, - w ) );
-          path.lineTo( dstPnt + QPointF( - x + w, - w ) );
-          path.lineTo( dstPnt + QPointF(       0, - w ) );
-          path.lineTo( dstPnt + QPointF(       0, + w ) );
-          path.lineTo( dstPnt + QPointF( - x - w, + w ) );
-          path.lineTo( srcPnt + QPointF( + x - w, + w ) );
-          path.lineTo( srcPnt + QPointF(       0, + w ) );
-        }
+        path.moveTo( srcPnt + QPointF(       0, - w ) );
+        path.lineTo( srcPnt + QPointF( + x + w, - w ) );
+        path.lineTo( dstPnt + QPointF( - x + w, - w ) );
+        path.lineTo( dstPnt + QPointF(       0, - w ) );
+        path.lineTo( dstPnt + QPointF(       0, + w ) );
+        path.lineTo( dstPnt + QPointF( - x - w, + w ) );
+        path.lineTo( srcPnt + QPointF( + x - w, + w ) );
+        path.lineTo( srcPnt + QPointF(       0, + w ) );
       }
     }
-
-    m_shapePath = path;
   }
 
-  if (m_isExposedConnection)
-  {
-    m_clipPath = QPainterPath();
-    m_clipPath.addEllipse(srcPnt, m_clipRadius, m_clipRadius);
-    m_clipPath.addEllipse(dstPnt, m_clipRadius, m_clipRadius);
-  }
+  return path;
 }
 
 void Connection::dependencySelected()
@@ -70,12 +70,17 @@ namespace FabricUI
       virtual QPainterPath shape() const;
 
       bool isHovered()  { return m_hovered; }
+      // drawn with a low opacity (see paint)
+      bool isDimmed() const;
 
       void enableToolTip(bool state)
         { setToolTip(state ? m_tooltip : QString()); }
 
       void setCosmetic( bool );
 
+      // rebuilds the painted path, called by Graph::updateDirtyConnections
+      void updatePath();
+
     public slots:
 
       virtual void dependencyMoved();
@@ -97,6 +102,7 @@ namespace FabricUI
       bool m_cosmeticPen;
       bool m_hovered;
       void updatePen();
+      QPainterPath computeShapePath() const;
 
       bool m_dragging;
       bool m_draggingInput; // or Output
@@ -106,7 +112,10 @@ namespace FabricUI
       bool m_hasSelectedTarget;
       float m_clipRadius;
       QPainterPath m_clipPath;
-      QPainterPath m_shapePath;
+      bool m_pathDirty;
+      // the shape is only built when hit-testing needs it
+      mutable bool m_shapeDirty;
+      mutable QPainterPath m_shapePath;
 
       QString m_tooltip;
     };
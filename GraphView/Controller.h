@@ -173,6 +173,9 @@ namespace FabricUI
       virtual QMenu* gvcCreateNodeHeaderMenu( Node * node, ConnectionTarget * other, PortType nodeRole ) { return NULL; }
       virtual QMenu* gvcCreateInstBlockHeaderMenu( InstBlock *instBlock, ConnectionTarget *other, PortType nodeRole ) { return NULL; }
       virtual std::string gvcEncodeMetadaToPersistValue() { return ""; }
+      // Builds the pins and connections that are still being loaded,
+      // before the connections of several nodes are walked
+      virtual void gvcCompleteGraphLoad() {}
 
     virtual void collapseNodes(int state, const std::vector<Node*> & nodes);
     virtual void collapseSelectedNodes(int state);
@@ -31,7 +31,12 @@ Graph::Graph(
   )
   : QGraphicsWidget(parent)
   , m_config( config )
+  , m_nodeGrid( config.nodeGridCellSize )
   , m_cosmeticConnections( true )
+  , m_levelOfDetail( LevelOfDetail_Full )
+  , m_batchRendering( false )
+  , m_sceneItemIndexBracket( 0 )
+  , m_nodesDragBracket( 0 )
 {
   m_isEditable = true;
 
@@ -166,6 +171,7 @@ Node * Graph::addNode(Node * node, bool quiet)
 
   m_nodeMap.insert(std::pair<FTL::StrRef, size_t>(key, m_nodes.size()));
   m_nodes.push_back(node);
+  m_nodeGrid.update(node, node->mapRectToParent(node->boundingRect()));
 
   double * zValue;
   if(node->isBackDropNode())
@@ -175,6 +181,7 @@ Node * Graph::addNode(Node * node, bool quiet)
 
   node->setZValue(*zValue);
   (*zValue) += 0.0001;
+  node->setLevelOfDetail(m_levelOfDetail);
   if(node->bubble())
   {
     node->bubble()->setZValue(*zValue);
@@ -265,6 +272,48 @@ BackDropNode *Graph::addBackDropNode(
 }
 
 bool Graph::removeNode(Node * node, bool quiet)
+{
+  if(!removeNodeInternal(node, quiet))
+    return false;
+
+  // recreate the overlay info
+  if(m_nodes.size() == 0 && m_centralOverlayText.length() > 0)
+    setCentralOverlayText(m_centralOverlayText);
+
+  resetSceneItemIndex();
+
+  return true;
+}
+
+unsigned Graph::removeNodes(FTL::ArrayRef<Node *> nodes, bool quiet)
+{
+  if(nodes.empty())
+    return 0;
+
+  // the scene's BSP is dropped for the whole batch and rebuilt once,
+  // rather than after every pin and node removal
+  beginSceneItemIndexBracket();
+  controller()->beginInteraction();
+
+  unsigned removedCount = 0;
+  for(size_t i=0;i<nodes.size();i++)
+  {
+    if(removeNodeInternal(nodes[i], quiet))
+      ++removedCount;
+  }
+
+  controller()->endInteraction();
+
+  // recreate the overlay info
+  if(m_nodes.size() == 0 && m_centralOverlayText.length() > 0)
+    setCentralOverlayText(m_centralOverlayText);
+
+  endSceneItemIndexBracket();
+
+  return removedCount;
+}
+
+bool Graph::removeNodeInternal(Node * node, bool quiet)
 {
   FTL::StrRef key = node->name();
   std::map<FTL::StrRef, size_t>::iterator it = m_nodeMap.find(key);
@@ -299,16 +348,18 @@ bool Graph::removeNode(Node * node, bool quiet)
 
   controller()->beginInteraction();
 
+  // swap the last node into the freed slot so that
+  // only its lookup entry needs to be updated
   size_t index = it->second;
-  m_nodes.erase(m_nodes.begin() + index);
   m_nodeMap.erase(it);
-
-  // update the lookup
-  for(it = m_nodeMap.begin(); it != m_nodeMap.end(); it++)
+  m_nodeGrid.remove(node);
+  if(index + 1 < m_nodes.size())
   {
-    if(it->second > index)
-      it->second--;
+    Node *lastNode = m_nodes.back();
+    m_nodes[index] = lastNode;
+    m_nodeMap[lastNode->name()] = index;
   }
+  m_nodes.pop_back();
 
   if(!quiet)
     emit nodeRemoved(node);
@@ -319,15 +370,75 @@ bool Graph::removeNode(Node * node, bool quiet)
 
   controller()->endInteraction();
 
-  // recreate the overlay info
-  if(m_nodes.size() == 0 && m_centralOverlayText.length() > 0)
-    setCentralOverlayText(m_centralOverlayText);
+  return true;
+}
 
+void Graph::resetSceneItemIndex()
+{
   // [pzion 20160222] Workaround for possible bug in QGraphicsScene
+  // Within a bracket the scene has no index, so there is nothing to reset
+  if(m_sceneItemIndexBracket > 0)
+    return;
   scene()->setItemIndexMethod( QGraphicsScene::NoIndex );
   scene()->setItemIndexMethod( QGraphicsScene::BspTreeIndex );
+}
 
-  return true;
+void Graph::beginSceneItemIndexBracket()
+{
+  if(m_sceneItemIndexBracket++ == 0)
+    scene()->setItemIndexMethod( QGraphicsScene::NoIndex );
+}
+
+void Graph::endSceneItemIndexBracket()
+{
+  assert(m_sceneItemIndexBracket > 0);
+  if(--m_sceneItemIndexBracket == 0)
+    scene()->setItemIndexMethod( QGraphicsScene::BspTreeIndex );
+}
+
+void Graph::markConnectionDirty( Connection * connection )
+{
+  if( m_dirtyConnections.empty() )
+    QMetaObject::invokeMethod( this, "updateDirtyConnections", Qt::QueuedConnection );
+  m_dirtyConnections.push_back( connection );
+}
+
+void Graph::updateDirtyConnections()
+{
+  std::vector< QPointer<Connection> > dirtyConnections;
+  dirtyConnections.swap( m_dirtyConnections );
+  for( size_t i = 0; i < dirtyConnections.size(); i++ )
+  {
+    // the connection might have been deleted in the meantime
+    if( Connection * connection = dirtyConnections[i] )
+      connection->updatePath();
+  }
+}
+
+void Graph::beginNodesDrag()
+{
+  m_nodesDragBracket++;
+}
+
+void Graph::endNodesDrag()
+{
+  // the exact connection shapes are built again when next hit-tested
+  assert(m_nodesDragBracket > 0);
+  m_nodesDragBracket--;
+}
+
+std::vector<Node *> Graph::nodesInRect( QRectF const &rect ) const
+{
+  std::vector<Node *> result;
+  m_nodeGrid.query( rect, result );
+  return result;
+}
+
+void Graph::updateNodeGridEntry( Node * node )
+{
+  // nodes only enter the grid once added to the graph
+  if( m_nodeGrid.contains( node ) )
+    m_nodeGrid.update( node, node->mapRectToParent( node->boundingRect() ) );
 }
 
 std::vector<Node *> Graph::nodes() const
@@ -537,34 +648,73 @@ std::vector<Connection *> Graph::connections() const
   return m_connections;
 }
 
-bool Graph::isConnected(const ConnectionTarget * target) const
+std::vector<Connection *> const &Graph::connectionsFrom(const ConnectionTarget * src) const
 {
-  for(size_t i=0;i<m_connections.size();i++)
+  static std::vector<Connection *> const empty;
+  ConnectionAdjacency::const_iterator it = m_connectionsBySrc.find(src);
+  if(it == m_connectionsBySrc.end())
+    return empty;
+  return it->second;
+}
+
+std::vector<Connection *> const &Graph::connectionsTo(const ConnectionTarget * dst) const
+{
+  static std::vector<Connection *> const empty;
+  ConnectionAdjacency::const_iterator it = m_connectionsByDst.find(dst);
+  if(it == m_connectionsByDst.end())
+    return empty;
+  return it->second;
+}
+
+void Graph::indexConnection(Connection * connection)
+{
+  m_connectionsBySrc[connection->src()].push_back(connection);
+  m_connectionsByDst[connection->dst()].push_back(connection);
+}
+
+static void UnindexConnection(
+  std::map< ConnectionTarget const *, std::vector<Connection *> > &adjacency,
+  ConnectionTarget const *target,
+  Connection * connection
+  )
+{
+  std::map< ConnectionTarget const *, std::vector<Connection *> >::iterator it =
+    adjacency.find(target);
+  if(it == adjacency.end())
+    return;
+
+  std::vector<Connection *> &connections = it->second;
+  for(size_t i=0;i<connections.size();i++)
   {
-    if(m_connections[i]->dst() == target || m_connections[i]->src() == target)
-      return true;
+    if(connections[i] == connection)
+    {
+      connections.erase(connections.begin() + i);
+      break;
+    }
   }
-  return false;
+  if(connections.empty())
+    adjacency.erase(it);
+}
+
+void Graph::unindexConnection(Connection * connection)
+{
+  UnindexConnection(m_connectionsBySrc, connection->src(), connection);
+  UnindexConnection(m_connectionsByDst, connection->dst(), connection);
+}
+
+bool Graph::isConnected(const ConnectionTarget * target) const
+{
+  return isConnectedAsSource(target) || isConnectedAsTarget(target);
 }
 
 bool Graph::isConnectedAsSource(const ConnectionTarget * target) const
 {
-  for(size_t i=0;i<m_connections.size();i++)
-  {
-    if(m_connections[i]->src() == target)
-      return true;
-  }
-  return false;
+  return m_connectionsBySrc.find(target) != m_connectionsBySrc.end();
 }
 
 bool Graph::isConnectedAsTarget(const ConnectionTarget * target) const
 {
-  for(size_t i=0;i<m_connections.size();i++)
-  {
-    if(m_connections[i]->dst() == target)
-      return true;
-  }
-  return false;
+  return m_connectionsByDst.find(target) != m_connectionsByDst.end();
 }
 
 void Graph::updateColorForConnections(const ConnectionTarget * target) const
@@ -574,13 +724,13 @@ void Graph::updateColorForConnections(const ConnectionTarget * target) const
   if(target == NULL)
     return;
 
-  for(size_t i=0;i<m_connections.size();i++)
-  {
-    if(m_connections[i]->dst() == target || m_connections[i]->src() == target)
-    {
-      m_connections[i]->setColor(target->color());
-    }
-  }
+  std::vector<Connection *> const &srcConnections = connectionsFrom(target);
+  for(size_t i=0;i<srcConnections.size();i++)
+    srcConnections[i]->setColor(target->color());
+
+  std::vector<Connection *> const &dstConnections = connectionsTo(target);
+  for(size_t i=0;i<dstConnections.size();i++)
+    dstConnections[i]->setColor(target->color());
 }
 
 bool Graph::connect(ConnectionTarget * source, ConnectionTarget * target)
@@ -675,9 +825,10 @@ Connection * Graph::addConnection(ConnectionTarget * src, ConnectionTarget * dst
     return NULL;
 
   // make sure this connection does not exist yet
-  for(size_t i=0;i<m_connections.size();i++)
+  std::vector<Connection *> const &srcConnections = connectionsFrom(src);
+  for(size_t i=0;i<srcConnections.size();i++)
   {
-    if(m_connections[i]->src() == src && m_connections[i]->dst() == dst)
+    if(srcConnections[i]->dst() == dst)
       return NULL;
   }
 
@@ -686,6 +837,7 @@ Connection * Graph::addConnection(ConnectionTarget * src, ConnectionTarget * dst
 
   Connection * connection = new Connection(this, src, dst);
   m_connections.push_back(connection);
+  indexConnection(connection);
   connection->setCosmetic( m_cosmeticConnections );
 
   if(connection->src()->targetType() == TargetType_Pin)
@@ -729,11 +881,12 @@ Connection * Graph::addConnection(ConnectionTarget * src, ConnectionTarget * dst
 
 bool Graph::removeConnection(ConnectionTarget * src, ConnectionTarget * dst, bool quiet)
 {
-  for(size_t i=0;i<m_connections.size();i++)
+  std::vector<Connection *> const &srcConnections = connectionsFrom(src);
+  for(size_t i=0;i<srcConnections.size();i++)
   {
-    if(m_connections[i]->src() == src && m_connections[i]->dst() == dst)
+    if(srcConnections[i]->dst() == dst)
     {
-      return removeConnection(m_connections[i], quiet);
+      return removeConnection(srcConnections[i], quiet);
     }
   }
   return false;
@@ -774,22 +927,12 @@ bool Graph::removeConnection(Connection * connection, bool quiet)
   }
 
   m_connections.erase(m_connections.begin() + index);
+  unindexConnection(connection);
   if(!quiet)
     emit connectionRemoved(connection);
 
   if(daisyChainPin)
-  {
-    bool found = false;
-    for(size_t i=0;i<m_connections.size();i++)
-    {
-      if(m_connections[i]->src() == daisyChainPin)
-      {
-        found = true;
-        break;
-      }
-    }
-    daisyChainPin->setDaisyChainCircleVisible(found);
-  }
+    daisyChainPin->setDaisyChainCircleVisible(isConnectedAsSource(daisyChainPin));
 
   prepareGeometryChange();
   connection->invalidate();
@@ -825,6 +968,9 @@ bool Graph::removeConnection(Connection * connection, bool quiet)
 
 bool Graph::autoConnections()
 {
+  // the already connected pins are skipped
+  controller()->gvcCompleteGraphLoad();
+
   // get the selected nodes and create an array of arrays of vertical node groups.
   std::vector<Node *>              selectedNodes = Graph::selectedNodes();
   std::vector< std::vector<Node *> > nodeGroups;
@@ -994,11 +1140,32 @@ void Graph::setConnectionsCosmetic( bool cosmetic )
   }
 }
 
+void Graph::setLevelOfDetail( LevelOfDetail lod )
+{
+  if( m_levelOfDetail == lod )
+    return;
+  m_levelOfDetail = lod;
+  for( size_t i = 0; i < m_nodes.size(); i++ )
+    m_nodes[i]->setLevelOfDetail( m_levelOfDetail );
+}
+
+void Graph::setBatchRendering( bool batchRendering )
+{
+  if( m_batchRendering == batchRendering )
+    return;
+  m_batchRendering = batchRendering;
+  if( scene() )
+    scene()->update();
+}
+
 void Graph::exposeAllPorts(bool exposeUnconnectedInputs, bool exposeUnconnectedOutputs)
 {
   if (!exposeUnconnectedInputs && !exposeUnconnectedOutputs)
     return;
 
+  // the already connected pins are skipped
+  controller()->gvcCompleteGraphLoad();
+
   std::vector<Node *> nodes = selectedNodes();
 
   // sort the nodes from top
@@ -1289,6 +1456,7 @@ void Graph::removeConnectionsForConnectionTarget( ConnectionTarget *target )
     if ( con->src() == target || con->dst() == target )
     {
       m_connections.erase( m_connections.begin() + i );
+      unindexConnection( con );
       break;
     }
   }
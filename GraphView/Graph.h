@@ -8,10 +8,14 @@
 #include <QColor>
 #include <QPen>
 #include <QMenu>
+#include <QPointer>
 
+#include <FTL/ArrayRef.h>
 #include <FTL/StrRef.h>
 
 #include <FabricUI/GraphView/GraphConfig.h>
+#include <FabricUI/GraphView/LevelOfDetail.h>
+#include <FabricUI/GraphView/NodeGrid.h>
 #include <FabricUI/GraphView/PortType.h>
 #include <FabricUI/Util/QString_Conversion.h>
 
@@ -109,6 +113,10 @@ namespace FabricUI
       virtual bool isConnectedAsSource(const ConnectionTarget * target) const;
       virtual bool isConnectedAsTarget(const ConnectionTarget * target) const;
       virtual void updateColorForConnections(const ConnectionTarget * target) const;
+      // connections leaving / arriving at a given target, kept up to date
+      // by addConnection and removeConnection
+      std::vector<Connection *> const &connectionsFrom(const ConnectionTarget * src) const;
+      std::vector<Connection *> const &connectionsTo(const ConnectionTarget * dst) const;
 
       // context menus
       // menus are consumed by the graph, so they are destroyed after use.
@@ -158,6 +166,33 @@ namespace FabricUI
         );
       virtual BackDropNode * addBackDropNode( FTL::CStrRef name, bool quiet = false );
       virtual bool removeNode(Node * node, bool quiet = false);
+      // removes several nodes at once, returns the number actually removed
+      virtual unsigned removeNodes(FTL::ArrayRef<Node *> nodes, bool quiet = false);
+
+      // [pzion 20160216] Workaround for possible bug in QGraphicsScene:
+      // the scene's BSP is rebuilt after items are removed. Within a
+      // bracket the scene is not indexed and the BSP is rebuilt once at
+      // the end of the outermost bracket.
+      void resetSceneItemIndex();
+      void beginSceneItemIndexBracket();
+      void endSceneItemIndexBracket();
+
+      // Connection paths are not rebuilt on each move of their endpoints:
+      // the connection is queued here and all the queued paths are
+      // rebuilt once, when the event loop gets back to the graph.
+      void markConnectionDirty( Connection * connection );
+
+      // Brackets a drag of nodes (see Node::onMouseMove). While dragging,
+      // the connections use their bounding rect as a cheap hit-test shape.
+      void beginNodesDrag();
+      void endNodesDrag();
+      bool isDraggingNodes() const { return m_nodesDragBracket > 0; }
+
+      // the nodes whose rect, in graph coordinates, intersects the given one.
+      // The spatial index is kept up to date by the nodes as they are
+      // moved and resized (see Node::itemChange, Node::resizeEvent).
+      std::vector<Node *> nodesInRect( QRectF const &rect ) const;
+      void updateNodeGridEntry( Node * node );
 
       void addFixedPort( FixedPort *fixedPort );
       std::vector<FixedPort *> fixedPorts() const;
@@ -175,6 +210,15 @@ namespace FabricUI
       virtual void resetMouseGrabber();
       void setConnectionsCosmetic( bool cosmetic );
       inline bool cosmeticConnections() const { return m_cosmeticConnections; }
+      // applied to all the nodes, set by the MainPanel based on the zoom
+      void setLevelOfDetail( LevelOfDetail lod );
+      inline LevelOfDetail levelOfDetail() const { return m_levelOfDetail; }
+      // set by the GraphViewWidget when it can draw the node rectangles and
+      // the connections itself (see BatchRenderer). At the Rectangle level
+      // of detail those items then skip their own painting.
+      void setBatchRendering( bool batchRendering );
+      inline bool isBatchRendering() const
+        { return m_batchRendering && m_levelOfDetail == LevelOfDetail_Rectangle; }
       bool connect(ConnectionTarget * source, ConnectionTarget * target);
       void exposeAllPorts(bool exposeUnconnectedInputs, bool exposeUnconnectedOutputs);
 
@@ -209,13 +253,30 @@ namespace FabricUI
       // FE-6926  : Shift + double-clicking in an empty space "Goes up"
       void goUpPressed();
 
+    private slots:
+
+      void updateDirtyConnections();
+
     private:
 
+      typedef std::map<
+        ConnectionTarget const *,
+        std::vector<Connection *>
+        > ConnectionAdjacency;
+
+      bool removeNodeInternal(Node * node, bool quiet);
+
+      void indexConnection(Connection * connection);
+      void unindexConnection(Connection * connection);
+
       GraphConfig m_config;
       Controller * m_controller;
       std::vector<Node *> m_nodes;
       std::map<FTL::StrRef, size_t> m_nodeMap;
+      NodeGrid m_nodeGrid;
       std::vector<Connection *> m_connections;
+      ConnectionAdjacency m_connectionsBySrc;
+      ConnectionAdjacency m_connectionsByDst;
       MouseGrabber * m_mouseGrabber;
       MainPanel * m_mainPanel;
       SidePanel * m_leftPanel;
@@ -245,6 +306,11 @@ namespace FabricUI
       double m_backdropZValue;
       double m_connectionZValue;
       bool m_cosmeticConnections;
+      LevelOfDetail m_levelOfDetail;
+      bool m_batchRendering;
+      unsigned m_sceneItemIndexBracket;
+      std::vector< QPointer<Connection> > m_dirtyConnections;
+      unsigned m_nodesDragBracket;
     };
 
   };
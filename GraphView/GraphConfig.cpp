@@ -5,6 +5,8 @@
 #include <FTL/Config.h>
 #include <FabricUI/Util/Config.h>
 
+#include <map>
+
 using namespace FabricUI::GraphView;
 using namespace FTL;
 
@@ -69,6 +71,7 @@ GraphConfig::GraphConfig()
 #else
   useOpenGL = true;
 #endif
+  useBatchRendering = true;
 
   Util::Config rootConfig;
   Util::ConfigSection& cfg = rootConfig.getOrCreateSection( "GraphView" );
@@ -100,6 +103,8 @@ GraphConfig::GraphConfig()
   GET_PARAMETER( mainPanelNodeSnapDistance, 20 );
   GET_PARAMETER( mainPanelPortSnap, true );
   GET_PARAMETER( mainPanelPortSnapDistance, 20 );
+  GET_PARAMETER( layoutColumnSpacing, 40.0f );
+  GET_PARAMETER( layoutRowSpacing, 10.0f );
   GET_PARAMETER( mainPanelGridPen, QPen(QColor(44, 44, 44, 255), 1.0) );
 
   GET_PARAMETER( mainPanelBackGroundPanFixed, true );
@@ -161,6 +166,12 @@ GraphConfig::GraphConfig()
   GET_PARAMETER( nodeShadowOffset, QPointF(2.5, 2.5) );
   GET_PARAMETER( nodeShadowBlurRadius, 10.0 );
 
+  GET_PARAMETER( nodeLODEnabled, true );
+  GET_PARAMETER( nodeLODNoLabelsZoom, 0.5f );
+  GET_PARAMETER( nodeLODHeaderOnlyZoom, 0.3f );
+  GET_PARAMETER( nodeLODRectangleZoom, 0.15f );
+  GET_PARAMETER( nodeGridCellSize, 400.0f );
+
   GET_PARAMETER( nodeHeaderButtonSeparator, 2.0f );
   GET_PARAMETER( nodeHeaderButtonIconDir, QString("${FABRIC_DIR}/Resources/Icons/") );
 
@@ -244,3 +255,17 @@ GraphConfig::GraphConfig()
   GET_PARAMETER( blockNodeDefaultColor, QColor(193, 189, 138) );
   GET_PARAMETER( blockLabelDefaultColor, QColor(158, 153, 98) );
 }
+
+QFontMetrics const &GraphConfig::FontMetrics( QFont const &font )
+{
+  typedef std::map<QString, QFontMetrics> FontMetricsMap;
+  static FontMetricsMap s_fontMetrics;
+
+  QString key = font.key();
+  FontMetricsMap::iterator it = s_fontMetrics.find( key );
+  if ( it == s_fontMetrics.end() )
+    it = s_fontMetrics.insert(
+      FontMetricsMap::value_type( key, QFontMetrics( font ) )
+      ).first;
+  return it->second;
+}
@@ -6,6 +6,7 @@
 #include <QColor>
 #include <QPen>
 #include <QFont>
+#include <QFontMetrics>
 
 namespace FabricUI
 {
@@ -16,6 +17,8 @@ namespace FabricUI
     struct GraphConfig
     {
       bool useOpenGL;
+      // with OpenGL, draw the zoomed out graph in batches (see BatchRenderer)
+      bool useBatchRendering;
       
       char const *pathSep;
       bool disconnectInputsAutomatically;
@@ -38,6 +41,10 @@ namespace FabricUI
       int mainPanelNodeSnapDistance;
       bool mainPanelPortSnap;
       int mainPanelPortSnapDistance;
+      // spacing between the columns and the rows of nodes laid out by
+      // GraphLayout (see DFGController::relaxNodes)
+      float layoutColumnSpacing;
+      float layoutRowSpacing;
       QPen mainPanelGridPen;
       bool mainPanelBackGroundPanFixed;
 
@@ -83,6 +90,16 @@ namespace FabricUI
       QPointF nodeShadowOffset;
       float nodeShadowBlurRadius;
 
+      // levels of detail (see LevelOfDetail.h) : below
+      // each zoom level, less details of the nodes are shown
+      bool nodeLODEnabled;
+      float nodeLODNoLabelsZoom;
+      float nodeLODHeaderOnlyZoom;
+      float nodeLODRectangleZoom;
+
+      // size of the cells of the spatial index of the nodes (see NodeGrid)
+      float nodeGridCellSize;
+
       float nodeHeaderButtonSeparator;
       QString nodeHeaderButtonIconDir;
 
@@ -134,6 +151,11 @@ namespace FabricUI
       QColor blockLabelDefaultColor;
 
       GraphConfig();
+
+      // Building a QFontMetrics is not free, and the items of a graph all
+      // use one of the few fonts above : their metrics are built once and
+      // shared by every item (and every graph) using the same font.
+      static QFontMetrics const &FontMetrics( QFont const &font );
     };
 
   };
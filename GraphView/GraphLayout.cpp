@@ -0,0 +1,505 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#include "GraphLayout.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace FabricUI::GraphView;
+
+namespace
+{
+  // Beyond that many dummy nodes per real node, the longest connections
+  // are left out of the ordering of the layers
+  static const unsigned MaxDummyNodesPerNode = 8;
+
+  static const unsigned MaxOrderingSweeps = 12;
+
+  // weight of the dummy nodes when placing a layer vertically
+  static const float DummyNodeWeight = 0.25f;
+
+  inline bool ReportProgress(
+    GraphLayout::ProgressCallback progressCallback,
+    void *userData,
+    float progress
+    )
+  {
+    return !progressCallback || progressCallback( userData, progress );
+  }
+
+  struct OrderEntry
+  {
+    float key;
+    unsigned order;
+    unsigned node;
+
+    bool operator<( OrderEntry const &other ) const
+    {
+      if ( key != other.key )
+        return key < other.key;
+      return order < other.order;
+    }
+  };
+
+  struct PlacementBlock
+  {
+    float sum;
+    float weight;
+    unsigned count;
+
+    float mean() const
+      { return sum / weight; }
+  };
+}
+
+GraphLayout::GraphLayout(
+  float columnSpacing,
+  float rowSpacing
+  )
+  : m_columnSpacing( columnSpacing )
+  , m_rowSpacing( rowSpacing )
+  , m_realNodeCount( 0 )
+{
+}
+
+void GraphLayout::swap( GraphLayout &other )
+{
+  std::swap( m_columnSpacing, other.m_columnSpacing );
+  std::swap( m_rowSpacing, other.m_rowSpacing );
+  std::swap( m_realNodeCount, other.m_realNodeCount );
+  m_nodes.swap( other.m_nodes );
+  m_connections.swap( other.m_connections );
+  m_layers.swap( other.m_layers );
+}
+
+unsigned GraphLayout::addNode(
+  QPointF topLeftPos,
+  QSizeF size,
+  bool isRoot
+  )
+{
+  // the dummy nodes of a previous run are dropped
+  m_nodes.resize( m_realNodeCount );
+
+  LayoutNode node;
+  node.pos = topLeftPos;
+  node.size = size;
+  node.isRoot = isRoot;
+  node.isDummy = false;
+  node.layer = 0;
+  node.order = 0;
+  m_nodes.push_back( node );
+
+  return m_realNodeCount++;
+}
+
+void GraphLayout::addConnection( unsigned srcNode, unsigned dstNode )
+{
+  if ( srcNode == dstNode )
+    return;
+  m_connections.push_back( std::pair<unsigned, unsigned>( srcNode, dstNode ) );
+}
+
+bool GraphLayout::run(
+  ProgressCallback progressCallback,
+  void *userData
+  )
+{
+  m_nodes.resize( m_realNodeCount );
+  m_layers.clear();
+
+  // several pins can connect the same nodes
+  std::sort( m_connections.begin(), m_connections.end() );
+  m_connections.erase(
+    std::unique( m_connections.begin(), m_connections.end() ),
+    m_connections.end()
+    );
+
+  for ( unsigned i = 0; i < m_realNodeCount; ++i )
+  {
+    m_nodes[i].srcs.clear();
+    m_nodes[i].dsts.clear();
+  }
+  for ( size_t i = 0; i < m_connections.size(); ++i )
+  {
+    unsigned src = m_connections[i].first;
+    unsigned dst = m_connections[i].second;
+    m_nodes[dst].srcs.push_back( src );
+    m_nodes[src].dsts.push_back( dst );
+  }
+
+  assignLayers();
+  if ( !ReportProgress( progressCallback, userData, 0.1f ) )
+    return false;
+
+  splitLongConnections();
+  if ( !ReportProgress( progressCallback, userData, 0.2f ) )
+    return false;
+
+  bool aborted = false;
+  orderLayers( progressCallback, userData, aborted );
+  if ( aborted )
+    return false;
+
+  assignCoordinates();
+  ReportProgress( progressCallback, userData, 1.0f );
+  return true;
+}
+
+void GraphLayout::assignLayers()
+{
+  // longest path towards the roots, visiting a node once all the nodes
+  // it feeds have been visited
+  std::vector<size_t> pendingDsts( m_realNodeCount, 0 );
+  std::vector<bool> visited( m_realNodeCount, false );
+  std::vector<unsigned> queue;
+  queue.reserve( m_realNodeCount );
+
+  for ( unsigned i = 0; i < m_realNodeCount; ++i )
+  {
+    LayoutNode &node = m_nodes[i];
+    node.layer = 0;
+    if ( node.isRoot || node.dsts.empty() )
+      queue.push_back( i );
+    else
+      pendingDsts[i] = node.dsts.size();
+  }
+
+  for ( size_t head = 0; head < queue.size(); ++head )
+  {
+    unsigned index = queue[head];
+    visited[index] = true;
+
+    std::vector<unsigned> const &srcs = m_nodes[index].srcs;
+    for ( size_t i = 0; i < srcs.size(); ++i )
+    {
+      LayoutNode &src = m_nodes[srcs[i]];
+      if ( src.isRoot )
+        continue;
+      src.layer = std::max( src.layer, m_nodes[index].layer + 1 );
+      if ( --pendingDsts[srcs[i]] == 0 )
+        queue.push_back( srcs[i] );
+    }
+  }
+
+  // nodes within a cycle : right before the left-most node they feed
+  for ( unsigned i = 0; i < m_realNodeCount; ++i )
+  {
+    if ( visited[i] )
+      continue;
+    LayoutNode &node = m_nodes[i];
+    for ( size_t j = 0; j < node.dsts.size(); ++j )
+    {
+      if ( visited[node.dsts[j]] )
+        node.layer = std::max( node.layer, m_nodes[node.dsts[j]].layer + 1 );
+    }
+    visited[i] = true;
+  }
+}
+
+void GraphLayout::splitLongConnections()
+{
+  // keep the connections going from right to left, shortest first
+  std::vector< std::pair<unsigned, size_t> > spans;
+  spans.reserve( m_connections.size() );
+  for ( size_t i = 0; i < m_connections.size(); ++i )
+  {
+    unsigned srcLayer = m_nodes[m_connections[i].first].layer;
+    unsigned dstLayer = m_nodes[m_connections[i].second].layer;
+    if ( srcLayer > dstLayer )
+      spans.push_back( std::pair<unsigned, size_t>( srcLayer - dstLayer, i ) );
+  }
+  std::sort( spans.begin(), spans.end() );
+
+  for ( unsigned i = 0; i < m_realNodeCount; ++i )
+  {
+    m_nodes[i].srcs.clear();
+    m_nodes[i].dsts.clear();
+  }
+
+  size_t maxDummyCount = size_t( MaxDummyNodesPerNode ) * m_realNodeCount;
+  size_t dummyCount = 0;
+  for ( size_t i = 0; i < spans.size(); ++i )
+  {
+    unsigned span = spans[i].first;
+    if ( span > 1 && dummyCount + span - 1 > maxDummyCount )
+      break;
+
+    unsigned src = m_connections[spans[i].second].first;
+    unsigned dst = m_connections[spans[i].second].second;
+
+    float srcY = float( m_nodes[src].pos.y() + 0.5 * m_nodes[src].size.height() );
+    float dstY = float( m_nodes[dst].pos.y() + 0.5 * m_nodes[dst].size.height() );
+    unsigned dstLayer = m_nodes[dst].layer;
+
+    unsigned prev = dst;
+    for ( unsigned k = 1; k < span; ++k )
+    {
+      LayoutNode dummy;
+      dummy.pos = QPointF( 0.0, dstY + ( srcY - dstY ) * float( k ) / float( span ) );
+      dummy.size = QSizeF( 0.0, 0.0 );
+      dummy.isRoot = false;
+      dummy.isDummy = true;
+      dummy.layer = dstLayer + k;
+      dummy.order = 0;
+      dummy.dsts.push_back( prev );
+      m_nodes.push_back( dummy );
+
+      unsigned index = unsigned( m_nodes.size() - 1 );
+      m_nodes[prev].srcs.push_back( index );
+      prev = index;
+    }
+    m_nodes[prev].srcs.push_back( src );
+    m_nodes[src].dsts.push_back( prev );
+    dummyCount += span - 1;
+  }
+
+  unsigned layerCount = 0;
+  for ( size_t i = 0; i < m_nodes.size(); ++i )
+    layerCount = std::max( layerCount, m_nodes[i].layer + 1 );
+  m_layers.resize( layerCount );
+  for ( size_t i = 0; i < m_nodes.size(); ++i )
+    m_layers[m_nodes[i].layer].push_back( unsigned( i ) );
+}
+
+void GraphLayout::orderLayers(
+  ProgressCallback progressCallback,
+  void *userData,
+  bool &aborted
+  )
+{
+  // start from the current vertical order, which the first layer
+  // (the roots) keeps
+  for ( size_t l = 0; l < m_layers.size(); ++l )
+  {
+    std::vector<unsigned> &layer = m_layers[l];
+    std::vector<OrderEntry> entries( layer.size() );
+    for ( size_t i = 0; i < layer.size(); ++i )
+    {
+      LayoutNode const &node = m_nodes[layer[i]];
+      entries[i].key = float( node.pos.y() + 0.5 * node.size.height() );
+      entries[i].order = unsigned( i );
+      entries[i].node = layer[i];
+    }
+    std::sort( entries.begin(), entries.end() );
+    for ( size_t i = 0; i < entries.size(); ++i )
+    {
+      layer[i] = entries[i].node;
+      m_nodes[layer[i]].order = unsigned( i );
+    }
+  }
+
+  if ( m_layers.size() <= 1 )
+    return;
+
+  size_t bestCrossings = countCrossings();
+  std::vector<unsigned> bestOrders( m_nodes.size() );
+  for ( size_t i = 0; i < m_nodes.size(); ++i )
+    bestOrders[i] = m_nodes[i].order;
+
+  unsigned sweepsWithoutImprovement = 0;
+  for ( unsigned sweep = 0; sweep < MaxOrderingSweeps && bestCrossings > 0; ++sweep )
+  {
+    for ( size_t l = 1; l < m_layers.size(); ++l )
+      sortLayer( unsigned( l ), false );
+    for ( size_t l = m_layers.size() - 1; l-- > 1; )
+      sortLayer( unsigned( l ), true );
+
+    size_t crossings = countCrossings();
+    if ( crossings < bestCrossings )
+    {
+      bestCrossings = crossings;
+      for ( size_t i = 0; i < m_nodes.size(); ++i )
+        bestOrders[i] = m_nodes[i].order;
+      sweepsWithoutImprovement = 0;
+    }
+    else if ( ++sweepsWithoutImprovement >= 2 )
+      break;
+
+    if ( !ReportProgress(
+      progressCallback, userData,
+      0.2f + 0.7f * float( sweep + 1 ) / float( MaxOrderingSweeps )
+      ) )
+    {
+      aborted = true;
+      return;
+    }
+  }
+
+  for ( size_t i = 0; i < m_nodes.size(); ++i )
+  {
+    m_nodes[i].order = bestOrders[i];
+    m_layers[m_nodes[i].layer][bestOrders[i]] = unsigned( i );
+  }
+}
+
+void GraphLayout::sortLayer( unsigned layerIndex, bool bySrcs )
+{
+  // barycenter of the neighbors in the adjacent layer; the nodes
+  // without neighbors there keep their place
+  std::vector<unsigned> &layer = m_layers[layerIndex];
+  std::vector<unsigned> slots;
+  std::vector<OrderEntry> entries;
+  slots.reserve( layer.size() );
+  entries.reserve( layer.size() );
+
+  for ( size_t i = 0; i < layer.size(); ++i )
+  {
+    LayoutNode const &node = m_nodes[layer[i]];
+    std::vector<unsigned> const &neighbors = bySrcs ? node.srcs : node.dsts;
+    if ( neighbors.empty() )
+      continue;
+
+    float sum = 0.0f;
+    for ( size_t j = 0; j < neighbors.size(); ++j )
+      sum += float( m_nodes[neighbors[j]].order );
+
+    OrderEntry entry;
+    entry.key = sum / float( neighbors.size() );
+    entry.order = unsigned( i );
+    entry.node = layer[i];
+    slots.push_back( unsigned( i ) );
+    entries.push_back( entry );
+  }
+
+  std::sort( entries.begin(), entries.end() );
+  for ( size_t i = 0; i < entries.size(); ++i )
+  {
+    layer[slots[i]] = entries[i].node;
+    m_nodes[entries[i].node].order = slots[i];
+  }
+}
+
+size_t GraphLayout::countCrossings() const
+{
+  // for each pair of adjacent layers, the number of inversions among the
+  // connections sorted by their source (Fenwick tree over the destinations)
+  size_t crossings = 0;
+  std::vector< std::pair<unsigned, unsigned> > connections;
+  std::vector<size_t> tree;
+
+  for ( size_t l = 1; l < m_layers.size(); ++l )
+  {
+    std::vector<unsigned> const &layer = m_layers[l];
+    connections.clear();
+    for ( size_t i = 0; i < layer.size(); ++i )
+    {
+      LayoutNode const &node = m_nodes[layer[i]];
+      for ( size_t j = 0; j < node.dsts.size(); ++j )
+        connections.push_back(
+          std::pair<unsigned, unsigned>( node.order, m_nodes[node.dsts[j]].order )
+          );
+    }
+    std::sort( connections.begin(), connections.end() );
+
+    size_t size = m_layers[l - 1].size();
+    tree.assign( size + 1, 0 );
+    for ( size_t i = 0; i < connections.size(); ++i )
+    {
+      size_t dst = connections[i].second + 1;
+
+      size_t notAfter = 0;
+      for ( size_t k = dst; k > 0; k -= k & ( ~k + 1 ) )
+        notAfter += tree[k];
+      crossings += i - notAfter;
+
+      for ( size_t k = dst; k <= size; k += k & ( ~k + 1 ) )
+        ++tree[k];
+    }
+  }
+  return crossings;
+}
+
+void GraphLayout::assignCoordinates()
+{
+  if ( m_layers.size() <= 1 )
+    return;
+
+  // the columns are right-aligned, on the left of the roots
+  float columnRight = std::numeric_limits<float>::max();
+  std::vector<unsigned> const &roots = m_layers[0];
+  for ( size_t i = 0; i < roots.size(); ++i )
+    columnRight = std::min( columnRight, float( m_nodes[roots[i]].pos.x() ) );
+  columnRight -= m_columnSpacing;
+
+  for ( size_t l = 1; l < m_layers.size(); ++l )
+  {
+    std::vector<unsigned> const &layer = m_layers[l];
+    float width = 0.0f;
+    for ( size_t i = 0; i < layer.size(); ++i )
+      width = std::max( width, float( m_nodes[layer[i]].size.width() ) );
+    for ( size_t i = 0; i < layer.size(); ++i )
+    {
+      LayoutNode &node = m_nodes[layer[i]];
+      node.pos.setX( columnRight - node.size.width() );
+    }
+    columnRight -= width + m_columnSpacing;
+  }
+
+  // Each node would like to be level with the nodes it feeds. Within the
+  // order of its layer, that's a weighted isotonic regression, solved with
+  // the pool adjacent violators algorithm.
+  std::vector<float> offsets;
+  std::vector<float> targets;
+  std::vector<float> weights;
+  std::vector<PlacementBlock> blocks;
+  for ( size_t l = 1; l < m_layers.size(); ++l )
+  {
+    std::vector<unsigned> const &layer = m_layers[l];
+    offsets.resize( layer.size() );
+    targets.resize( layer.size() );
+    weights.resize( layer.size() );
+
+    float offset = 0.0f;
+    for ( size_t i = 0; i < layer.size(); ++i )
+    {
+      LayoutNode const &node = m_nodes[layer[i]];
+      float height = float( node.size.height() );
+
+      float desired = float( node.pos.y() );
+      if ( !node.dsts.empty() )
+      {
+        float sum = 0.0f;
+        for ( size_t j = 0; j < node.dsts.size(); ++j )
+        {
+          LayoutNode const &dst = m_nodes[node.dsts[j]];
+          sum += float( dst.pos.y() + 0.5 * dst.size.height() );
+        }
+        desired = sum / float( node.dsts.size() ) - 0.5f * height;
+      }
+
+      offsets[i] = offset;
+      targets[i] = desired - offset;
+      weights[i] = node.isDummy ? DummyNodeWeight : 1.0f;
+      offset += height + m_rowSpacing;
+    }
+
+    blocks.clear();
+    for ( size_t i = 0; i < layer.size(); ++i )
+    {
+      PlacementBlock block;
+      block.sum = targets[i] * weights[i];
+      block.weight = weights[i];
+      block.count = 1;
+      blocks.push_back( block );
+
+      while ( blocks.size() >= 2
+        && blocks[blocks.size() - 2].mean() > blocks.back().mean() )
+      {
+        PlacementBlock &previous = blocks[blocks.size() - 2];
+        previous.sum += blocks.back().sum;
+        previous.weight += blocks.back().weight;
+        previous.count += blocks.back().count;
+        blocks.pop_back();
+      }
+    }
+
+    size_t i = 0;
+    for ( size_t b = 0; b < blocks.size(); ++b )
+    {
+      float y = blocks[b].mean();
+      for ( unsigned c = 0; c < blocks[b].count; ++c, ++i )
+        m_nodes[layer[i]].pos.setY( y + offsets[i] );
+    }
+  }
+}
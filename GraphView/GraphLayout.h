@@ -0,0 +1,99 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#ifndef __UI_GraphView_GraphLayout__
+#define __UI_GraphView_GraphLayout__
+
+#include <QPointF>
+#include <QSizeF>
+#include <vector>
+#include <stddef.h>
+
+namespace FabricUI
+{
+
+  namespace GraphView
+  {
+
+    // Layered (Sugiyama-style) layout of a set of nodes : the nodes are
+    // assigned to columns flowing from left to right towards the root
+    // nodes, which stay where they are, then ordered within their column
+    // to reduce the crossings of the connections, and finally placed as
+    // close as possible to the nodes they feed.
+    // It only works on plain data, so it can be run away from the GUI
+    // thread (see GraphLayoutWorker).
+    class GraphLayout
+    {
+    public:
+
+      // Called between the steps of run() with its progress, in [0, 1].
+      // Returning false aborts the layout.
+      typedef bool (*ProgressCallback)( void *userData, float progress );
+
+      GraphLayout(
+        float columnSpacing = 40.0f,
+        float rowSpacing = 10.0f
+        );
+
+      void swap( GraphLayout &other );
+
+      unsigned nodeCount() const
+        { return m_realNodeCount; }
+
+      // returns the index of the node
+      unsigned addNode(
+        QPointF topLeftPos,
+        QSizeF size,
+        bool isRoot
+        );
+      // the data flows from srcNode to dstNode
+      void addConnection( unsigned srcNode, unsigned dstNode );
+
+      // returns false if aborted by the progress callback
+      bool run(
+        ProgressCallback progressCallback = 0,
+        void *userData = 0
+        );
+
+      QPointF topLeftPos( unsigned node ) const
+        { return m_nodes[node].pos; }
+
+    private:
+
+      struct LayoutNode
+      {
+        QPointF pos;
+        QSizeF size;
+        bool isRoot;
+        bool isDummy;
+        unsigned layer;
+        // index within its layer
+        unsigned order;
+        // once the long connections are split, the neighbors are always
+        // in the next (srcs) or previous (dsts) layer
+        std::vector<unsigned> srcs;
+        std::vector<unsigned> dsts;
+      };
+
+      void assignLayers();
+      void splitLongConnections();
+      void orderLayers( ProgressCallback progressCallback, void *userData, bool &aborted );
+      void sortLayer( unsigned layer, bool bySrcs );
+      size_t countCrossings() const;
+      void assignCoordinates();
+
+      float m_columnSpacing;
+      float m_rowSpacing;
+
+      // the real nodes, followed by the dummy nodes splitting the
+      // connections spanning several layers
+      std::vector<LayoutNode> m_nodes;
+      unsigned m_realNodeCount;
+      std::vector< std::pair<unsigned, unsigned> > m_connections;
+      std::vector< std::vector<unsigned> > m_layers;
+    };
+
+  };
+
+};
+
+#endif // __UI_GraphView_GraphLayout__
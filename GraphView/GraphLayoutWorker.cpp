@@ -0,0 +1,97 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#include "GraphLayoutWorker.h"
+
+#include <QMutexLocker>
+
+using namespace FabricUI::GraphView;
+
+GraphLayoutWorker::GraphLayoutWorker()
+  : m_hasPending( false )
+  , m_pendingGeneration( 0 )
+  , m_hasResult( false )
+  , m_resultGeneration( 0 )
+  , m_latestGeneration( 0 )
+  , m_runningGeneration( 0 )
+{
+}
+
+void GraphLayoutWorker::post( GraphLayout &layout, unsigned generation )
+{
+  bool wasPending;
+  {
+    QMutexLocker lock( &m_mutex );
+    wasPending = m_hasPending;
+    m_pending.swap( layout );
+    m_pendingGeneration = generation;
+    m_hasPending = true;
+    m_latestGeneration = generation;
+  }
+  // If a layout was already waiting, its process() call
+  // is still queued and will pick up this one instead
+  if( !wasPending )
+    QMetaObject::invokeMethod( this, "process", Qt::QueuedConnection );
+}
+
+void GraphLayoutWorker::cancel()
+{
+  QMutexLocker lock( &m_mutex );
+  m_hasPending = false;
+  m_pending = GraphLayout();
+  m_hasResult = false;
+  m_result = GraphLayout();
+  m_latestGeneration++;
+}
+
+bool GraphLayoutWorker::takeResult( unsigned generation, GraphLayout &layout )
+{
+  QMutexLocker lock( &m_mutex );
+  if( !m_hasResult || m_resultGeneration != generation )
+    return false;
+  layout.swap( m_result );
+  m_result = GraphLayout();
+  m_hasResult = false;
+  return true;
+}
+
+bool GraphLayoutWorker::isObsolete( unsigned generation )
+{
+  QMutexLocker lock( &m_mutex );
+  return generation != m_latestGeneration;
+}
+
+bool GraphLayoutWorker::ProgressCallback( void *userData, float progress )
+{
+  GraphLayoutWorker *worker = static_cast<GraphLayoutWorker *>( userData );
+  if( worker->isObsolete( worker->m_runningGeneration ) )
+    return false;
+  emit worker->progress( worker->m_runningGeneration, progress );
+  return true;
+}
+
+void GraphLayoutWorker::process()
+{
+  GraphLayout layout;
+  {
+    QMutexLocker lock( &m_mutex );
+    if( !m_hasPending )
+      return;
+    layout.swap( m_pending );
+    m_runningGeneration = m_pendingGeneration;
+    m_hasPending = false;
+  }
+
+  if( !layout.run( &ProgressCallback, this ) )
+    return;
+
+  {
+    QMutexLocker lock( &m_mutex );
+    // Don't bother the GUI thread with results nobody is waiting for
+    if( m_runningGeneration != m_latestGeneration )
+      return;
+    m_result.swap( layout );
+    m_resultGeneration = m_runningGeneration;
+    m_hasResult = true;
+  }
+  emit finished( m_runningGeneration );
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#ifndef __UI_GraphView_GraphLayoutWorker__
+#define __UI_GraphView_GraphLayoutWorker__
+
+#include <QObject>
+#include <QMutex>
+#include "GraphLayout.h"
+
+namespace FabricUI
+{
+
+  namespace GraphView
+  {
+
+    // Runs GraphLayouts away from the GUI thread.
+    // Only the most recent layout is kept : a layout posted while another
+    // one is pending replaces it, and a layout that has been superseded
+    // in the meantime is aborted.
+    class GraphLayoutWorker : public QObject
+    {
+      Q_OBJECT
+
+    public:
+
+      GraphLayoutWorker();
+
+      // Thread-safe : can be called from the GUI thread.
+      // The content of layout is taken over.
+      void post( GraphLayout &layout, unsigned generation );
+      // Thread-safe : marks all the layouts posted so far as obsolete
+      void cancel();
+      // Thread-safe : moves the result of the given generation to layout
+      bool takeResult( unsigned generation, GraphLayout &layout );
+
+    signals:
+
+      // Emitted from the worker thread
+      void progress( unsigned generation, float progress );
+      void finished( unsigned generation );
+
+    private slots:
+
+      void process();
+
+    private:
+
+      bool isObsolete( unsigned generation );
+
+      static bool ProgressCallback( void *userData, float progress );
+
+      QMutex m_mutex;
+      GraphLayout m_pending;
+      bool m_hasPending;
+      unsigned m_pendingGeneration;
+      GraphLayout m_result;
+      bool m_hasResult;
+      unsigned m_resultGeneration;
+      unsigned m_latestGeneration;
+
+      // only used by the worker thread
+      unsigned m_runningGeneration;
+    };
+
+  };
+
+};
+
+#endif // __UI_GraphView_GraphLayoutWorker__
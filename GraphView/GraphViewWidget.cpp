@@ -9,6 +9,7 @@
 #include <QRect>
 #include <QGraphicsSceneEvent>
 
+#include <FabricUI/GraphView/BatchRenderer.h>
 #include <FabricUI/GraphView/MainPanel.h>
 #include <FabricUI/GraphView/SidePanel.h>
 #include <FabricUI/GraphView/Graph.h>
@@ -31,6 +32,8 @@ GraphViewWidget::GraphViewWidget(
   : QGraphicsView(parent)
   , m_altWasHeldAtLastMousePress( false )
   , m_uiGraphZoomBeforeQuickZoom( 0.0f )
+  , m_useBatchRendering( false )
+  , m_batchRenderer( NULL )
 {
   setRenderHint(QPainter::Antialiasing);
   // setRenderHint(QPainter::HighQualityAntialiasing);
@@ -59,6 +62,7 @@ GraphViewWidget::GraphViewWidget(
       QGLContext * context = new QGLContext(format);
       QGLWidget * glWidget = new QGLWidget(context);
       setViewport(glWidget);
+      m_useBatchRendering = config.useBatchRendering;
     }
   }
 
@@ -67,6 +71,11 @@ GraphViewWidget::GraphViewWidget(
   setMouseTracking(true);
 }
 
+GraphViewWidget::~GraphViewWidget()
+{
+  delete m_batchRenderer;
+}
+
 Graph * GraphViewWidget::graph()
 {
   return m_graph;
@@ -89,6 +98,12 @@ void GraphViewWidget::setGraph(Graph * graph)
     );
 
   m_graph = graph;
+
+  delete m_batchRenderer;
+  m_batchRenderer = NULL;
+  if(m_graph && m_useBatchRendering)
+    m_batchRenderer = new BatchRenderer(m_graph);
+
   if(m_graph)
   {
     m_graph->setGeometry(0, 0, size().width(), size().height());
@@ -160,6 +175,10 @@ QPoint GraphViewWidget::lastEventPos() const
 
 void GraphViewWidget::onSceneChanged()
 {
+  // the view is updated after this, through the same signal
+  if(m_batchRenderer)
+    m_batchRenderer->invalidate();
+
 #ifdef FABRICUI_TIMERS
   Util::TimerPtr overAllTimer = Util::Timer::getTimer("FabricUI::GraphViewWidget");
 
@@ -263,6 +282,27 @@ void GraphViewWidget::drawBackground(QPainter *painter, const QRectF &exposedRec
 
   // clean up.
   painter->restore();
+
+  // draw the node rectangles and the connections
+  // of the zoomed out graph in batches.
+  if (m_batchRenderer && graph()->levelOfDetail() == LevelOfDetail_Rectangle)
+  {
+    painter->beginNativePainting();
+    if (!graph()->isBatchRendering())
+    {
+      // first use : fall back to the items' own painting if the context can't run it
+      if (BatchRenderer::IsSupported())
+        graph()->setBatchRendering(true);
+      else
+      {
+        delete m_batchRenderer;
+        m_batchRenderer = NULL;
+      }
+    }
+    if (m_batchRenderer)
+      m_batchRenderer->draw(painter);
+    painter->endNativePainting();
+  }
 }
 
 GraphViewScene::GraphViewScene( Graph * graph ) {
@@ -17,6 +17,7 @@ namespace FabricUI
   {
 
     class Graph;
+    class BatchRenderer;
 
     // The GraphViewScene specializes QGraphicsScene for intercepting events that need to be treated
     // globally (eg: click for panning the camera) and not forwareded to individual scene widgets.
@@ -57,6 +58,7 @@ namespace FabricUI
         const GraphConfig & config = GraphConfig(),
         Graph * graph = NULL
         );
+      ~GraphViewWidget();
 
       Graph * graph();
       const Graph * graph() const;
@@ -99,6 +101,9 @@ namespace FabricUI
       bool m_altWasHeldAtLastMousePress;
       std::vector<QLineF> m_lines;
       float m_uiGraphZoomBeforeQuickZoom;
+      // only with an OpenGL viewport, NULL if not supported
+      bool m_useBatchRendering;
+      BatchRenderer * m_batchRenderer;
     };
 
   };
@@ -0,0 +1,41 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#ifndef __UI_GraphView_LevelOfDetail__
+#define __UI_GraphView_LevelOfDetail__
+
+#include <FabricUI/GraphView/GraphConfig.h>
+
+namespace FabricUI {
+namespace GraphView {
+
+// How much of a node is shown, from the most to the least detailed.
+// Lower levels are used when the graph is zoomed out, so that the
+// items which can't be read anyway are neither laid out nor painted.
+enum LevelOfDetail
+{
+  LevelOfDetail_Full,       // everything
+  LevelOfDetail_NoLabels,   // no pin labels nor header buttons
+  LevelOfDetail_HeaderOnly, // no pins : only the header
+  LevelOfDetail_Rectangle   // only the colored rectangle of the node
+};
+
+inline LevelOfDetail LevelOfDetailForZoom(
+  GraphConfig const &config,
+  float zoom
+  )
+{
+  if ( !config.nodeLODEnabled )
+    return LevelOfDetail_Full;
+  if ( zoom < config.nodeLODRectangleZoom )
+    return LevelOfDetail_Rectangle;
+  if ( zoom < config.nodeLODHeaderOnlyZoom )
+    return LevelOfDetail_HeaderOnly;
+  if ( zoom < config.nodeLODNoLabelsZoom )
+    return LevelOfDetail_NoLabels;
+  return LevelOfDetail_Full;
+}
+
+} // namespace GraphView
+} // namespace FabricUI
+
+#endif // __UI_GraphView_LevelOfDetail__
@@ -117,6 +117,10 @@ void MainPanel::setCanvasZoom(float state, bool quiet)
     m_graph->setConnectionsCosmetic( cosmetic );
   }
 
+  m_graph->setLevelOfDetail(
+    LevelOfDetailForZoom( m_graph->config(), m_itemGroup->scale() )
+    );
+
   update();
 
   if(!quiet)
@@ -128,6 +132,11 @@ QPointF MainPanel::canvasPan() const
   return m_itemGroup->pos();
 }
 
+QRectF MainPanel::visibleGraphRect() const
+{
+  return m_itemGroup->mapRectFromParent(boundingRect());
+}
+
 void MainPanel::setCanvasPan(QPointF pos, bool quiet)
 {
   m_itemGroup->setPos(pos);
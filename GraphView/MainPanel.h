@@ -44,6 +44,8 @@ namespace FabricUI
 
       float canvasZoom() const;
       QPointF canvasPan() const;
+      // the area of the graph currently shown, in graph coordinates
+      QRectF visibleGraphRect() const;
  
       float mouseWheelZoomRate() const;
       void setMouseWheelZoomRate(float rate);
@@ -208,6 +208,51 @@ QPointF MouseGrabber::connectionPos(PortType pType) const
   return m_connectionPos;
 }
 
+// Same as collidingItems(Qt::IntersectsItemBoundingRect), restricted to
+// the items a connection can be dropped on : rather than the whole scene,
+// only the nodes the graph's spatial index finds under the grabber and
+// the side panels are looked at.
+QList<QGraphicsItem *> MouseGrabber::collidingTargetItems() const
+{
+  QList<QGraphicsItem *> items;
+
+  // the pin circles stick out of their node
+  qreal margin = 2.0 * graph()->config().pinRadius;
+  QRectF rect = mapRectToParent(boundingRect()).adjusted(-margin, -margin, margin, margin);
+  std::vector<Node *> nodes = graph()->nodesInRect(rect);
+  for(size_t i=0;i<nodes.size();i++)
+    appendCollidingTargetItems(nodes[i], items);
+
+  for(int i=0;i<2;i++)
+  {
+    const SidePanel * sidePanel = graph()->sidePanel(i == 0 ? PortType_Input : PortType_Output);
+    if(sidePanel)
+      appendCollidingTargetItems(const_cast<SidePanel *>(sidePanel), items);
+  }
+
+  return items;
+}
+
+void MouseGrabber::appendCollidingTargetItems(
+  QGraphicsItem * item,
+  QList<QGraphicsItem *> &items
+  ) const
+{
+  if(!item->isVisible())
+    return;
+
+  if(   item->type() == QGraphicsItemType_PinCircle
+     || item->type() == QGraphicsItemType_SidePanel )
+  {
+    if(collidesWithItem(item, Qt::IntersectsItemBoundingRect))
+      items.append(item);
+  }
+
+  QList<QGraphicsItem *> children = item->childItems();
+  for(int i=0;i<children.count();i++)
+    appendCollidingTargetItems(children[i], items);
+}
+
 void MouseGrabber::mouseMoveEvent(QGraphicsSceneMouseEvent * event)
 {
   m_connectionPos = mapToScene(event->pos());
@@ -216,7 +261,7 @@ void MouseGrabber::mouseMoveEvent(QGraphicsSceneMouseEvent * event)
 
   emit positionChanged(mousePos);
 
-  QList<QGraphicsItem *> items = collidingItems(Qt::IntersectsItemBoundingRect);
+  QList<QGraphicsItem *> items = collidingTargetItems();
 
   bool isDraggingPortInSidePanel = false;
   if( m_lastSidePanel != NULL )
@@ -76,6 +76,11 @@ namespace FabricUI
     private:
 
       void showToolTip();
+      QList<QGraphicsItem *> collidingTargetItems() const;
+      void appendCollidingTargetItems(
+        QGraphicsItem * item,
+        QList<QGraphicsItem *> &items
+        ) const;
       void invokeConnect(ConnectionTarget * source, ConnectionTarget * target);
 
       void invokeNodeHeaderMenu(
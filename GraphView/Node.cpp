@@ -27,6 +27,7 @@
 #include <QPainter>
 
 #include <algorithm>
+#include <set>
 
 using namespace FabricUI::GraphView;
 
@@ -61,6 +62,7 @@ Node::Node(
   m_cornerRadius = graph()->config().nodeCornerRadius;
   m_pinRadius = graph()->config().pinRadius;
   m_collapsedState = CollapseState_Expanded;
+  m_levelOfDetail = LevelOfDetail_Full;
   m_col = 0;
   m_alwaysShowDaisyChainPorts = false;
 
@@ -133,6 +135,9 @@ Node::Node(
 
 Node::~Node()
 {
+  // deleted in the middle of a drag: close the graph's drag bracket
+  onMouseUngrab();
+
   m_bubble->setParentItem( NULL );
   m_bubble->scene()->removeItem( m_bubble );
   delete m_bubble;
@@ -244,6 +249,26 @@ void Node::setCollapsedState(Node::CollapseState state)
   updatePinLayout();
 }
 
+void Node::setLevelOfDetail(LevelOfDetail lod)
+{
+  if(m_levelOfDetail == lod)
+    return;
+  m_levelOfDetail = lod;
+
+  // Hiding the parent widgets doesn't change the visibility
+  // of the pins themselves, which depends on the collapse state.
+  // The layout keeps the space of hidden items, so the size
+  // of the node and the position of its connections don't change.
+  bool showLabels = m_levelOfDetail == LevelOfDetail_Full;
+  for(size_t i=0;i<m_pins.size();i++)
+    m_pins[i]->labelWidget()->setVisible(showLabels);
+  m_header->setHeaderButtonsVisible(showLabels);
+  m_pinsWidget->setVisible(m_levelOfDetail < LevelOfDetail_HeaderOnly);
+  m_header->setVisible(m_levelOfDetail < LevelOfDetail_Rectangle);
+
+  update();
+}
+
 void Node::setSelected(bool state, bool quiet)
 {
   if(state == m_selected)
@@ -312,6 +337,19 @@ void Node::setTopLeftGraphPos(QPointF pos, bool quiet)
   }
 }
 
+QVariant Node::itemChange( GraphicsItemChange change, const QVariant &value )
+{
+  if ( change == ItemPositionHasChanged )
+    graph()->updateNodeGridEntry( this );
+  return QGraphicsWidget::itemChange( change, value );
+}
+
+void Node::resizeEvent( QGraphicsSceneResizeEvent * event )
+{
+  QGraphicsWidget::resizeEvent( event );
+  graph()->updateNodeGridEntry( this );
+}
+
 void Node::insertInstBlockAtIndex( unsigned index, InstBlock *instBlock )
 {
   assert( std::find(
@@ -355,8 +393,7 @@ void Node::removeInstBlockAtIndex( unsigned index )
   // Without this, we get pretty consistent crashes walking the BSP
   // after pin removal.  After lots of debugging I believe this is 
   // a bug in QGraphicsScene, but I am not certain.
-  scene()->setItemIndexMethod( QGraphicsScene::NoIndex );
-  scene()->setItemIndexMethod( QGraphicsScene::BspTreeIndex );
+  graph()->resetSceneItemIndex();
 }
 
 bool Node::addPin( Pin *pin )
@@ -372,6 +409,8 @@ bool Node::addPin( Pin *pin )
 
   pin->setIndex((int)m_pins.size());
   m_pins.push_back(pin);
+  if(m_levelOfDetail != LevelOfDetail_Full)
+    pin->labelWidget()->setVisible(false);
 
   updatePinLayout();
 
@@ -405,8 +444,7 @@ bool Node::removePin( Pin * pin )
   // Without this, we get pretty consistent crashes walking the BSP
   // after pin removal.  After lots of debugging I believe this is 
   // a bug in QGraphicsScene, but I am not certain.
-  scene()->setItemIndexMethod( QGraphicsScene::NoIndex );
-  scene()->setItemIndexMethod( QGraphicsScene::BspTreeIndex );
+  graph()->resetSceneItemIndex();
 
   return true;
 }
@@ -423,7 +461,7 @@ void Node::reorderPins(QStringList names)
   updatePinLayout();
 }
 
-void Node::getUpStreamNodes_recursive(Node *node, std::vector<Connection *> &connections, std::map<Node *, Node *> &ioVisitedNodes, std::vector<Node *> &ioUpStreamNodes)
+void Node::getUpStreamNodes_recursive(Node *node, std::map<Node *, Node *> &ioVisitedNodes, std::vector<Node *> &ioUpStreamNodes)
 {
   if (   node == NULL
       || ioVisitedNodes.find(node) != ioVisitedNodes.end() )
@@ -432,19 +470,21 @@ void Node::getUpStreamNodes_recursive(Node *node, std::vector<Connection *> &con
   ioVisitedNodes.insert(std::pair<Node *, Node *>(node, node));
   ioUpStreamNodes.push_back(node);
 
+  Graph *graph = node->graph();
+
   for (unsigned int i=0;i<node->pinCount();i++)
   {
     Pin *p = node->pin(i);
+    std::vector<Connection *> const &connections = graph->connectionsTo(p);
     for (size_t j=0;j<connections.size();j++)
     {
       ConnectionTarget *src = connections[j]->src();
-      ConnectionTarget *dst = connections[j]->dst();
-      if (src && dst == p)
+      if (src)
       {
         Node *srcNode = NULL;
         if      (src->targetType() == TargetType_Pin)           srcNode = ((Pin *)src)->node();
         else if (src->targetType() == TargetType_InstBlockPort) srcNode = ((InstBlockPort *)src)->node();
-        getUpStreamNodes_recursive(srcNode, connections, ioVisitedNodes, ioUpStreamNodes);
+        getUpStreamNodes_recursive(srcNode, ioVisitedNodes, ioUpStreamNodes);
       }
     }
   }
@@ -455,16 +495,16 @@ void Node::getUpStreamNodes_recursive(Node *node, std::vector<Connection *> &con
     for (unsigned int i=0;i<instBlock->instBlockPortCount();i++)
     {
       InstBlockPort *p = instBlock->instBlockPort(i);
+      std::vector<Connection *> const &connections = graph->connectionsTo(p);
       for (size_t j=0;j<connections.size();j++)
       {
         ConnectionTarget *src = connections[j]->src();
-        ConnectionTarget *dst = connections[j]->dst();
-        if (src && dst == p)
+        if (src)
         {
           Node *srcNode = NULL;
           if      (src->targetType() == TargetType_Pin)           srcNode = ((Pin *)src)->node();
           else if (src->targetType() == TargetType_InstBlockPort) srcNode = ((InstBlockPort *)src)->node();
-          getUpStreamNodes_recursive(srcNode, connections, ioVisitedNodes, ioUpStreamNodes);
+          getUpStreamNodes_recursive(srcNode, ioVisitedNodes, ioUpStreamNodes);
         }
       }
     }
@@ -476,15 +516,72 @@ std::vector<Node *> Node::getUpStreamNodes()
   // init.
   std::vector<Node *>       upStreamNodes;
   std::map<Node *, Node *>  visitedNodes;
-  std::vector<Connection *> connections = graph()->connections();
 
   // do it.
-  getUpStreamNodes_recursive(this, connections, visitedNodes, upStreamNodes);
+  getUpStreamNodes_recursive(this, visitedNodes, upStreamNodes);
 
   // done.
   return upStreamNodes;
 }
 
+std::vector<Node *> Node::GetUpStreamNodes( std::vector<Node *> const &rootNodes )
+{
+  std::vector<Node *>       upStreamNodes;
+  std::map<Node *, Node *>  visitedNodes;
+
+  for (size_t i=0;i<rootNodes.size();i++)
+    getUpStreamNodes_recursive(rootNodes[i], visitedNodes, upStreamNodes);
+
+  return upStreamNodes;
+}
+
+std::vector<Node *> Node::GetDownStreamNodes( std::vector<Node *> const &nodes )
+{
+  std::vector<Node *>  downStreamNodes;
+  std::set<Node *>     visitedNodes;
+
+  for (size_t i=0;i<nodes.size();i++)
+  {
+    if (nodes[i] && visitedNodes.insert(nodes[i]).second)
+      downStreamNodes.push_back(nodes[i]);
+  }
+
+  // breadth first, as long chains would be too deep to recurse
+  for (size_t n=0;n<downStreamNodes.size();n++)
+  {
+    Node *node = downStreamNodes[n];
+    Graph *graph = node->graph();
+
+    std::vector<ConnectionTarget *> srcs;
+    for (unsigned int i=0;i<node->pinCount();i++)
+      srcs.push_back(node->pin(i));
+    for (unsigned int k=0;k<node->instBlockCount();k++)
+    {
+      InstBlock *instBlock = node->instBlockAtIndex(k);
+      for (unsigned int i=0;i<instBlock->instBlockPortCount();i++)
+        srcs.push_back(instBlock->instBlockPort(i));
+    }
+
+    for (size_t i=0;i<srcs.size();i++)
+    {
+      std::vector<Connection *> const &connections = graph->connectionsFrom(srcs[i]);
+      for (size_t j=0;j<connections.size();j++)
+      {
+        ConnectionTarget *dst = connections[j]->dst();
+        if (!dst)
+          continue;
+        Node *dstNode = NULL;
+        if      (dst->targetType() == TargetType_Pin)           dstNode = ((Pin *)dst)->node();
+        else if (dst->targetType() == TargetType_InstBlockPort) dstNode = ((InstBlockPort *)dst)->node();
+        if (dstNode && visitedNodes.insert(dstNode).second)
+          downStreamNodes.push_back(dstNode);
+      }
+    }
+  }
+
+  return downStreamNodes;
+}
+
 std::vector<Node *> Node::upStreamNodes_deprecated(bool sortForPins, std::vector<Node *> rootNodes)
 {
   /*
@@ -678,6 +775,12 @@ void Node::mouseReleaseEvent(QGraphicsSceneMouseEvent * event)
   QGraphicsWidget::mouseReleaseEvent(event);
 }
 
+void Node::ungrabMouseEvent(QEvent * event)
+{
+  onMouseUngrab();
+  QGraphicsWidget::ungrabMouseEvent(event);
+}
+
 void Node::mouseDoubleClickEvent(QGraphicsSceneMouseEvent * event)
 {
   if(onMouseDoubleClicked( event ))
@@ -691,6 +794,7 @@ void Node::mouseDoubleClickEvent(QGraphicsSceneMouseEvent * event)
 
 void Node::selectUpStreamNodes()
 {
+  graph()->controller()->gvcCompleteGraphLoad();
   std::vector<Node *> nodes = getUpStreamNodes();
 
   for ( size_t i = 0; i<nodes.size(); i++ )
@@ -708,6 +812,7 @@ void Node::updateNodesToMove( bool backdrops, bool onlyUpstreamNodes )
 
   if (onlyUpstreamNodes)
   {
+    graph()->controller()->gvcCompleteGraphLoad();
     m_nodesToMove = getUpStreamNodes();
   }
   else
@@ -751,12 +856,16 @@ void Node::updateNodesToMove( bool backdrops, bool onlyUpstreamNodes )
   // special case: only a single node will be moved.
   if (m_nodesToMove.size() == 1)
   {
+    // only snap to the nodes the user can see
+    std::vector<Node *> nodes;
+    if (graph()->config().mainPanelNodeSnap || graph()->config().mainPanelPortSnap)
+      nodes = graph()->nodesInRect(graph()->mainPanel()->visibleGraphRect());
+
     // for  "snap to node": add the topleft, bottomright and centers
     // of all other nodes to the m_additionalSnapPositionsXY arrays, so that
     // the node will snap to the centers & co of the other nodes.
     if (graph()->config().mainPanelNodeSnap)
     {
-      std::vector<Node *> nodes = graph()->nodes();
       for (size_t i=0;i<nodes.size();i++)
       {
         if (nodes[i] == m_nodesToMove[0])
@@ -804,7 +913,6 @@ void Node::updateNodesToMove( bool backdrops, bool onlyUpstreamNodes )
       }
 
       // dst
-      std::vector<Node *> nodes = graph()->nodes();
       for (size_t i = 0; i<nodes.size(); i++)
       {
         Node *node = nodes[i];
@@ -970,6 +1078,7 @@ bool Node::onMouseMove( const QGraphicsSceneMouseEvent *event )
     if (m_dragging == 1)
     {
       m_dragging = 2;
+      graph()->beginNodesDrag();
     }
 
     if ( m_mightOnlyMoveUpstreamNodesOnDrag )
@@ -1024,10 +1133,21 @@ bool Node::onMouseMove( const QGraphicsSceneMouseEvent *event )
   return false;
 }
 
+void Node::onMouseUngrab()
+{
+  // the grab was lost before the release (or the node is going away):
+  // the drag is over, so close the graph's drag bracket
+  if ( m_dragging == 2 )
+    graph()->endNodesDrag();
+  m_dragging = 0;
+}
+
 bool Node::onMouseRelease( const QGraphicsSceneMouseEvent *event )
 {
   if ( m_dragging == 2 )
   {
+    graph()->endNodesDrag();
+
     if (!selected() && !m_nodesToMove.size())
       emit positionChanged(this, graphPos());
     else
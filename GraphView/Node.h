@@ -12,6 +12,7 @@
 #include <FTL/CStrRef.h>
 
 #include <FabricUI/GraphView/GraphicItemTypes.h>
+#include <FabricUI/GraphView/LevelOfDetail.h>
 
 #include <set>
 #include <vector>
@@ -137,6 +138,11 @@ namespace FabricUI
         { return m_collapsedState; }
       virtual void setCollapsedState(CollapseState state);
 
+      LevelOfDetail levelOfDetail() const
+        { return m_levelOfDetail; }
+      // hides the items that aren't shown at this level
+      virtual void setLevelOfDetail(LevelOfDetail lod);
+
       virtual QString error() const;
       virtual bool hasError() const;
       virtual void setError(QString text);
@@ -173,6 +179,7 @@ namespace FabricUI
       virtual void mouseMoveEvent(QGraphicsSceneMouseEvent * event);
       virtual void mouseReleaseEvent(QGraphicsSceneMouseEvent * event);
       virtual void mouseDoubleClickEvent(QGraphicsSceneMouseEvent * event);
+      virtual void ungrabMouseEvent(QEvent * event);
       virtual void hoverEnterEvent(QGraphicsSceneHoverEvent * event);
       virtual void hoverMoveEvent(QGraphicsSceneHoverEvent * event);
       virtual void hoverLeaveEvent(QGraphicsSceneHoverEvent * event);
@@ -199,6 +206,10 @@ namespace FabricUI
       void removeInstBlockAtIndex( unsigned index );
 
       std::vector<Node *> getUpStreamNodes();
+      // the nodes upstream of any of the given nodes, each of them once
+      static std::vector<Node *> GetUpStreamNodes( std::vector<Node *> const &rootNodes );
+      // the given nodes and the nodes downstream of any of them, each of them once
+      static std::vector<Node *> GetDownStreamNodes( std::vector<Node *> const &nodes );
       virtual std::vector<Node *> upStreamNodes_deprecated(bool sortForPins = false, std::vector<Node*> rootNodes = std::vector<Node*>());
       // temporary information around row and col
       virtual int row() const;
@@ -260,11 +271,16 @@ namespace FabricUI
       bool onMouseMove( const QGraphicsSceneMouseEvent *event );
       bool onMouseRelease( const QGraphicsSceneMouseEvent *event );
       bool onMouseDoubleClicked( const QGraphicsSceneMouseEvent *event );
+      void onMouseUngrab();
 
       void contextMenuEvent( QGraphicsSceneContextMenuEvent * event ) FTL_OVERRIDE;
 
+      // keep the graph's spatial index up to date
+      QVariant itemChange( GraphicsItemChange change, const QVariant &value ) FTL_OVERRIDE;
+      void resizeEvent( QGraphicsSceneResizeEvent * event ) FTL_OVERRIDE;
+
       // used by getUpStreamNodes().
-      static void getUpStreamNodes_recursive(Node *node, std::vector<Connection *> &connections, std::map<Node *, Node *> &ioVisitedNodes, std::vector<Node *> &ioUpStreamNodes);
+      static void getUpStreamNodes_recursive(Node *node, std::map<Node *, Node *> &ioVisitedNodes, std::vector<Node *> &ioUpStreamNodes);
 
       Graph * m_graph;
       NodeType m_nodeType;
@@ -286,6 +302,7 @@ namespace FabricUI
       qreal m_pinRadius;
       QString m_errorText;
       CollapseState m_collapsedState;
+      LevelOfDetail m_levelOfDetail;
 
       NodeHeader * m_header;
       QGraphicsWidget *m_mainWidget;
@@ -0,0 +1,141 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#include <FabricUI/GraphView/NodeGrid.h>
+
+#include <algorithm>
+#include <math.h>
+
+using namespace FabricUI::GraphView;
+
+NodeGrid::NodeGrid( qreal cellSize )
+  : m_cellSize( cellSize > 1.0 ? cellSize : 1.0 )
+{
+}
+
+QRect NodeGrid::cellsForRect( QRectF const &rect ) const
+{
+  int left = int( floor( rect.left() / m_cellSize ) );
+  int top = int( floor( rect.top() / m_cellSize ) );
+  int right = int( floor( rect.right() / m_cellSize ) );
+  int bottom = int( floor( rect.bottom() / m_cellSize ) );
+  return QRect( QPoint( left, top ), QPoint( right, bottom ) );
+}
+
+void NodeGrid::addToCells( Node *node, QRect const &cells )
+{
+  for( int y = cells.top(); y <= cells.bottom(); y++ )
+    for( int x = cells.left(); x <= cells.right(); x++ )
+      m_cells[Cell( x, y )].push_back( node );
+}
+
+void NodeGrid::removeFromCells( Node *node, QRect const &cells )
+{
+  for( int y = cells.top(); y <= cells.bottom(); y++ )
+  {
+    for( int x = cells.left(); x <= cells.right(); x++ )
+    {
+      CellMap::iterator it = m_cells.find( Cell( x, y ) );
+      if( it == m_cells.end() )
+        continue;
+      std::vector<Node *> &cellNodes = it->second;
+      std::vector<Node *>::iterator nodeIt =
+        std::find( cellNodes.begin(), cellNodes.end(), node );
+      if( nodeIt != cellNodes.end() )
+      {
+        *nodeIt = cellNodes.back();
+        cellNodes.pop_back();
+      }
+      if( cellNodes.empty() )
+        m_cells.erase( it );
+    }
+  }
+}
+
+void NodeGrid::update( Node *node, QRectF const &rect )
+{
+  QRect cells = cellsForRect( rect );
+
+  EntryMap::iterator it = m_entries.find( node );
+  if( it == m_entries.end() )
+  {
+    Entry entry;
+    entry.rect = rect;
+    entry.cells = cells;
+    m_entries.insert( std::make_pair( node, entry ) );
+    addToCells( node, cells );
+    return;
+  }
+
+  // most moves stay within the same cells
+  it->second.rect = rect;
+  if( it->second.cells == cells )
+    return;
+  removeFromCells( node, it->second.cells );
+  addToCells( node, cells );
+  it->second.cells = cells;
+}
+
+void NodeGrid::remove( Node *node )
+{
+  EntryMap::iterator it = m_entries.find( node );
+  if( it == m_entries.end() )
+    return;
+  removeFromCells( node, it->second.cells );
+  m_entries.erase( it );
+}
+
+void NodeGrid::clear()
+{
+  m_cells.clear();
+  m_entries.clear();
+}
+
+void NodeGrid::appendIntersecting(
+  std::vector<Node *> const &cellNodes,
+  QRectF const &rect,
+  std::vector<Node *> &nodes
+  ) const
+{
+  for( size_t i = 0; i < cellNodes.size(); i++ )
+  {
+    EntryMap::const_iterator it = m_entries.find( cellNodes[i] );
+    if( it->second.rect.intersects( rect ) )
+      nodes.push_back( cellNodes[i] );
+  }
+}
+
+void NodeGrid::query( QRectF const &rect, std::vector<Node *> &nodes ) const
+{
+  size_t first = nodes.size();
+
+  QRect cells = cellsForRect( rect );
+  qint64 cellCount = qint64( cells.width() ) * qint64( cells.height() );
+  if( cellCount > qint64( m_cells.size() ) )
+  {
+    // a large area (zoomed out view) : walk the occupied cells instead
+    for( CellMap::const_iterator it = m_cells.begin(); it != m_cells.end(); ++it )
+    {
+      if( cells.contains( it->first.first, it->first.second ) )
+        appendIntersecting( it->second, rect, nodes );
+    }
+  }
+  else
+  {
+    for( int y = cells.top(); y <= cells.bottom(); y++ )
+    {
+      for( int x = cells.left(); x <= cells.right(); x++ )
+      {
+        CellMap::const_iterator it = m_cells.find( Cell( x, y ) );
+        if( it != m_cells.end() )
+          appendIntersecting( it->second, rect, nodes );
+      }
+    }
+  }
+
+  // nodes spanning several cells were found several times
+  std::sort( nodes.begin() + first, nodes.end() );
+  nodes.erase(
+    std::unique( nodes.begin() + first, nodes.end() ),
+    nodes.end()
+    );
+}
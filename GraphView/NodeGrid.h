@@ -0,0 +1,68 @@
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+
+#ifndef __UI_GraphView_NodeGrid__
+#define __UI_GraphView_NodeGrid__
+
+#include <QRect>
+#include <QRectF>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace FabricUI {
+namespace GraphView {
+
+class Node;
+
+// A uniform grid over the graph coordinates, in which each node is
+// registered in all the cells its rect overlaps. It is used to find
+// the nodes near a given area (snapping, backdrop containment, drop
+// targets of a dragged connection) without walking all of them.
+// Updating a node only touches the cells it leaves and enters.
+class NodeGrid
+{
+public:
+
+  NodeGrid( qreal cellSize );
+
+  // inserts the node, or moves it if it is already there
+  void update( Node *node, QRectF const &rect );
+  void remove( Node *node );
+  void clear();
+  bool contains( Node *node ) const
+    { return m_entries.find( node ) != m_entries.end(); }
+
+  // appends, once each, the nodes whose rect intersects the given one
+  void query( QRectF const &rect, std::vector<Node *> &nodes ) const;
+
+private:
+
+  typedef std::pair<int, int> Cell;
+  typedef std::map< Cell, std::vector<Node *> > CellMap;
+
+  struct Entry
+  {
+    QRectF rect;
+    QRect cells;
+  };
+  typedef std::map<Node *, Entry> EntryMap;
+
+  QRect cellsForRect( QRectF const &rect ) const;
+  void addToCells( Node *node, QRect const &cells );
+  void removeFromCells( Node *node, QRect const &cells );
+  void appendIntersecting(
+    std::vector<Node *> const &cellNodes,
+    QRectF const &rect,
+    std::vector<Node *> &nodes
+    ) const;
+
+  qreal m_cellSize;
+  CellMap m_cells;
+  EntryMap m_entries;
+};
+
+} // namespace GraphView
+} // namespace FabricUI
+
+#endif // __UI_GraphView_NodeGrid__
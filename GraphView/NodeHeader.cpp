@@ -207,6 +207,12 @@ void NodeHeader::setCirclesVisible(bool visible)
   m_outCircle->setVisible(visible);
 }
 
+void NodeHeader::setHeaderButtonsVisible(bool visible)
+{
+  for(size_t i=0;i<m_buttons.size();i++)
+    m_buttons[i]->setVisible(visible);
+}
+
 void NodeHeader::addHeaderButton(QString name, QStringList icons, int state)
 {
   QGraphicsLinearLayout * lay = (QGraphicsLinearLayout *)layout();
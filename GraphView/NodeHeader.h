@@ -66,6 +66,7 @@ namespace FabricUI
 
       bool areCirclesVisible() const;
       void setCirclesVisible(bool visible);
+      void setHeaderButtonsVisible(bool visible);
 
       void setHeaderButtonState(QString name, int state);
 
@@ -7,6 +7,7 @@
 #include <FabricUI/GraphView/MainPanel.h>
 
 #include <QPainter>
+#include <QImage>
 #include <QGraphicsSceneMouseEvent>
 
 #ifdef FABRICUI_TIMERS
@@ -28,80 +29,16 @@ NodeHeaderButton::NodeHeaderButton(NodeHeader * parent, QString name, QStringLis
   m_state = 0;
   m_highlighted = false;
 
-  QColor nodeFontHighlightColor = m_nodeHeader->node()->graph()->config().nodeFontHighlightColor;
-  float hlR = nodeFontHighlightColor.redF();
-  float hlG = nodeFontHighlightColor.greenF();
-  float hlB = nodeFontHighlightColor.blueF();
+  GraphConfig const &config = m_nodeHeader->node()->graph()->config();
 
   for(int i=0;i<icons.count();i++)
   {
-    QString icon = icons[i];
-    std::map<QString, QPixmap>::iterator it = s_pixmaps.find(icon);
-    QPixmap pixmap;
-    if(it != s_pixmaps.end())
-      pixmap = it->second;
-    else
-    {
-      QString filePath = m_nodeHeader->node()->graph()->config().nodeHeaderButtonIconDir + icon;
-
-      int pos = 0;
-      QRegExp rx("\\$\\{([^\\}]+)\\}");
-      rx.setMinimal(true);
-      while((pos = rx.indexIn(filePath, pos)) != -1)
-      {
-          QString capture = rx.cap(1);
-          const char * envVar = getenv(capture.toLatin1().constData());
-          if(envVar)
-          {
-            QString replacement = envVar;
-            filePath.replace("${" + capture + "}", replacement);
-          }
-          pos += rx.matchedLength() + 2;
-      }
-
-      pixmap = QPixmap(filePath);
-      s_pixmaps.insert(std::pair<QString, QPixmap>(icon, pixmap));
-    
-      if(pixmap.width() == 0)
-      {
-        printf("NodeHeaderButton: Pixmap not found: '%s'\n", filePath.toUtf8().constData());
-        return;
-      }
-    }
+    QPixmap pixmap = GetIconPixmap(config.nodeHeaderButtonIconDir, icons[i]);
+    if(pixmap.width() == 0)
+      return;
 
     m_pixmaps.append(pixmap);
-
-    // composite a highlight image, using just the alpha map
-    it = s_pixmaps.find(icon + ":highlight");
-    QPixmap highlightPixmap;
-    if(it != s_pixmaps.end())
-      highlightPixmap = it->second;
-    else
-    {
-      QImage image = pixmap.toImage();
-
-      for(int x=0;x<image.width();x++)
-      {
-        for(int y=0;y<image.height();y++)
-        {
-          QRgb c = image.pixel(x, y);
-          if(qAlpha(c) > 0)
-          {
-            int a = qAlpha(c);
-            int r = int(hlR * float(a) + 0.5f);
-            int g = int(hlG * float(a) + 0.5f);
-            int b = int(hlB * float(a) + 0.5f);
-            c = qRgba(r, g, b, a);
-            image.setPixel(x, y, c);
-          }
-        }
-      }
-
-      highlightPixmap = QPixmap::fromImage(image);
-      s_pixmaps.insert(std::pair<QString, QPixmap>(icon + ":highlight", highlightPixmap));
-    }
-
-    m_pixmaps.append(highlightPixmap);
+    m_pixmaps.append(GetHighlightPixmap(icons[i], pixmap, config.nodeFontHighlightColor));
   }
 
   // Hardcode size of the icons
@@ -113,6 +50,59 @@ NodeHeaderButton::NodeHeaderButton(NodeHeader * parent, QString name, QStringLis
   setState(state);
 }
 
+QPixmap NodeHeaderButton::GetIconPixmap(QString const &iconDir, QString const &icon)
+{
+  std::map<QString, QPixmap>::iterator it = s_pixmaps.find(icon);
+  if(it != s_pixmaps.end())
+    return it->second;
+
+  QString filePath = iconDir + icon;
+
+  int pos = 0;
+  QRegExp rx("\\$\\{([^\\}]+)\\}");
+  rx.setMinimal(true);
+  while((pos = rx.indexIn(filePath, pos)) != -1)
+  {
+      QString capture = rx.cap(1);
+      const char * envVar = getenv(capture.toLatin1().constData());
+      if(envVar)
+      {
+        QString replacement = envVar;
+        filePath.replace("${" + capture + "}", replacement);
+      }
+      pos += rx.matchedLength() + 2;
+  }
+
+  QPixmap pixmap = QPixmap(filePath);
+  s_pixmaps.insert(std::pair<QString, QPixmap>(icon, pixmap));
+
+  if(pixmap.width() == 0)
+    printf("NodeHeaderButton: Pixmap not found: '%s'\n", filePath.toUtf8().constData());
+  return pixmap;
+}
+
+QPixmap NodeHeaderButton::GetHighlightPixmap(QString const &icon, QPixmap const &pixmap, QColor color)
+{
+  // the graphs don't necessarily share the same highlight color
+  QString key = icon + ":highlight:" + QString::number(color.rgba(), 16);
+  std::map<QString, QPixmap>::iterator it = s_pixmaps.find(key);
+  if(it != s_pixmaps.end())
+    return it->second;
+
+  // composite a highlight image, using just the alpha map
+  QImage image(pixmap.size(), QImage::Format_ARGB32_Premultiplied);
+  image.fill(0);
+  QPainter painter(&image);
+  painter.drawPixmap(0, 0, pixmap);
+  painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+  painter.fillRect(image.rect(), QColor(color.red(), color.green(), color.blue()));
+  painter.end();
+
+  QPixmap highlightPixmap = QPixmap::fromImage(image);
+  s_pixmaps.insert(std::pair<QString, QPixmap>(key, highlightPixmap));
+  return highlightPixmap;
+}
+
 void NodeHeaderButton::setState(int value)
 {
   if(m_state == value)
@@ -168,6 +158,12 @@ void NodeHeaderButton::mouseReleaseEvent(QGraphicsSceneMouseEvent * event)
   m_nodeHeader->node()->onMouseRelease( event );
 }
 
+void NodeHeaderButton::ungrabMouseEvent(QEvent * event)
+{
+  m_nodeHeader->node()->onMouseUngrab();
+  QGraphicsWidget::ungrabMouseEvent(event);
+}
+
 void NodeHeaderButton::paint(QPainter * painter, const QStyleOptionGraphicsItem * option, QWidget * widget)
 {
 #ifdef FABRICUI_TIMERS
@@ -178,8 +174,7 @@ void NodeHeaderButton::paint(QPainter * painter, const QStyleOptionGraphicsItem
   int index = 2 * m_state + (m_highlighted ? 1 : 0);
   if(m_pixmaps.count() > index)
   {
-    QPixmap pixmap = m_pixmaps[index];
-    painter->drawPixmap(0, 0, s_pixmapSize, s_pixmapSize, pixmap);
+    painter->drawPixmap(0, 0, s_pixmapSize, s_pixmapSize, m_pixmaps[index]);
   }
 
   QGraphicsWidget::paint(painter, option, widget);
@@ -39,6 +39,7 @@ namespace FabricUI
       virtual void mousePressEvent(QGraphicsSceneMouseEvent * event);
       virtual void mouseMoveEvent(QGraphicsSceneMouseEvent * event);
       virtual void mouseReleaseEvent(QGraphicsSceneMouseEvent * event);
+      virtual void ungrabMouseEvent(QEvent * event);
       virtual void paint(QPainter * painter, const QStyleOptionGraphicsItem * option, QWidget * widget);
 
     signals:
@@ -55,6 +56,10 @@ namespace FabricUI
       QList<QPixmap> m_pixmaps;
       QPointF m_lastMousePos;
 
+      // Icons and their highlighted versions, shared by all the buttons
+      static QPixmap GetIconPixmap(QString const &iconDir, QString const &icon);
+      static QPixmap GetHighlightPixmap(QString const &icon, QPixmap const &pixmap, QColor color);
+
       static std::map<QString, QPixmap> s_pixmaps;
 
       static const int s_pixmapSize = 12;
@@ -56,6 +56,12 @@ void NodeLabel::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
   m_node->onMouseRelease( event );
 }
 
+void NodeLabel::ungrabMouseEvent(QEvent* event)
+{
+  m_node->onMouseUngrab();
+  TextContainer::ungrabMouseEvent( event );
+}
+
 void NodeLabel::mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event)
 {
   m_node->onMouseDoubleClicked( event );
@@ -35,6 +35,7 @@ namespace FabricUI
       virtual void mouseMoveEvent(QGraphicsSceneMouseEvent* event);
       virtual void mouseReleaseEvent(QGraphicsSceneMouseEvent* event);
       virtual void mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event);
+      virtual void ungrabMouseEvent(QEvent* event);
       virtual void displayedTextChanged() FTL_OVERRIDE;
     };
 
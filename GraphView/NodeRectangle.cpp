@@ -23,6 +23,7 @@ NodeRectangle::NodeRectangle(Node * parent)
 : QGraphicsWidget(parent)
 {
   m_node = parent;
+  m_pathsCornerRadius = -1.0f;
 }
 
 void NodeRectangle::paint(QPainter * painter, const QStyleOptionGraphicsItem * option, QWidget * widget)
@@ -43,6 +44,30 @@ void NodeRectangle::paint(QPainter * painter, const QStyleOptionGraphicsItem * o
   float nodeWidthReduction = m_node->graph()->config().nodeWidthReduction * 0.5;
   rect.adjust(nodeWidthReduction, standardPen.width() * 0.5f, -nodeWidthReduction, -standardPen.width() * 0.5f);
 
+  // Too far to see any detail : a plain rectangle is enough
+  if(m_node->levelOfDetail() == LevelOfDetail_Rectangle)
+  {
+    // ... which the view might already have drawn (see BatchRenderer)
+    if(m_node->graph()->isBatchRendering())
+    {
+#ifdef FABRICUI_TIMERS
+      timer->pause();
+#endif
+      return;
+    }
+
+    painter->fillRect(rect, m_node->isInspected() ? m_node->m_inspectedPen.color() : m_node->m_colorA);
+    if(m_node->selected())
+    {
+      painter->setPen(standardPen);
+      painter->drawRect(rect);
+    }
+#ifdef FABRICUI_TIMERS
+    timer->pause();
+#endif
+    return;
+  }
+
   QLinearGradient gradient(0.5, 0.0, 0.5, 1.0);
   gradient.setCoordinateMode(QGradient::ObjectBoundingMode);
   if ( m_node->isHighlighted() )
@@ -61,16 +86,10 @@ void NodeRectangle::paint(QPainter * painter, const QStyleOptionGraphicsItem * o
   // painter->setRenderHint(QPainter::Antialiasing,true);
   // painter->setRenderHint(QPainter::HighQualityAntialiasing,true);
 
-  QPainterPath rounded_rect;
-  rounded_rect.addRoundRect(
-    rect, int( 150.0f * m_node->m_cornerRadius / rect.width() ),
-    int( 150.0f * m_node->m_cornerRadius / rect.height() ) );
-
-  QRectF inspected_rect = rect.adjusted(-2, -2, 2, 2);
-  QPainterPath inspected_rounded_rect;
-  inspected_rounded_rect.addRoundRect(
-    inspected_rect, int( 150.0f * m_node->m_cornerRadius / inspected_rect.width() ),
-    int( 150.0f * m_node->m_cornerRadius / (inspected_rect.height() ) ) );
+  if(rect != m_pathsRect || m_node->m_cornerRadius != m_pathsCornerRadius)
+    updatePaths(rect);
+  QPainterPath const &rounded_rect = m_roundedRect;
+  QPainterPath const &inspected_rounded_rect = m_inspectedRoundedRect;
 
   // fill everything
   painter->fillPath(rounded_rect,painter->brush());     
@@ -120,3 +139,20 @@ void NodeRectangle::paint(QPainter * painter, const QStyleOptionGraphicsItem * o
   painter->setClipping(false);
   QGraphicsWidget::paint(painter, option, widget);
 }
+
+void NodeRectangle::updatePaths(QRectF const &rect)
+{
+  m_pathsRect = rect;
+  m_pathsCornerRadius = m_node->m_cornerRadius;
+
+  m_roundedRect = QPainterPath();
+  m_roundedRect.addRoundRect(
+    rect, int( 150.0f * m_pathsCornerRadius / rect.width() ),
+    int( 150.0f * m_pathsCornerRadius / rect.height() ) );
+
+  QRectF inspected_rect = rect.adjusted(-2, -2, 2, 2);
+  m_inspectedRoundedRect = QPainterPath();
+  m_inspectedRoundedRect.addRoundRect(
+    inspected_rect, int( 150.0f * m_pathsCornerRadius / inspected_rect.width() ),
+    int( 150.0f * m_pathsCornerRadius / (inspected_rect.height() ) ) );
+}
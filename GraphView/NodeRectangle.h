@@ -6,6 +6,7 @@
 #include <QGraphicsWidget>
 #include <QColor>
 #include <QPen>
+#include <QPainterPath>
 #include "GraphicItemTypes.h"
 
 namespace FabricUI
@@ -32,8 +33,16 @@ namespace FabricUI
 
     private:
 
+      void updatePaths(QRectF const &rect);
+
       Node * m_node;
 
+      // the outlines only change with the size of the node
+      QRectF m_pathsRect;
+      float m_pathsCornerRadius;
+      QPainterPath m_roundedRect;
+      QPainterPath m_inspectedRoundedRect;
+
     };
 
 
@@ -11,6 +11,7 @@
 #include <FabricUI/GraphView/SidePanel.h>
 #include <FabricUI/GraphView/Controller.h>
 
+#include <QFontMetrics>
 #include <QGraphicsLinearLayout>
 
 using namespace FabricUI::GraphView;
@@ -36,10 +37,27 @@ void Port::init(PortType portType, FTL::CStrRef dataType, QColor color)
 {
   m_portType = portType;
   m_color = color;
+  m_highlighted = false;
+  m_label = NULL;
+  m_circle = NULL;
   m_index = 0;
+  m_labelWidth = 0;
 
   setSizePolicy(QSizePolicy(QSizePolicy::Minimum, QSizePolicy::Expanding));
 
+  // the label and the circle are only created once the port
+  // is scrolled into view (see SidePanel::updateVisiblePorts)
+  setVisible(false);
+
+  setDataType( dataType, true /* updateLabelforArrays */ );
+  updateLabelWidth();
+}
+
+void Port::materialize()
+{
+  if(m_circle)
+    return;
+
   const GraphConfig & config = graph()->config();
 
   QGraphicsLinearLayout * layout = new QGraphicsLinearLayout();
@@ -55,10 +73,16 @@ void Port::init(PortType portType, FTL::CStrRef dataType, QColor color)
     config.sidePanelFontHighlightColor,
     config.sidePanelFont
     );
+  if(!m_labelSuffix.empty())
+    m_label->setSuffix( QSTRING_FROM_STL_UTF8( m_labelSuffix ) );
+  m_label->setEditable( m_sidePanel->isEditable() && allowEdits() );
 
-  setDataType( dataType, true /* updateLabelforArrays */ );
-  
   m_circle = new PinCircle(this, m_portType, this->color());
+  if(m_highlighted)
+  {
+    m_circle->setHighlighted(true);
+    m_label->setHighlighted(true);
+  }
 
   if(m_portType == PortType_Input)
   {
@@ -81,7 +105,8 @@ void Port::init(PortType portType, FTL::CStrRef dataType, QColor color)
 void Port::disableEdits()
 {
   m_allowEdits = false;
-  m_label->setEditable( false );
+  if(m_label)
+    m_label->setEditable( false );
 }
 
 Graph *Port::graph()
@@ -114,8 +139,12 @@ char const * Port::label() const
 void Port::setLabel(char const * n)
 {
   m_labelCaption = n;
-  m_label->setText(QSTRING_FROM_STL_UTF8(m_labelCaption));
+  updateLabelWidth();
+  if(m_label)
+    m_label->setText(QSTRING_FROM_STL_UTF8(m_labelCaption));
   update();
+
+  emit contentChanged();
 }
 
 QColor Port::color() const
@@ -134,8 +163,9 @@ void Port::setDataType(FTL::CStrRef dataType, bool updateLabelforArrays)
   setToolTip(dataType.c_str());
 
   // automatically change the label for array pins
-  if(updateLabelforArrays && m_label)
+  if(updateLabelforArrays)
   {
+    std::string labelSuffix;
     for (int i=4;i>=1;i--)
     {
       std::string brackets = "";
@@ -143,28 +173,52 @@ void Port::setDataType(FTL::CStrRef dataType, bool updateLabelforArrays)
         brackets += "[]";
       if (m_dataType.length() > brackets.length())
       {
-        if (m_dataType.substr(m_dataType.length() - brackets.length()) == brackets && m_labelSuffix != brackets)
+        if (m_dataType.substr(m_dataType.length() - brackets.length()) == brackets)
         {
-          m_labelSuffix = (i < 4 ? brackets : "[]...[]");
-          m_label->setText( QSTRING_FROM_STL_UTF8( m_labelCaption ) );
-          m_label->setSuffix( QSTRING_FROM_STL_UTF8( m_labelSuffix ) );
-          return;
+          labelSuffix = (i < 4 ? brackets : "[]...[]");
+          break;
         }
       }
     }
-    if(m_labelSuffix.length() > 0)
+    if(labelSuffix != m_labelSuffix)
     {
-      m_labelSuffix = "";
-      m_label->setText( QSTRING_FROM_STL_UTF8( m_labelCaption ) );
-      m_label->setSuffix( QSTRING_FROM_STL_UTF8( m_labelSuffix ) );
+      m_labelSuffix = labelSuffix;
+      updateLabelWidth();
+      if(m_label)
+      {
+        m_label->setText( QSTRING_FROM_STL_UTF8( m_labelCaption ) );
+        m_label->setSuffix( QSTRING_FROM_STL_UTF8( m_labelSuffix ) );
+      }
+      emit contentChanged();
     }
   }
 }
 
+void Port::updateLabelWidth()
+{
+  // same measure as TextContainer::refresh
+  QFontMetrics const &metrics =
+    GraphConfig::FontMetrics( graph()->config().sidePanelFont );
+  m_labelWidth = metrics.size(
+    Qt::TextSingleLine,
+    QSTRING_FROM_STL_UTF8( m_labelCaption + m_labelSuffix )
+    ).width();
+}
+
+qreal Port::rowWidth() const
+{
+  if(m_label)
+    return effectiveSizeHint(Qt::PreferredSize).width();
+
+  const GraphConfig & config = graph()->config();
+  return 2.0f * config.pinRadius + config.sidePanelPortLabelSpacing + m_labelWidth;
+}
+
 void Port::setColor(QColor color)
 {
   m_color = color;
-  m_circle->setColor(m_color);
+  if(m_circle)
+    m_circle->setColor(m_color);
 }
 
 bool Port::highlighted() const
@@ -176,8 +230,11 @@ void Port::setHighlighted(bool state)
 {
   if(m_highlighted != state)
   {
-    m_circle->setHighlighted(state);
-    m_label->setHighlighted(state);
+    if(m_circle)
+    {
+      m_circle->setHighlighted(state);
+      m_label->setHighlighted(state);
+    }
     m_highlighted = state;
   }
 }
@@ -255,7 +312,15 @@ bool Port::canConnectTo(
 
 QPointF Port::connectionPos(PortType pType) const
 {
-  return m_circle->centerInSceneCoords();
+  // computed from the row of the port, so that it is also
+  // valid for the ports that are scrolled out of view
+  QRectF rect = m_sidePanel->portRect( m_index );
+  float radius = graph()->config().pinRadius;
+  QPointF center(
+    m_portType == PortType_Input ? rect.left() + radius : rect.right() - radius,
+    rect.center().y()
+    );
+  return m_sidePanel->itemGroup()->mapToScene( center );
 }
 
 void Port::contextMenuEvent( QGraphicsSceneContextMenuEvent* event )
@@ -97,6 +97,10 @@ namespace FabricUI
         { return m_allowEdits; }
       void disableEdits();
 
+      // false until the port has been scrolled into view once
+      bool isMaterialized() const
+        { return m_circle != NULL; }
+
     signals:
 
       void positionChanged();
@@ -107,6 +111,11 @@ namespace FabricUI
 
       void setIndex(unsigned id) { m_index = id; }
 
+      // creates the label and the circle
+      void materialize();
+      // the width of the port in the SidePanel, known without materializing it
+      qreal rowWidth() const;
+
       void contextMenuEvent( QGraphicsSceneContextMenuEvent* event ) FTL_OVERRIDE;
 
       PinCircle * findPinCircle( QPointF pos ) FTL_OVERRIDE { return circle(); }
@@ -114,6 +123,7 @@ namespace FabricUI
     private:
 
       void init(PortType portType, FTL::CStrRef dataType, QColor color);
+      void updateLabelWidth();
 
       SidePanel * m_sidePanel;
       std::string m_name;
@@ -125,6 +135,7 @@ namespace FabricUI
       bool m_highlighted;
       TextContainer * m_label;
       PinCircle * m_circle;
+      qreal m_labelWidth;
       unsigned int m_index;
       bool m_allowEdits;
       QPointF m_dragStartPosition;
@@ -12,10 +12,12 @@
 #include <FabricUI/GraphView/ProxyPort.h>
 
 #include <QDebug>
+#include <QFontMetrics>
 #include <QPainter>
 #include <QGraphicsSceneMouseEvent>
 #include <QGraphicsView>
 
+#include <algorithm>
 #include <float.h>
 #include <math.h>
 
@@ -26,13 +28,25 @@ SidePanel::SidePanel(Graph * parent, PortType portType, QColor color)
   , m_proxyPort( NULL )
   , m_proxyPortDummy( NULL )
   , m_dragDstY( 0 )
+  , m_editable( false )
 {
   m_itemGroup = new SidePanelItemGroup(this);
   m_itemGroup->setSizePolicy(QSizePolicy(QSizePolicy::Minimum, QSizePolicy::Expanding));
   m_itemGroupScroll = 0.0f;
+  m_viewHeight = 0.0f;
 
   const GraphConfig & config = parent->config();
 
+  // all the ports share the same font, so they all have the same height
+  m_portsTop = 0;
+  m_portRowHeight = qMax(
+    qreal( GraphConfig::FontMetrics( config.sidePanelFont ).height() ),
+    qreal( 2.0f * config.pinRadius )
+    );
+  m_portRowStep = m_portRowHeight + config.sidePanelSpacing;
+  m_portsWidth = 0;
+  m_contentWidth = 0;
+
   m_graph = parent;
   m_color = color;
   if(!m_color.isValid())
@@ -51,6 +65,7 @@ SidePanel::SidePanel(Graph * parent, PortType portType, QColor color)
     // [FE-7155] m_proxyPortDummy is an invisible (empty string) label which replaces the Expose port,
     // and makes sure that the ports below are at the same position as if there were an Expose port
     m_proxyPortDummy = new TextContainer(this, "", config.sidePanelFontColor, config.sidePanelFontHighlightColor, config.sidePanelFont);
+    m_proxyPortDummy->setParentItem(m_itemGroup);
   }
   else
     m_proxyPort = new ProxyPort(this, m_portType);
@@ -96,6 +111,7 @@ void SidePanel::addFixedPort( FixedPort *fixedPort )
 
   fixedPort->setIndex( m_fixedPorts.size() );
   m_fixedPorts.push_back( fixedPort );
+  QObject::connect(fixedPort, SIGNAL(contentChanged()), this, SLOT(onPortContentChanged()));
 
   resetLayout();
   updateItemGroupScroll();
@@ -107,6 +123,8 @@ void SidePanel::addPort( Port *port )
 
   port->setIndex( m_ports.size() );
   m_ports.push_back( port );
+  QObject::connect(port, SIGNAL(contentChanged()), this, SLOT(onPortContentChanged()));
+  m_portsWidth = qMax( m_portsWidth, port->rowWidth() );
 
   resetLayout();
   updateItemGroupScroll();
@@ -147,6 +165,10 @@ void SidePanel::removePort( Port *port )
   assert( index != m_ports.size() );
 
   m_ports.erase( m_ports.begin() + index );
+  m_visiblePorts.erase(
+    std::remove( m_visiblePorts.begin(), m_visiblePorts.end(), port ),
+    m_visiblePorts.end()
+    );
 
   for ( size_t i=0; i<m_ports.size(); i++ )
     m_ports[i]->setIndex( i );
@@ -154,6 +176,7 @@ void SidePanel::removePort( Port *port )
   scene()->removeItem( port );
   delete port;
 
+  updatePortsWidth();
   resetLayout();
   updateItemGroupScroll();
 }
@@ -169,20 +192,24 @@ void SidePanel::reorderPorts(QStringList names)
     Port *portPtr = port( nameCStr );
     if ( !portPtr )
       continue; // "exec" port
-    portPtr->setIndex( i );
+    // the index is the row of the port, see portRect()
+    portPtr->setIndex( ports.size() );
     ports.push_back( portPtr );
   }
 
   m_ports = ports;
   resetLayout();
+  updateVisiblePorts();
 }
 
 void SidePanel::setEditable( bool canEdit )
 {
+  m_editable = canEdit;
   for( size_t i = 0; i < m_ports.size(); i++ )
   {
     Port* port = m_ports[i];
-    port->m_label->setEditable( canEdit && port->allowEdits() );
+    if ( port->m_label )
+      port->m_label->setEditable( canEdit && port->allowEdits() );
   }
 }
 
@@ -203,6 +230,7 @@ void SidePanel::reorderFixedPorts(QStringList names)
 
   m_fixedPorts = fixedPorts;
   resetLayout();
+  updateVisiblePorts();
 }
 
 FixedPort *SidePanel::fixedPort( FTL::StrRef name )
@@ -304,6 +332,12 @@ void SidePanel::onItemGroupResized()
   setMaximumWidth(m_itemGroup->size().width());
 }
 
+void SidePanel::onPortContentChanged()
+{
+  updatePortsWidth();
+  resetLayout();
+}
+
 void SidePanel::resizeEvent(QGraphicsSceneResizeEvent * event)
 {
   QGraphicsWidget::resizeEvent(event);
@@ -312,50 +346,108 @@ void SidePanel::resizeEvent(QGraphicsSceneResizeEvent * event)
   updateItemGroupScroll(event->newSize().height());
 }
 
+void SidePanel::updatePortsWidth()
+{
+  m_portsWidth = 0;
+  for(size_t i=0;i<m_ports.size();i++)
+    m_portsWidth = qMax(m_portsWidth, m_ports[i]->rowWidth());
+}
+
+// Places the items of the panel without a QGraphicsLayout: the few
+// header items (proxy port and fixed ports) are stacked according to
+// their size hints, and the ports are laid out as rows of the same height
+// so that the position of any of them is known without materializing it.
 void SidePanel::resetLayout()
 {
   const GraphConfig & config = graph()->config();
   float contentMargins = config.sidePanelContentMargins;
 
-  QGraphicsLinearLayout *portsLayout = new QGraphicsLinearLayout();
-  portsLayout->setContentsMargins(contentMargins, contentMargins, contentMargins, contentMargins);
-  portsLayout->setSpacing(config.sidePanelSpacing);
-  portsLayout->setOrientation(Qt::Vertical);
+  QGraphicsWidget *header = m_proxyPort;
+  if (!header)
+    header = m_proxyPortDummy;
 
-  if (m_proxyPort)
+  qreal contentWidth = m_portsWidth;
+  contentWidth = qMax(contentWidth, header->effectiveSizeHint(Qt::PreferredSize).width());
+  for(size_t i=0;i<m_fixedPorts.size();i++)
+    contentWidth = qMax(contentWidth, m_fixedPorts[i]->effectiveSizeHint(Qt::PreferredSize).width());
+  m_contentWidth = contentWidth;
+
+  // the items are right aligned, and grow up to the width of the panel
+  // when their size policy allows it
+  qreal y = contentMargins;
+  std::vector<QGraphicsWidget *> headerItems;
+  headerItems.push_back(header);
+  headerItems.insert(headerItems.end(), m_fixedPorts.begin(), m_fixedPorts.end());
+  for(size_t i=0;i<headerItems.size();i++)
   {
-    portsLayout->addItem(m_proxyPort);
-    portsLayout->setAlignment(m_proxyPort, Qt::AlignRight | Qt::AlignTop);
+    QGraphicsWidget *item = headerItems[i];
+    QSizeF size = item->effectiveSizeHint(Qt::PreferredSize);
+    qreal width = qMin(contentWidth, item->effectiveSizeHint(Qt::MaximumSize).width());
+    item->setGeometry(QRectF(contentMargins + contentWidth - width, y, width, size.height()));
+    y += size.height() + (i == 0? 20: config.sidePanelSpacing);
   }
-  if (m_proxyPortDummy)
+  m_portsTop = y;
+
+  for(size_t i=0;i<m_visiblePorts.size();i++)
+    m_visiblePorts[i]->setGeometry(portRect(m_visiblePorts[i]->index()));
+
+  QSizeF groupSize(
+    contentWidth + 2.0f * contentMargins,
+    m_portsTop + m_ports.size() * m_portRowStep + contentMargins
+    );
+  m_itemGroup->setPreferredSize(groupSize);
+  m_itemGroup->resize(groupSize);
+
+  m_requiresToSendSignalsForPorts = true;
+}
+
+QRectF SidePanel::portRect( unsigned index ) const
+{
+  return QRectF(
+    m_graph->config().sidePanelContentMargins,
+    m_portsTop + index * m_portRowStep,
+    m_contentWidth,
+    m_portRowHeight
+    );
+}
+
+// Shows the ports of the rows in view (plus one on each side), creating
+// their graphics items the first time, and hides the previously visible
+// ones that went out of view. Only touches the visible ports, so it can
+// be called for each scroll step.
+void SidePanel::updateVisiblePorts()
+{
+  size_t begin = 0;
+  size_t end = 0;
+  if(m_portRowStep > 0.0f && m_viewHeight > 0.0f)
   {
-    portsLayout->addItem(m_proxyPortDummy);
-    portsLayout->setAlignment(m_proxyPortDummy, Qt::AlignRight | Qt::AlignTop);
+    qreal top = -m_itemGroupScroll - m_portsTop;
+    qreal bottom = top + m_viewHeight;
+    qreal first = floor(top / m_portRowStep) - 1.0;
+    qreal last = ceil(bottom / m_portRowStep) + 1.0;
+    begin = size_t( qBound( qreal(0), first, qreal(m_ports.size()) ) );
+    end = size_t( qBound( qreal(0), last, qreal(m_ports.size()) ) );
   }
-  portsLayout->setItemSpacing(0, 20);
 
-  for(size_t i=0;i<m_fixedPorts.size();i++)
+  std::vector<Port*> visiblePorts;
+  visiblePorts.reserve(end - begin);
+  for(size_t i=begin;i<end;i++)
   {
-    portsLayout->addItem(m_fixedPorts[i]);
-    portsLayout->setAlignment(m_fixedPorts[i], Qt::AlignRight | Qt::AlignTop);
-    QObject::connect(m_fixedPorts[i], SIGNAL(contentChanged()), this, SLOT(onItemGroupResized()));
+    Port *port = m_ports[i];
+    port->materialize();
+    port->setGeometry(portRect(i));
+    port->setVisible(true);
+    visiblePorts.push_back(port);
   }
 
-  for(size_t i=0;i<m_ports.size();i++)
+  for(size_t i=0;i<m_visiblePorts.size();i++)
   {
-    portsLayout->addItem(m_ports[i]);
-    portsLayout->setAlignment(m_ports[i], Qt::AlignRight | Qt::AlignTop);
-    QObject::connect(m_ports[i], SIGNAL(contentChanged()), this, SLOT(onItemGroupResized()));
+    Port *port = m_visiblePorts[i];
+    if(port->index() < begin || port->index() >= end)
+      port->setVisible(false);
   }
 
-  portsLayout->addStretch(2);
-
-  m_itemGroup->setLayout(portsLayout);
-
-  // Set the group size according to its content
-  m_itemGroup->adjustSize();
-
-  m_requiresToSendSignalsForPorts = true;
+  m_visiblePorts.swap(visiblePorts);
 }
 
 void SidePanel::scroll(float delta)
@@ -398,6 +490,8 @@ void SidePanel::updateItemGroupScroll(float height)
   }
 
   m_itemGroup->setTransform(QTransform::fromTranslate(0, m_itemGroupScroll), false);
+  m_viewHeight = height;
+  updateVisiblePorts();
 
   // [Julien]
   // Update the image overlay when panels are resized.
@@ -430,7 +524,7 @@ void SidePanel::onDraggingPort( const QGraphicsSceneMouseEvent* event, Port* dra
       for ( size_t i = 0; i < m_ports.size(); ++i )
       {
         Port *port = static_cast<Port *>( m_ports[i] );
-        qreal portY = m_itemGroup->mapToParent( port->pos() ).y() - 5;
+        qreal portY = m_itemGroup->mapToParent( portRect( i ).topLeft() ).y() - 5;
         qreal portDist = fabs( portY - eventY );
         if ( portDist < bestDist )
         {
@@ -455,9 +549,10 @@ void SidePanel::onDraggingPort( const QGraphicsSceneMouseEvent* event, Port* dra
 
       // See if drag is to end
       QGraphicsItem *lastPort = m_ports.back();
+      QRectF lastPortRect = portRect( m_ports.size() - 1 );
       qreal lastPortBottomY =
-          m_itemGroup->mapToParent( lastPort->pos() ).y()
-        + lastPort->boundingRect().height() + 7;
+          m_itemGroup->mapToParent( lastPortRect.topLeft() ).y()
+        + lastPortRect.height() + 7;
       qreal lastPortDist = fabs( lastPortBottomY - eventY );
       if ( lastPortDist < bestDist )
       {
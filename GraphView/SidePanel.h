@@ -66,6 +66,11 @@ namespace FabricUI
 
       ConnectionTarget *getConnectionTarget( FTL::StrRef name );
 
+      // The row of a port, in itemGroup() coordinates. Only the ports
+      // around the visible part of the panel are materialized and
+      // shown, the others are only positioned through their row.
+      QRectF portRect( unsigned index ) const;
+
       virtual void mouseMoveEvent(QGraphicsSceneMouseEvent * event);
       virtual void mousePressEvent( QGraphicsSceneMouseEvent* ) FTL_OVERRIDE;
       virtual void mouseReleaseEvent(QGraphicsSceneMouseEvent * event);
@@ -88,6 +93,9 @@ namespace FabricUI
       void reorderPorts( QStringList names );
 
       void setEditable( bool isEditable );
+      // also applied to the ports materialized later
+      bool isEditable() const
+        { return m_editable; }
 
       void scroll(float delta);
       void updateItemGroupScroll(float height = 0.0f);
@@ -101,10 +109,13 @@ namespace FabricUI
 
     private slots:
       void onItemGroupResized();
+      void onPortContentChanged();
 
     private:
 
       void resetLayout();
+      void updatePortsWidth();
+      void updateVisiblePorts();
 
       Graph * m_graph;
       QColor m_color;
@@ -113,6 +124,15 @@ namespace FabricUI
       bool m_requiresToSendSignalsForPorts;
       SidePanelItemGroup * m_itemGroup;
       float m_itemGroupScroll;
+      float m_viewHeight;
+
+      // rows of the ports, see portRect()
+      qreal m_portsTop;
+      qreal m_portRowHeight;
+      qreal m_portRowStep;
+      qreal m_portsWidth;
+      qreal m_contentWidth;
+      std::vector<Port*> m_visiblePorts;
 
       ProxyPort* m_proxyPort;
       TextContainer * m_proxyPortDummy;
@@ -122,6 +142,7 @@ namespace FabricUI
       QString m_dragSrcPortName;
       QString m_dragDstPortName;
       qreal m_dragDstY;
+      bool m_editable;
     };
 
   };
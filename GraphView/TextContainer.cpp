@@ -1,6 +1,7 @@
 // Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
 
 #include "TextContainer.h"
+#include "GraphConfig.h"
 #include <QAbstractTextDocumentLayout>
 #include <QPainter>
 #include <QPalette>
@@ -55,7 +56,7 @@ void TextContainer::setSuffix( QString const &suffix )
 
 void TextContainer::refresh()
 {
-  QFontMetrics metrics( m_font );
+  QFontMetrics const &metrics = GraphConfig::FontMetrics( m_font );
   QString displayedText = m_editing ?
     m_editableTextItem->toPlainText() : m_fixedTextItem->text();
   QSize size = metrics.size( Qt::TextSingleLine, displayedText );
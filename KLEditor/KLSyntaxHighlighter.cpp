@@ -3,6 +3,8 @@
 #include "KLSyntaxHighlighter.h"
 #include "Helpers.h"
 
+#include <algorithm>
+
 using namespace FabricUI::KLEditor;
 using namespace FabricServices;
 
@@ -11,133 +13,168 @@ KLSyntaxHighlighter::KLSyntaxHighlighter(QTextDocument * document, ASTWrapper::K
 , CodeCompletion::KLSyntaxHighlighter(manager)
 {
   m_config = config;
+  m_formatsRevision = -1;
 }
 
 KLSyntaxHighlighter::~KLSyntaxHighlighter()
 {
 }
 
+static bool FormatStartsBefore(const CodeCompletion::KLSyntaxHighlighter::Format & a, const CodeCompletion::KLSyntaxHighlighter::Format & b)
+{
+  return a.start < b.start;
+}
+
+static bool FormatEndsBefore(const CodeCompletion::KLSyntaxHighlighter::Format & format, int pos)
+{
+  return int(format.start + format.length) < pos;
+}
+
+void KLSyntaxHighlighter::updateFormats()
+{
+  // QSyntaxHighlighter::rehighlight always starts with the first block:
+  // formats are recomputed for it as well, since the highlights or the
+  // AST might have changed without any edit of the document
+  int revision = document()->revision();
+  if(revision == m_formatsRevision && currentBlock() != document()->firstBlock())
+    return;
+  m_formatsRevision = revision;
+
+  const std::vector<Format> & formats = getHighlightFormats(QStringToStl(document()->toPlainText()));
+
+  m_baseFormats.clear();
+  m_overlayFormats.clear();
+  for(size_t i=0;i<formats.size();i++)
+  {
+    if(formats[i].token == Token_Error || formats[i].token == Token_Highlight)
+      m_overlayFormats.push_back(formats[i]);
+    else
+      m_baseFormats.push_back(formats[i]);
+  }
+  std::stable_sort(m_baseFormats.begin(), m_baseFormats.end(), FormatStartsBefore);
+}
+
 void KLSyntaxHighlighter::highlightBlock(const QString &text)
 {
   if(!isEnabled())
     return;
 
-  const std::vector<Format> & formats = getHighlightFormats(QStringToStl(document()->toPlainText()));
+  updateFormats();
 
   QTextBlock block = currentBlock();
   int start = block.position();
   int length = block.length();
 
-  for(size_t i=0;i<formats.size();i++)
+  // the base tokens don't overlap, so their ends are sorted as well:
+  // skip all the ones ending before this block
+  BlockState state = BlockState_Default;
+  std::vector<Format>::const_iterator it = std::lower_bound(
+    m_baseFormats.begin(), m_baseFormats.end(), start, FormatEndsBefore);
+  for(;it != m_baseFormats.end() && int(it->start) <= start + length;it++)
   {
-    if(int(formats[i].start + formats[i].length) < start)
-      continue;
-    if(int(formats[i].start) > start + length)
-      continue;
-
-    int localStart = formats[i].start - start;
-    int localLength = formats[i].length;
-    if(localStart < 0)
+    applyFormat(*it, start, length);
+
+    if(int(it->start + it->length) > start + length)
     {
-      localLength += localStart;
-      localStart = 0;
+      if(it->token == Token_Comment)
+        state = BlockState_InComment;
+      else if(it->token == Token_String)
+        state = BlockState_InString;
     }
+  }
+
+  // there are only a few of those
+  for(size_t i=0;i<m_overlayFormats.size();i++)
+    applyFormat(m_overlayFormats[i], start, length);
+
+  setCurrentBlockState(state);
+}
 
-    if(localLength < 0)
-      continue;
-    else if(localLength + localStart > length)
-      localLength = length - localStart;
+void KLSyntaxHighlighter::applyFormat(const Format & highlightFormat, int start, int length)
+{
+  if(int(highlightFormat.start + highlightFormat.length) < start)
+    return;
+  if(int(highlightFormat.start) > start + length)
+    return;
+
+  int localStart = highlightFormat.start - start;
+  int localLength = highlightFormat.length;
+  if(localStart < 0)
+  {
+    localLength += localStart;
+    localStart = 0;
+  }
+
+  if(localLength < 0)
+    return;
+  else if(localLength + localStart > length)
+    localLength = length - localStart;
 
-    QTextCharFormat textFormat;
-    switch(formats[i].token)
+  QTextCharFormat textFormat;
+  switch(highlightFormat.token)
+  {
+    case Token_Comment:
     {
-      case Token_Comment:
-      {
-        textFormat = m_config.formatForComment;
-        setFormat(localStart, localLength, textFormat);
-        break;
-      }
-      case Token_String:
-      {
-        textFormat = m_config.formatForString;
-        setFormat(localStart, localLength, textFormat);
-        break;
-      }
-      case Token_Number:
-      {
-        textFormat = m_config.formatForNumber;
-        setFormat(localStart, localLength, textFormat);
-        break;
-      }
-      case Token_Keyword:
-      {
-        textFormat = m_config.formatForKeyword;
-        setFormat(localStart, localLength, textFormat);
-        break;
-      }
-      case Token_Type:
-      {
-        textFormat = m_config.formatForType;
-        setFormat(localStart, localLength, textFormat);
-        break;
-      }
-      case Token_Constant:
-      {
-        textFormat = m_config.formatForConstant;
-        setFormat(localStart, localLength, textFormat);
-        break;
-      }
-      case Token_Function:
-      case Token_Method:
-      {
-        textFormat = m_config.formatForMethod;
-        setFormat(localStart, localLength, textFormat);
-        break;
-      }
-      case Token_Error:
-      case Token_Highlight:
+      textFormat = m_config.formatForComment;
+      setFormat(localStart, localLength, textFormat);
+      break;
+    }
+    case Token_String:
+    {
+      textFormat = m_config.formatForString;
+      setFormat(localStart, localLength, textFormat);
+      break;
+    }
+    case Token_Number:
+    {
+      textFormat = m_config.formatForNumber;
+      setFormat(localStart, localLength, textFormat);
+      break;
+    }
+    case Token_Keyword:
+    {
+      textFormat = m_config.formatForKeyword;
+      setFormat(localStart, localLength, textFormat);
+      break;
+    }
+    case Token_Type:
+    {
+      textFormat = m_config.formatForType;
+      setFormat(localStart, localLength, textFormat);
+      break;
+    }
+    case Token_Constant:
+    {
+      textFormat = m_config.formatForConstant;
+      setFormat(localStart, localLength, textFormat);
+      break;
+    }
+    case Token_Function:
+    case Token_Method:
+    {
+      textFormat = m_config.formatForMethod;
+      setFormat(localStart, localLength, textFormat);
+      break;
+    }
+    case Token_Error:
+    case Token_Highlight:
+    {
+      if(highlightFormat.token == Token_Error)
+        textFormat = m_config.formatForError;
+      else
+        textFormat = m_config.formatForHighlight;
+
+      for(int j=localStart;j<localStart+localLength;j++)
       {
-        if(formats[i].token == Token_Error)
-          textFormat = m_config.formatForError;
-        else
-          textFormat = m_config.formatForHighlight;
-
-        for(int j=localStart;j<localStart+localLength;j++)
-        {
-          QTextCharFormat currFormat = format(j);
-          currFormat.merge(textFormat);
-          setFormat(j, 1, currFormat);
-        }
-        break;
+        QTextCharFormat currFormat = format(j);
+        currFormat.merge(textFormat);
+        setFormat(j, 1, currFormat);
       }
-      case Token_Other:
-      case Token_EOF:
-      case Token_NumItems:
-        break;
+      break;
     }
+    case Token_Other:
+    case Token_EOF:
+    case Token_NumItems:
+      break;
   }
-
-  setCurrentBlockState(0);
-
-  // int startIndex = 0;
-  // if (previousBlockState() != 1)
-  //   startIndex = commentStartExpression.indexIn(text);
-
-  // while (startIndex >= 0)
-  // {
-  //   int endIndex = commentEndExpression.indexIn(text, startIndex);
-  //   int commentLength;
-  //   if (endIndex == -1)
-  //   {
-  //     setCurrentBlockState(1);
-  //     commentLength = text.length() - startIndex;
-  //   }
-  //   else
-  //   {
-  //     commentLength = endIndex - startIndex
-  //       + commentEndExpression.matchedLength();
-  //   }
-  //   setFormat(startIndex, commentLength, multiLineCommentFormat);
-  //   startIndex = commentStartExpression.indexIn(text, startIndex + commentLength);
-  // }
 }
@@ -13,6 +13,8 @@
 #include <ASTWrapper/KLASTManager.h>
 #include <CodeCompletion/KLSyntaxHighlighter.h>
 
+#include <vector>
+
 namespace FabricUI
 {
 
@@ -33,7 +35,28 @@ namespace FabricUI
       virtual void highlightBlock(const QString &text);
 
     private:
+
+      // stored as the QTextBlock user state: tells if the block ends
+      // within a token spanning over several lines, so that the
+      // following blocks get highlighted again when this changes
+      enum BlockState
+      {
+        BlockState_Default = 0,
+        BlockState_InComment = 1,
+        BlockState_InString = 2
+      };
+
+      void updateFormats();
+      void applyFormat(const Format & highlightFormat, int blockStart, int blockLength);
+
       EditorConfig m_config;
+
+      // formats of the whole document, computed once per revision of
+      // the document and sorted by start. error and highlight formats
+      // are merged on top of the others so they are kept separately.
+      int m_formatsRevision;
+      std::vector<Format> m_baseFormats;
+      std::vector<Format> m_overlayFormats;
     };
 
   };
@@ -599,6 +599,8 @@ class CanvasWindow(QtGui.QMainWindow):
         self.timeLine.updateTime(1)
         self.dfgWidget.stylesReloaded.connect(self.timeLine.reloadStyles)
         self.timeLine.frameChanged.connect(self.onFrameChanged)
+        # Don't play the next frame before the viewport has drawn this one
+        self.viewport.redrawn.connect(self.timeLine.onFrameDrawn)
         self.scriptEditor.setTimeLineGlobal(self.timeLine)
 
         self.timelineFrame = QtGui.QFrame()
@@ -1495,6 +1497,14 @@ class CanvasWindow(QtGui.QMainWindow):
         """
 
         if graph != self.currentGraph:
+            # The previous graph can be displayed again later on (see
+            # DFGWidget::onExecChanged), don't connect to it twice.
+            if self.currentGraph is not None:
+                try:
+                    self.currentGraph.nodeEditRequested.disconnect(self.onNodeEditRequested)
+                    self.currentGraph.nodeInspectRequested.disconnect(self.onNodeInspectRequested)
+                except RuntimeError:
+                    pass
             graph = self.dfgWidget.getUIGraph()
             graph.nodeEditRequested.connect(self.onNodeEditRequested)
             graph.nodeInspectRequested.connect(self.onNodeInspectRequested)
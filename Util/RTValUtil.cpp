@@ -70,6 +70,50 @@ RTVal RTValUtil::toKLRTVal(
   return RTVal();
 }
 
+RTVal RTValUtil::convert(
+  RTVal rtVal_,
+  QString const&type)
+{
+  FABRIC_CATCH_BEGIN();
+
+  RTVal rtVal = toRTVal(rtVal_);
+  if( !rtVal.isValid() || getType(rtVal) == type )
+    return rtVal;
+
+  Context context = rtVal.getContext();
+
+  if( rtVal.isArray() && type.endsWith("[]") )
+  {
+    QString elementType = type.left(type.size() - 2);
+
+    RTVal array = RTVal::Construct(
+      context,
+      type.toUtf8().constData(),
+      0,
+      0);
+
+    unsigned size = rtVal.getArraySize();
+    array.setArraySize(size);
+    for(unsigned i=0; i<size; ++i)
+      array.setArrayElement(
+        i, 
+        convert(rtVal.getArrayElementRef(i), elementType)
+        );
+
+    return array;
+  }
+
+  return RTVal::Construct(
+    context,
+    type.toUtf8().constData(),
+    1,
+    &rtVal);
+
+  FABRIC_CATCH_END("RTValUtil::convert");
+
+  return RTVal();
+}
+
 QString RTValUtil::toJSON(
   RTVal rtVal_)
 {
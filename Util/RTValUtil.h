@@ -43,6 +43,15 @@ class RTValUtil
       FabricCore::RTVal rtVal
       );
 
+    /// Converts the C++ RTVal to the KL type 'type', 
+    /// using the KL conversion constructors (element by  
+    /// element for arrays), without going through JSON.
+    /// Returns the C++ RTVal if it's already of this type.
+    static FabricCore::RTVal convert(
+      FabricCore::RTVal rtVal,
+      QString const&type
+      );
+
     /// Extracts in JSON the C++ RTVal.
     static QString toJSON(
       FabricCore::RTVal rtVal
@@ -3,6 +3,7 @@
 //
 
 #include "ArrayViewItem.h"
+#include "DeferredViewItem.h"
 #include "ViewItemFactory.h"
 #include "QVariantRTVal.h"
 #include "VEIntSpinBox.h"
@@ -27,6 +28,7 @@ ArrayViewItem::ArrayViewItem( QString name,
   , m_minIndexEdit( NULL )
   , m_maxIndexEdit( NULL )
   , m_arraySizeEdit( NULL )
+  , m_childInteractionCount( 0 )
 {
   m_widget = new QWidget();
 
@@ -137,8 +139,37 @@ void ArrayViewItem::doAppendChildViewItems( QList<BaseViewItem *>& items )
 {
   try
   {
-    // Construct a child for each instance between min & max
+    if (m_min >= m_max)
+      return;
+
+    // TODO : update when the parent path (through metadata) changed
+    for (int i = m_min; i < m_max; ++i)
+    {
+      if( m_itemsMetadata.find( i ) == m_itemsMetadata.end() )
+        m_itemsMetadata.insert( ArrayItemMetadataMap::value_type( i,
+          new ArrayItemMetadata( &m_metadata, i ) ) );
+    }
+
+    // All the elements share the same type : build the first
+    // one to know how the others will look like in the tree
     ViewItemFactory* factory = ViewItemFactory::GetInstance();
+    bool childrenHaveChildren = false;
+    {
+      BaseViewItem* probeItem =
+        factory->createViewItem(
+          QString(),
+          toVariant( m_val.getArrayElementRef( m_min ) ),
+          m_itemsMetadata.find( m_min )->second
+          );
+      if (probeItem == NULL)
+        return;
+      childrenHaveChildren = probeItem->hasChildren();
+      probeItem->deleteMe();
+    }
+
+    // Construct a child for each instance between min & max.
+    // The actual ViewItems (and their widgets) are only created
+    // once their row is scrolled into view.
     char childName[64];
     for (int i = m_min; i < m_max; ++i)
     {
@@ -146,23 +177,16 @@ void ArrayViewItem::doAppendChildViewItems( QList<BaseViewItem *>& items )
 
       FabricCore::RTVal childVal = m_val.getArrayElementRef( i );
 
-      // TODO : update when the parent path (through metadata) changed
-      if( m_itemsMetadata.find( i ) == m_itemsMetadata.end() )
-        m_itemsMetadata.insert( ArrayItemMetadataMap::value_type( i,
-          new ArrayItemMetadata( &m_metadata, i ) ) );
-
       BaseViewItem* childItem =
-        factory->createViewItem(
+        new DeferredViewItem(
           childName,
           toVariant( childVal ),
-          m_itemsMetadata.find( i )->second
+          m_itemsMetadata.find( i )->second,
+          childrenHaveChildren
           );
 
-      if (childItem != NULL)
-      {
-        connectChild( i - m_min, childItem );
-        items.push_back( childItem );
-      }
+      connectChild( i - m_min, childItem );
+      items.push_back( childItem );
     }
   }
   catch (FabricCore::Exception e)
@@ -172,25 +196,49 @@ void ArrayViewItem::doAppendChildViewItems( QList<BaseViewItem *>& items )
   }
 }
 
+void ArrayViewItem::onChildInteractionBegin( int index )
+{
+  if (m_childInteractionCount++ == 0)
+    m_editedVal = FabricCore::RTVal();
+  BaseComplexViewItem::onChildInteractionBegin( index );
+}
+
 void ArrayViewItem::onChildViewValueChanged( int index, QVariant value )
 {
   if (m_val.isValid() && m_val.isArray())
   {
     // FE-8822, we need to clone the array 'm_val' 
     // since it references directly the model array.
-    FabricCore::RTVal cloneVal = m_val.clone();
+    // During an interaction (eg, dragging a spinbox) the clone is
+    // kept and only the edited element is set on the following changes:
+    // the model value at the beginning of the interaction is untouched.
+    if (!m_editedVal.isValid())
+      m_editedVal = m_val.clone();
 
     // We cannot simply create a new RTVal based on the QVariant type, as 
     // we have to set the type exactly the same as the original.  Get the
     // original child value to ensure the new value matches the internal type
     int arrayIndex = index + m_min;
-    FabricCore::RTVal oldChildVal = cloneVal.getArrayElementRef( arrayIndex );
+    FabricCore::RTVal oldChildVal = m_editedVal.getArrayElementRef( arrayIndex );
     RTVariant::toRTVal( value, oldChildVal );
-    cloneVal.setArrayElement( arrayIndex, oldChildVal );
-    emit viewValueChanged( toVariant( cloneVal ) );
+    m_editedVal.setArrayElement( arrayIndex, oldChildVal );
+    FabricCore::RTVal editedVal = m_editedVal;
+
+    // Outside of an interaction, each change is a separate edit
+    if (m_childInteractionCount == 0)
+      m_editedVal = FabricCore::RTVal();
+
+    emit viewValueChanged( toVariant( editedVal ) );
   }
 }
 
+void ArrayViewItem::onChildInteractionEnd( int index, bool accept )
+{
+  BaseComplexViewItem::onChildInteractionEnd( index, accept );
+  if (m_childInteractionCount > 0 && --m_childInteractionCount == 0)
+    m_editedVal = FabricCore::RTVal();
+}
+
 QWidget * ArrayViewItem::getWidget()
 {
   return m_widget;
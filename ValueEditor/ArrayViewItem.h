@@ -36,6 +36,13 @@ class ArrayViewItem : public BaseComplexViewItem
   class ArrayItemMetadata;
   typedef std::map<int, ArrayItemMetadata*> ArrayItemMetadataMap;
   ArrayItemMetadataMap m_itemsMetadata;
+
+  // Copy of the array being edited by the current child
+  // interaction. The array is only cloned on the first
+  // change of an interaction, the following ones only
+  // set the edited element (FE-8822).
+  FabricCore::RTVal m_editedVal;
+  int m_childInteractionCount;
  
 public:
 
@@ -51,8 +58,12 @@ public:
 
   virtual void doAppendChildViewItems( QList<BaseViewItem *>& items ) /*override*/;
 
+  virtual void onChildInteractionBegin( int index ) /*override*/;
+
   virtual void onChildViewValueChanged( int index, QVariant value ) /*override*/;
 
+  virtual void onChildInteractionEnd( int index, bool accept ) /*override*/;
+
   virtual QWidget * getWidget() /*override*/;
 
   virtual void deleteMe() /*override*/ { delete this; };
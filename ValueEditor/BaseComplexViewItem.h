@@ -49,13 +49,13 @@ public:
   // via this method and let the system manage adding the parent's items
   virtual void doAppendChildViewItems( QList<BaseViewItem *>& items ) {};
 
-  void onChildInteractionBegin( int index )
+  virtual void onChildInteractionBegin( int index )
     { emit interactionBegin(); }
 
   // Implement this slot if we need to react when a child changes
   virtual void onChildViewValueChanged( int index, QVariant value ) {};
 
-  void onChildInteractionEnd( int index, bool accept )
+  virtual void onChildInteractionEnd( int index, bool accept )
     { emit interactionEnd( accept ); }
 
   // This function should be called to trigger an update to our children.
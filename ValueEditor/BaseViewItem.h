@@ -108,6 +108,11 @@ public:
     QTreeWidget* treeWidget,
     QTreeWidgetItem * treeWidgetItem );
 
+  // Return true if this ViewItem should not build its widgets
+  // until its row is scrolled into view.  The VETreeWidget will
+  // then only call setWidgetsOnTreeItem for visible rows.
+  virtual bool hasDeferredWidgets() const { return false; }
+
   // This function should be called by the UI when the
   // item name is edited (by the user)
   void renameItem( QString newName );
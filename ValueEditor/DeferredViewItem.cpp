@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+//
+
+#include "DeferredViewItem.h"
+#include "ViewItemFactory.h"
+
+#include <QTreeWidgetItem>
+
+using namespace FabricUI::ValueEditor;
+
+DeferredViewItem::DeferredViewItem(
+  QString const &name,
+  QVariant const &value,
+  ItemMetadata* metadata,
+  bool hasChildren
+  )
+  : BaseViewItem( name, metadata )
+  , m_value( value )
+  , m_itemMetadata( metadata )
+  , m_hasChildren( hasChildren )
+  , m_viewItem( NULL )
+{
+  setBaseModelItem( NULL );
+}
+
+DeferredViewItem::~DeferredViewItem()
+{
+  if (m_viewItem != NULL)
+    m_viewItem->deleteMe();
+}
+
+BaseViewItem* DeferredViewItem::materialize()
+{
+  if (m_viewItem != NULL)
+    return m_viewItem;
+
+  m_viewItem = ViewItemFactory::GetInstance()->createViewItem(
+    getName(),
+    m_value,
+    m_itemMetadata
+    );
+  if (m_viewItem == NULL)
+    return NULL;
+
+  // Our owner only knows about us : forward everything
+  connect(
+    m_viewItem, SIGNAL( interactionBegin() ),
+    this, SIGNAL( interactionBegin() )
+    );
+  connect(
+    m_viewItem, SIGNAL( viewValueChanged( QVariant ) ),
+    this, SIGNAL( viewValueChanged( QVariant ) )
+    );
+  connect(
+    m_viewItem, SIGNAL( interactionEnd( bool ) ),
+    this, SIGNAL( interactionEnd( bool ) )
+    );
+  connect(
+    m_viewItem, SIGNAL( refreshViewport() ),
+    this, SIGNAL( refreshViewport() )
+    );
+  connect(
+    m_viewItem, SIGNAL( rebuildChildren( FabricUI::ValueEditor::BaseViewItem* ) ),
+    this, SLOT( onChildrenRebuild() )
+    );
+  connect(
+    this, SIGNAL( toggleManipulation( bool ) ),
+    m_viewItem, SLOT( emitToggleManipulation( bool ) )
+    );
+
+  // The value is now owned by the real item
+  m_value = QVariant();
+  return m_viewItem;
+}
+
+bool DeferredViewItem::hasDeferredWidgets() const
+{
+  return m_viewItem == NULL;
+}
+
+QWidget *DeferredViewItem::getWidget()
+{
+  BaseViewItem* viewItem = materialize();
+  return viewItem != NULL ? viewItem->getWidget() : NULL;
+}
+
+bool DeferredViewItem::hasChildren() const
+{
+  if (m_viewItem != NULL)
+    return m_viewItem->hasChildren();
+  return m_hasChildren;
+}
+
+void DeferredViewItem::appendChildViewItems( QList<BaseViewItem *>& items )
+{
+  if (BaseViewItem* viewItem = materialize())
+    viewItem->appendChildViewItems( items );
+}
+
+void DeferredViewItem::setWidgetsOnTreeItem(
+  QTreeWidget* treeWidget,
+  QTreeWidgetItem * treeWidgetItem
+  )
+{
+  if (BaseViewItem* viewItem = materialize())
+    viewItem->setWidgetsOnTreeItem( treeWidget, treeWidgetItem );
+  else
+    treeWidgetItem->setText( 0, getName() );
+}
+
+void DeferredViewItem::metadataChanged()
+{
+  if (m_viewItem != NULL)
+    m_viewItem->metadataChanged();
+}
+
+void DeferredViewItem::onModelValueChanged( QVariant const &value )
+{
+  if (m_viewItem != NULL)
+    m_viewItem->onModelValueChanged( value );
+  else
+    m_value = value;
+}
+
+void DeferredViewItem::onChildrenRebuild()
+{
+  emit rebuildChildren( this );
+}
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2010-2017 Fabric Software Inc. All rights reserved.
+//
+
+#ifndef FABRICUI_VALUEEDITOR_DEFERREDVIEWITEM_H
+#define FABRICUI_VALUEEDITOR_DEFERREDVIEWITEM_H
+
+#include "BaseViewItem.h"
+
+namespace FabricUI {
+namespace ValueEditor {
+
+// DeferredViewItem stands in for a ViewItem whose construction
+// is postponed until its row is actually shown.  It only caches
+// the latest value; the real ViewItem (and its widgets) is created
+// through the ViewItemFactory the first time the VETreeWidget needs
+// them (see VETreeWidget::materializeVisibleItems), after which all
+// calls and signals are forwarded to it.
+// This is used to keep large collections (eg, arrays) cheap to expand.
+class DeferredViewItem : public BaseViewItem
+{
+  Q_OBJECT
+
+  QVariant m_value;
+  ItemMetadata* m_itemMetadata;
+  bool m_hasChildren;
+
+  // The materialized item, NULL until needed
+  BaseViewItem* m_viewItem;
+
+public:
+
+  // hasChildren is a hint for the tree until the real item exists
+  DeferredViewItem(
+    QString const &name,
+    QVariant const &value,
+    ItemMetadata* metadata,
+    bool hasChildren
+    );
+
+  virtual void deleteMe() /*override*/
+    { delete this; }
+
+  bool isMaterialized() const
+    { return m_viewItem != NULL; }
+
+  // Creates the real ViewItem if it doesn't exist yet
+  BaseViewItem* materialize();
+
+  virtual bool hasDeferredWidgets() const /*override*/;
+
+  virtual QWidget *getWidget() /*override*/;
+
+  virtual bool hasChildren() const /*override*/;
+
+  virtual void appendChildViewItems( QList<BaseViewItem *>& items ) /*override*/;
+
+  virtual void setWidgetsOnTreeItem(
+    QTreeWidget* treeWidget,
+    QTreeWidgetItem * treeWidgetItem ) /*override*/;
+
+  virtual void metadataChanged() /*override*/;
+
+public slots:
+
+  virtual void onModelValueChanged( QVariant const &value ) /*override*/;
+
+private slots:
+
+  void onChildrenRebuild();
+
+protected:
+
+  ~DeferredViewItem();
+};
+
+} // namespace FabricUI
+} // namespace ValueEditor
+
+#endif // FABRICUI_VALUEEDITOR_DEFERREDVIEWITEM_H
@@ -17,6 +17,8 @@
 #include <QAction>
 #include <QHeaderView>
 #include <QMenu>
+#include <QScrollBar>
+#include <QTimer>
 
 using namespace FabricUI::ValueEditor;
 
@@ -34,6 +36,7 @@ const QString s_outNodeName = " - Out - ";
 VETreeWidget::VETreeWidget( )
  : m_manipulationToggled(false)
  , m_currentOveredItem(0)
+ , m_materializePending(false)
 {
   setColumnCount( 2 );
   setContextMenuPolicy( Qt::CustomContextMenu );
@@ -55,6 +58,10 @@ VETreeWidget::VETreeWidget( )
     this, SIGNAL( itemChanged( QTreeWidgetItem*, int ) ),
     this, SLOT( onItemEdited( QTreeWidgetItem*, int ) )
     );
+  connect(
+    verticalScrollBar(), SIGNAL( valueChanged( int ) ),
+    this, SLOT( scheduleMaterializeVisibleItems() )
+    );
 
   setObjectName( "ValueEditor" );
   header()->close();
@@ -64,6 +71,8 @@ VETreeWidget::VETreeWidget( )
 
 VETreeWidget::~VETreeWidget()
 {
+  // The items unregister themselves from the index when deleted
+  clear();
 }
 
 void VETreeWidget::reloadStyles()
@@ -123,6 +132,11 @@ void gatherTabWidgets(
 
 static void ReorderTabs( VETreeWidgetItem *item, QWidget *&last )
 {
+  // Deferred items have no widgets yet, they will be
+  // added to the chain once they are materialized
+  if ( !item->hasWidgets() )
+    return;
+
   if ( BaseViewItem *viewItem = item->getViewItem() )
   {
     QWidget *self = viewItem->getWidget();
@@ -142,23 +156,7 @@ void VETreeWidget::sortTree()
   // Ensure ordering is maintained.
   sortItems( 0, Qt::AscendingOrder );
 
-  // Reorder tabs
-  VETreeWidgetItem *item =
-    static_cast<VETreeWidgetItem*>( topLevelItem( 0 ) );
-  if ( BaseViewItem *viewItem = item->getViewItem() )
-  {
-    QWidget *last = viewItem->getWidget();
-
-    // Connect this treeview to the first widget.  This ensures
-    // if the treeview is tabbed-to, it will tab to the correct sub-widget
-    setTabOrder( this, last );
-
-    for ( int i = 0; i < item->childCount(); ++i )
-      ReorderTabs(
-        static_cast<VETreeWidgetItem*>( item->child( i ) ),
-        last
-        );
-  }
+  reorderTabs();
 
   // // Once the items have been re-ordered, re-create the tab ordering
   // QWidget *myWindow = window();
@@ -183,6 +181,29 @@ void VETreeWidget::sortTree()
   // }
 }
 
+void VETreeWidget::reorderTabs()
+{
+  VETreeWidgetItem *item =
+    static_cast<VETreeWidgetItem*>( topLevelItem( 0 ) );
+  if ( item == NULL || !item->hasWidgets() )
+    return;
+
+  if ( BaseViewItem *viewItem = item->getViewItem() )
+  {
+    QWidget *last = viewItem->getWidget();
+
+    // Connect this treeview to the first widget.  This ensures
+    // if the treeview is tabbed-to, it will tab to the correct sub-widget
+    setTabOrder( this, last );
+
+    for ( int i = 0; i < item->childCount(); ++i )
+      ReorderTabs(
+        static_cast<VETreeWidgetItem*>( item->child( i ) ),
+        last
+        );
+  }
+}
+
 // Get the next widget in the focus chain that accepts tab focus
 QWidget* getNextTabWidget( QWidget* qw )
 {
@@ -281,7 +302,7 @@ VETreeWidgetItem* VETreeWidget::createTreeWidgetItem( BaseViewItem* viewItem, QT
   // Disable signals to prevent unnecessary 'OnEdit' signals comming back to us
   FabricUI::Util::QTSignalBlocker blocker( this );
 
-  VETreeWidgetItem *treeWidgetItem = new VETreeWidgetItem( viewItem );
+  VETreeWidgetItem *treeWidgetItem = new VETreeWidgetItem( viewItem, this );
   if (viewItem->hasChildren())
     treeWidgetItem->setChildIndicatorPolicy( QTreeWidgetItem::ShowIndicator );
   else
@@ -328,8 +349,18 @@ VETreeWidgetItem* VETreeWidget::createTreeWidgetItem( BaseViewItem* viewItem, QT
     addTopLevelItem( treeWidgetItem );
   }
 
-  // Add the actual widgets to the item
-  viewItem->setWidgetsOnTreeItem( this, treeWidgetItem );
+  // Add the actual widgets to the item, unless the item
+  // waits until its row is visible to build them
+  if ( viewItem->hasDeferredWidgets() )
+  {
+    treeWidgetItem->setText( 0, viewItem->getName() );
+    scheduleMaterializeVisibleItems();
+  }
+  else
+  {
+    viewItem->setWidgetsOnTreeItem( this, treeWidgetItem );
+    treeWidgetItem->setHasWidgets( true );
+  }
 
   // Connect a signal allowing the item to rebuild its children
   connect( viewItem, SIGNAL( rebuildChildren( FabricUI::ValueEditor::BaseViewItem* ) ),
@@ -383,22 +414,9 @@ VETreeWidgetItem * VETreeWidget::findTreeWidget( QWidget* widget, VETreeWidgetIt
 
 VETreeWidgetItem * VETreeWidget::findTreeWidget( BaseModelItem * pItem ) const
 {
-  for (int i = 0; i < topLevelItemCount(); i++)
-  {
-    VETreeWidgetItem* widgetItem = 
-      static_cast<VETreeWidgetItem*>(topLevelItem( i ));
-
-    if (widgetItem != NULL)
-    {
-      VETreeWidgetItem* pMatch = findTreeWidget( pItem, widgetItem );
-      if (pMatch != NULL)
-        return pMatch;
-    }
-  }
-  return NULL;
+  return m_treeWidgetItemsByModelItem.value( pItem, NULL );
 }
 
-
 VETreeWidgetItem * VETreeWidget::findTreeWidget( BaseModelItem * pItem, VETreeWidgetItem * pWidget ) const
 {
   if (pWidget == NULL)
@@ -420,21 +438,28 @@ VETreeWidgetItem * VETreeWidget::findTreeWidget( BaseModelItem * pItem, VETreeWi
   return NULL;
 }
 
-VETreeWidgetItem * VETreeWidget::findTreeWidget( BaseViewItem * pItem ) const
+bool VETreeWidget::isModelItemVisible( BaseModelItem* pItem ) const
 {
-  for (int i = 0; i < topLevelItemCount(); i++)
-  {
-    VETreeWidgetItem* widgetItem =
-      static_cast<VETreeWidgetItem*>(topLevelItem( i ));
+  if ( !isVisible() )
+    return false;
 
-    if (widgetItem != NULL)
-    {
-      VETreeWidgetItem* pMatch = findTreeWidget( pItem, widgetItem );
-      if (pMatch != NULL)
-        return pMatch;
-    }
+  VETreeWidgetItem* treeWidgetItem = findTreeWidget( pItem );
+  if ( treeWidgetItem == NULL || treeWidgetItem->isHidden() )
+    return false;
+
+  for ( QTreeWidgetItem *parent = treeWidgetItem->parent();
+    parent != NULL; parent = parent->parent() )
+  {
+    if ( !parent->isExpanded() )
+      return false;
   }
-  return NULL;
+
+  return visualItemRect( treeWidgetItem ).intersects( viewport()->rect() );
+}
+
+VETreeWidgetItem * VETreeWidget::findTreeWidget( BaseViewItem * pItem ) const
+{
+  return m_treeWidgetItemsByViewItem.value( pItem, NULL );
 }
 
 VETreeWidgetItem * VETreeWidget::findTreeWidget( BaseViewItem * pItem, VETreeWidgetItem * pWidget ) const
@@ -458,6 +483,38 @@ VETreeWidgetItem * VETreeWidget::findTreeWidget( BaseViewItem * pItem, VETreeWid
   return NULL;
 }
 
+void VETreeWidget::addTreeWidgetItemToIndex( VETreeWidgetItem* item )
+{
+  BaseViewItem* viewItem = item->getViewItem();
+  if (viewItem == NULL)
+    return;
+
+  m_treeWidgetItemsByViewItem.insert( viewItem, item );
+  if (BaseModelItem* modelItem = viewItem->getModelItem())
+    m_treeWidgetItemsByModelItem.insert( modelItem, item );
+}
+
+void VETreeWidget::removeTreeWidgetItemFromIndex( VETreeWidgetItem* item )
+{
+  BaseViewItem* viewItem = item->getViewItem();
+  if (viewItem == NULL)
+    return;
+
+  // A newer item might have replaced this one (see createTreeWidgetItem)
+  QHash<BaseViewItem*, VETreeWidgetItem*>::iterator viewIt =
+    m_treeWidgetItemsByViewItem.find( viewItem );
+  if (viewIt != m_treeWidgetItemsByViewItem.end() && viewIt.value() == item)
+    m_treeWidgetItemsByViewItem.erase( viewIt );
+
+  if (BaseModelItem* modelItem = viewItem->getModelItem())
+  {
+    QHash<BaseModelItem*, VETreeWidgetItem*>::iterator modelIt =
+      m_treeWidgetItemsByModelItem.find( modelItem );
+    if (modelIt != m_treeWidgetItemsByModelItem.end() && modelIt.value() == item)
+      m_treeWidgetItemsByModelItem.erase( modelIt );
+  }
+}
+
 void VETreeWidget::setViewItemConnections(BaseViewItem* item) {
   connect(
     item,
@@ -628,6 +685,8 @@ void VETreeWidget::onTreeWidgetItemExpanded( QTreeWidgetItem *_treeWidgetItem )
       setViewItemConnections(childViewItem);
 
       createTreeWidgetItem( childViewItem, treeWidgetItem );
+      if ( childViewItem->hasDeferredWidgets() )
+        continue;
       setTabOrder( lastViewItem->getWidget(), childViewItem->getWidget() );
       lastViewItem = childViewItem;
     }
@@ -635,6 +694,8 @@ void VETreeWidget::onTreeWidgetItemExpanded( QTreeWidgetItem *_treeWidgetItem )
   }
   else
     this->resizeColumnToContents( 0 );
+
+  scheduleMaterializeVisibleItems();
 }
 
 void VETreeWidget::onTreeWidgetItemCollapsed( QTreeWidgetItem *_treeWidgetItem )
@@ -654,6 +715,62 @@ void VETreeWidget::onTreeWidgetItemCollapsed( QTreeWidgetItem *_treeWidgetItem )
     }
   }
   this->resizeColumnToContents( 0 );
+
+  // Rows below may have scrolled into view
+  scheduleMaterializeVisibleItems();
+}
+
+void VETreeWidget::resizeEvent( QResizeEvent *event )
+{
+  QTreeWidget::resizeEvent( event );
+  scheduleMaterializeVisibleItems();
+}
+
+void VETreeWidget::showEvent( QShowEvent *event )
+{
+  QTreeWidget::showEvent( event );
+  scheduleMaterializeVisibleItems();
+}
+
+void VETreeWidget::scheduleMaterializeVisibleItems()
+{
+  // Wait for the pending layout (and other insertions) to be done
+  if ( m_materializePending )
+    return;
+  m_materializePending = true;
+  QTimer::singleShot( 0, this, SLOT( materializeVisibleItems() ) );
+}
+
+void VETreeWidget::materializeVisibleItems()
+{
+  m_materializePending = false;
+
+  bool materialized = false;
+  int viewportHeight = viewport()->height();
+  for ( QTreeWidgetItem *item = itemAt( 0, 0 );
+    item != NULL; item = itemBelow( item ) )
+  {
+    if ( visualItemRect( item ).top() >= viewportHeight )
+      break;
+
+    VETreeWidgetItem *treeWidgetItem = static_cast<VETreeWidgetItem *>( item );
+    BaseViewItem *viewItem = treeWidgetItem->getViewItem();
+    if ( viewItem == NULL || treeWidgetItem->hasWidgets() )
+      continue;
+
+    FabricUI::Util::QTSignalBlocker blocker( this );
+    viewItem->setWidgetsOnTreeItem( this, treeWidgetItem );
+    treeWidgetItem->setHasWidgets( true );
+    materialized = true;
+  }
+
+  if ( materialized )
+  {
+    reorderTabs();
+    resizeColumnToContents( 0 );
+  }
+
+  emit visibleItemsChanged();
 }
 
 void VETreeWidget::prepareMenu( const QPoint& pt )
@@ -6,6 +6,7 @@
 #define FABRICUI_VALUEEDITOR_VETREEWIDGET_H
 
 #include <QTreeWidget>
+#include <QHash>
 #include <QKeyEvent>
 
 namespace FabricUI {
@@ -19,6 +20,8 @@ class VETreeWidget : public QTreeWidget
 {
   Q_OBJECT
 
+  friend class VETreeWidgetItem;
+
 public:
 
   VETreeWidget();
@@ -27,6 +30,8 @@ public:
   void reloadStyles();
 
   void sortTree();
+  // Rebuild the tab order following the tree order
+  void reorderTabs();
   bool focusNextPrevChild( bool next );
 
   VETreeWidgetItem* createTreeWidgetItem( BaseViewItem* viewItem, QTreeWidgetItem* parent, int index = -1 );
@@ -39,6 +44,10 @@ public:
   VETreeWidgetItem * findTreeWidget( BaseViewItem * pItem ) const;
   VETreeWidgetItem * findTreeWidget( BaseViewItem * pItem, VETreeWidgetItem * pWidget ) const;
 
+  // Whether the row of the model item is currently shown: false if
+  // it is scrolled out of the viewport, or under a collapsed item
+  bool isModelItemVisible( BaseModelItem* pItem ) const;
+
 public slots:
 
   void onSetModelItem( FabricUI::ValueEditor::BaseModelItem* pItem );
@@ -72,6 +81,11 @@ protected slots:
   
   void emitRefreshViewport();
 
+  // Set the widgets of the visible items whose ViewItem
+  // has deferred them (see BaseViewItem::hasDeferredWidgets)
+  void scheduleMaterializeVisibleItems();
+  void materializeVisibleItems();
+
 signals:
   // Refreshes the viewport, if a klWidget
   // has been activated-deactivated.
@@ -79,6 +93,10 @@ signals:
 
   void toggleManipulation(bool);
 
+  // Emitted once the rows shown may have changed, after scrolling,
+  // expanding or collapsing items, or resizing
+  void visibleItemsChanged();
+
   /// Emmitted when the item overed changed.
   /// Enabled is QWidget::hasMouseTracking if true (QWidget::setMouseTracking)
   void itemOveredChanged(
@@ -88,10 +106,25 @@ signals:
 
 protected:
   void setViewItemConnections(BaseViewItem* item);
+
+  virtual void resizeEvent( QResizeEvent *event ) /*override*/;
+  virtual void showEvent( QShowEvent *event ) /*override*/;
   
   bool m_manipulationToggled;
 
   QTreeWidgetItem *m_currentOveredItem;
+
+  bool m_materializePending;
+
+private:
+
+  // Called by the VETreeWidgetItems created by createTreeWidgetItem
+  void addTreeWidgetItemToIndex( VETreeWidgetItem* item );
+  void removeTreeWidgetItemFromIndex( VETreeWidgetItem* item );
+
+  // Lets findTreeWidget avoid walking the whole tree
+  QHash<BaseModelItem*, VETreeWidgetItem*> m_treeWidgetItemsByModelItem;
+  QHash<BaseViewItem*, VETreeWidgetItem*> m_treeWidgetItemsByViewItem;
 };
 
 } // namespace FabricUI 
@@ -3,6 +3,7 @@
 //
 
 #include "VETreeWidgetItem.h"
+#include "VETreeWidget.h"
 #include "BaseViewItem.h"
 #include "BaseModelItem.h"
 
@@ -10,12 +11,23 @@
 
 using namespace FabricUI::ValueEditor;
 
-VETreeWidgetItem::VETreeWidgetItem( BaseViewItem *viewItem ) : m_viewItem( viewItem )
+VETreeWidgetItem::VETreeWidgetItem(
+  BaseViewItem *viewItem,
+  VETreeWidget *treeWidget
+  )
+  : m_viewItem( viewItem )
+  , m_treeWidget( treeWidget )
+  , m_hasWidgets( false )
 {
+  if (m_treeWidget != NULL)
+    m_treeWidget->addTreeWidgetItemToIndex( this );
 }
 
 VETreeWidgetItem::~VETreeWidgetItem()
 {
+  if (m_treeWidget != NULL)
+    m_treeWidget->removeTreeWidgetItemFromIndex( this );
+
   // We own this pointer, we need to release it.
   if (m_viewItem != NULL)
     m_viewItem->deleteMe();
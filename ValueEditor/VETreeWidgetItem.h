@@ -11,18 +11,31 @@ namespace FabricUI {
 namespace ValueEditor {
 	
 class BaseViewItem;
+class VETreeWidget;
 
 class VETreeWidgetItem : public QTreeWidgetItem
 {
 public:
 
-  VETreeWidgetItem( BaseViewItem *viewItem );
+  // treeWidget, if any, indexes this item by its
+  // ViewItem and ModelItem until it is deleted
+  VETreeWidgetItem(
+    BaseViewItem *viewItem,
+    VETreeWidget *treeWidget = NULL
+    );
   ~VETreeWidgetItem();
 
   void maybeExpand();
 
   BaseViewItem *getViewItem() const;
 
+  // False while the widgets of a deferred ViewItem
+  // haven't been set on this item yet
+  bool hasWidgets() const
+    { return m_hasWidgets; }
+  void setHasWidgets( bool hasWidgets )
+    { m_hasWidgets = hasWidgets; }
+
   // Override the sort to enable changing
   // order without losing all the widget info
   bool operator<( const QTreeWidgetItem &other )const;
@@ -30,6 +43,9 @@ public:
 private:
 
   BaseViewItem *m_viewItem;
+  // Kept as Qt resets treeWidget() before deleting the children
+  VETreeWidget *m_treeWidget;
+  bool m_hasWidgets;
 };
 
 } // namespace FabricUI 
@@ -14,6 +14,10 @@ using namespace FabricUI;
 using namespace Dialog;
 using namespace TimeLine;
 
+// If the viewport doesn't report the redraw of a frame
+// (eg. it is hidden), don't wait longer than this (ms)
+static const int DrawFeedbackTimeout = 100;
+
 FrameSlider::FrameSlider( 
   QWidget * parent)
   : QSlider(parent)
@@ -112,10 +116,27 @@ TimeLineWidget::TimeLineWidget()
   // default playback sim
   m_simMode = 0;
 
-  //QTimer is not precise at all; just make it call often as 
-  //possible (1 ms) and we will compute the actual elapsed time
+  // default playback policy
+  m_playbackPolicy = PLAYBACK_POLICY_DEFAULT;
+
+  m_isPlaying = false;
+  m_nextFrameDeadline = 0.0;
+  m_hasDrawFeedback = false;
+  m_waitingForDraw = false;
+  m_evaluatingFrame = false;
+  m_frameEvalEnd = 0.0;
+  m_lastFrameEvalTime = 0.0;
+  m_lastFrameDrawTime = 0.0;
+  m_droppedFrameCount = 0;
+
+  // The timer is started for each frame, until its deadline
+  // (see scheduleNextFrame): QTimer is not precise, timerUpdate
+  // checks the actual elapsed time and reschedules if woken early
   m_timer = new QTimer(this);
-  m_timer->setInterval(1);
+  m_timer->setSingleShot(true);
+#if QT_VERSION >= 0x050000
+  m_timer->setTimerType(Qt::PreciseTimer);
+#endif
 
   // layout
   setLayout(new QHBoxLayout());
@@ -442,7 +463,6 @@ void TimeLineWidget::setTimerFromFps(
   {
     // use "max fps".
     m_fps = 1000.0;
-    m_timer->setInterval(1);
     m_frameRateComboBox->setCurrentIndex(0);
   }
   else
@@ -479,7 +499,33 @@ float TimeLineWidget::framerate() const
 
 bool TimeLineWidget::isPlaying() const 
 { 
-  return m_timer->isActive(); 
+  return m_isPlaying; 
+}
+
+int TimeLineWidget::playbackPolicy() const
+{
+  return m_playbackPolicy;
+}
+
+void TimeLineWidget::setPlaybackPolicy(
+  int policy)
+{
+  m_playbackPolicy = policy;
+}
+
+double TimeLineWidget::lastFrameEvalTime() const
+{
+  return m_lastFrameEvalTime;
+}
+
+double TimeLineWidget::lastFrameDrawTime() const
+{
+  return m_lastFrameDrawTime;
+}
+
+int TimeLineWidget::droppedFrameCount() const
+{
+  return m_droppedFrameCount;
 }
 
 void TimeLineWidget::updateFrameRange()
@@ -499,20 +545,25 @@ void TimeLineWidget::updateFrameRange()
 void TimeLineWidget::onPlayButtonToggled( 
   bool checked)
 {
-  if ( !checked && m_timer->isActive() )
+  if ( !checked && m_isPlaying )
   {
     m_playButton->setText( QString::fromUtf8( "\xEF\x81\x8B" ) ); /* FontAwesome > */
+    m_isPlaying = false;
+    m_waitingForDraw = false;
     m_timer->stop();
     m_playButton->setChecked( false );
     emit playbackChanged(false);
   }
-  else if ( checked && !m_timer->isActive() )
+  else if ( checked && !m_isPlaying )
   {
     m_playButton->setText( QString::fromUtf8( "\xEF\x81\x8C" ) ); /* FontAwesome || */
     if (m_loopMode == LOOP_MODE_PLAY_ONCE && getTime() >=  m_endSpinBox->value())
       goToStartFrame();
-    m_timer->start();
-    m_lastFrameTime.start();
+    m_isPlaying = true;
+    m_droppedFrameCount = 0;
+    m_playbackClock.start();
+    m_nextFrameDeadline = framePeriod();
+    scheduleNextFrame();
     emit playbackChanged(true);
   }
 }
@@ -560,18 +611,125 @@ void TimeLineWidget::goToEndFrame()
   setTime(newFrame);
 }
 
+double TimeLineWidget::playbackClock() const
+{
+  return double( m_playbackClock.nsecsElapsed() ) / 1000000.0;
+}
+
+double TimeLineWidget::framePeriod() const
+{
+  return m_fps > 0 ? 1000.0 / m_fps : 0.0;
+}
+
+void TimeLineWidget::scheduleNextFrame()
+{
+  if (!m_isPlaying || m_waitingForDraw)
+    return;
+
+  double remaining = m_nextFrameDeadline - playbackClock();
+  m_timer->start( remaining > 0 ? int( floor( remaining ) ) : 0 );
+}
+
 void TimeLineWidget::timerUpdate()
 {
-  // We will be getting about 1 call per milli-second,
-  // however QTimer is really not precise so we cannot rely
-  // on its delay.
-  double ms = m_lastFrameTime.elapsed();
-  if( m_fps > 0 && ms + 0.5 < 1000.0 / m_fps ) // Add 0.5 so we have a better average framerate (else we are always above)
-    return; // Wait longer
+  if (!m_isPlaying)
+    return;
+
+  if (m_waitingForDraw)
+  {
+    // The redraw was not reported in time, don't stall the playback.
+    // Stop waiting for the next ones until the viewport reports again.
+    m_waitingForDraw = false;
+    m_hasDrawFeedback = false;
+    m_lastFrameDrawTime = playbackClock() - m_frameEvalEnd;
+    finishFrame();
+    return;
+  }
+
+  // QTimer is really not precise so we cannot rely on its delay.
+  double now = playbackClock();
+  if (now + 0.5 < m_nextFrameDeadline) // Add 0.5 so we have a better average framerate (else we are always above)
+  {
+    scheduleNextFrame(); // Wait longer
+    return;
+  }
+
+  // In realtime, skip the frames whose deadline has already passed.
+  // In simulation mode all the frames have to be evaluated anyway.
+  int frameCount = 1;
+  double period = framePeriod();
+  if (m_playbackPolicy == PLAYBACK_POLICY_REALTIME && m_simMode == 0 && period > 0)
+  {
+    int lateFrames = int( floor( ( now - m_nextFrameDeadline ) / period ) );
+    if (lateFrames > 0)
+    {
+      frameCount += lateFrames;
+      m_droppedFrameCount += lateFrames;
+    }
+  }
+
+  // Don't accumulate a backlog of frames when the
+  // evaluation is slower than the frame rate
+  m_nextFrameDeadline += frameCount * period;
+  if (m_nextFrameDeadline < now)
+    m_nextFrameDeadline = now;
+
+  // If the viewport reports its redraws, wait for the one of this frame.
+  // It can also be drawn synchronously, during the evaluation.
+  m_waitingForDraw = m_hasDrawFeedback;
+  m_evaluatingFrame = true;
+  stepPlayback(frameCount);
+  m_evaluatingFrame = false;
+
+  m_frameEvalEnd = playbackClock();
+  m_lastFrameEvalTime = m_frameEvalEnd - now;
+
+  if (!m_isPlaying)
+    return;
+
+  if (m_waitingForDraw)
+    m_timer->start(DrawFeedbackTimeout);
+  else
+  {
+    if (!m_hasDrawFeedback)
+      m_lastFrameDrawTime = 0.0;
+    finishFrame();
+  }
+}
+
+void TimeLineWidget::onFrameDrawn()
+{
+  m_hasDrawFeedback = true;
+  if (!m_waitingForDraw)
+    return;
+  m_waitingForDraw = false;
+
+  // Drawn during the evaluation : included in its time
+  if (m_evaluatingFrame)
+  {
+    m_lastFrameDrawTime = 0.0;
+    return;
+  }
+
+  m_timer->stop();
+  m_lastFrameDrawTime = playbackClock() - m_frameEvalEnd;
+  finishFrame();
+}
 
-  m_lastFrameTime.start();
+void TimeLineWidget::finishFrame()
+{
+  emit playbackStatsUpdated(
+    m_lastFrameEvalTime, 
+    m_lastFrameDrawTime, 
+    m_droppedFrameCount
+    );
+  scheduleNextFrame();
+}
 
-  int newTime = getTime()+m_direction;
+void TimeLineWidget::stepPlayback(
+  int frameCount)
+{
+  int newTime = getTime()+m_direction*frameCount;
 
   // case 1: new time is inside the time range.
   if (newTime >= m_startSpinBox->value() && newTime <= m_endSpinBox->value())
@@ -589,11 +747,20 @@ void TimeLineWidget::timerUpdate()
       {
         case LOOP_MODE_PLAY_ONCE:
         {
+          // the skipped frames end on the last one
+          if (getTime() != int(m_endSpinBox->value()))
+            goToEndFrame();
           pause();
         } break;
         case LOOP_MODE_LOOP:
         {
-          goToStartFrame();
+          // wrap the skipped frames around the range
+          int start = int(m_startSpinBox->value());
+          int length = int(m_endSpinBox->value()) - start + 1;
+          if (length > 0)
+            setTime(start + (newTime - start) % length);
+          else
+            goToStartFrame();
         } break;
         case LOOP_MODE_OSCILLATE:
         {
@@ -5,7 +5,7 @@
 #ifndef __UI_TIME_LINE_WIDGET__
 #define __UI_TIME_LINE_WIDGET__
 
-#include <QTime>
+#include <QElapsedTimer>
 #include <QList>
 #include <QTimer>
 #include <QWidget>
@@ -61,6 +61,14 @@ class TimeLineWidget : public QWidget
     #define LOOP_MODE_OSCILLATE 2
     #define LOOP_MODE_DEFAULT   LOOP_MODE_LOOP
 
+    // playback policy constants.
+    // every frame: never skip a frame, playback slows down if needed.
+    // realtime: skip frames to stay in sync with the frame rate
+    // (not in simulation mode, where all the frames are evaluated).
+    #define PLAYBACK_POLICY_EVERY_FRAME 0
+    #define PLAYBACK_POLICY_REALTIME    1
+    #define PLAYBACK_POLICY_DEFAULT     PLAYBACK_POLICY_EVERY_FRAME
+
     /// update the internal time and also emit the signals
     void updateTime(
       int frame, 
@@ -124,6 +132,25 @@ class TimeLineWidget : public QWidget
     /// Gets the framerate. 1000 = max.
     bool isPlaying() const;
 
+    /// Gets the playback policy
+    int playbackPolicy() const;
+
+    /// Sets the playback policy (PLAYBACK_POLICY_*)
+    void setPlaybackPolicy(
+      int policy
+      );
+
+    /// Time (ms) spent evaluating the last played frame,
+    /// ie. in the slots connected to frameChanged
+    double lastFrameEvalTime() const;
+
+    /// Time (ms) between the end of the evaluation of the
+    /// last played frame and its redraw (see onFrameDrawn)
+    double lastFrameDrawTime() const;
+
+    /// Number of frames skipped since the playback started
+    int droppedFrameCount() const;
+
   signals :
     /// Emited when ever the time on the widget changed
     /// Connect this slight to any slots that need to know about the time
@@ -145,6 +172,14 @@ class TimeLineWidget : public QWidget
     void targetFrameRateChanged( 
       float frameRate 
       );
+
+    /// Emitted after each played frame (see lastFrameEvalTime,
+    /// lastFrameDrawTime and droppedFrameCount)
+    void playbackStatsUpdated(
+      double evalTime,
+      double drawTime,
+      int droppedFrames
+      );
   
   public slots:
     /// Slider value changed
@@ -192,6 +227,11 @@ class TimeLineWidget : public QWidget
     /// Called each time the timer is triggered ( basicly when playing)
     void timerUpdate();
 
+    /// To be called once the viewport has been redrawn.
+    /// Once called, the playback waits for the redraw of 
+    /// a frame before playing the next one.
+    void onFrameDrawn();
+
     /// Called to reload the QSS styles
     void reloadStyles();
 
@@ -218,11 +258,44 @@ class TimeLineWidget : public QWidget
       );
     
   private:
-    /// the timer in charge of the playback. 
-    /// this is paused when not active
+    /// Milliseconds since the playback started
+    double playbackClock() const;
+
+    /// Duration of a frame in milliseconds
+    double framePeriod() const;
+
+    /// Starts the timer for the next frame deadline
+    void scheduleNextFrame();
+
+    /// Moves the time by frameCount frames, looping if needed
+    void stepPlayback(
+      int frameCount
+      );
+
+    /// Called once the evaluation and redraw of the frame are done
+    void finishFrame();
+
+    /// the single-shot timer in charge of the playback. 
+    /// it is started for each frame deadline
     double m_fps;
     QTimer *m_timer;
-    QTime m_lastFrameTime;
+    QElapsedTimer m_playbackClock;
+    bool m_isPlaying;
+    int m_playbackPolicy;
+    /// deadline of the next frame, in playbackClock() time
+    double m_nextFrameDeadline;
+
+    /// backpressure : the next frame is not played
+    /// until the previous one has been drawn
+    bool m_hasDrawFeedback;
+    bool m_waitingForDraw;
+    bool m_evaluatingFrame;
+    double m_frameEvalEnd;
+
+    /// stats
+    double m_lastFrameEvalTime;
+    double m_lastFrameDrawTime;
+    int m_droppedFrameCount;
     
     int m_simMode;
     int m_loopMode;